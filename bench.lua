@@ -0,0 +1,94 @@
+project "bench"
+    location "bench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    staticruntime "on"
+
+    targetdir(tdir)
+    objdir(odir)
+
+    files {
+        "%{prj.name}/include/**.hpp" ,
+        "%{prj.name}/src/**.cpp"
+    }
+
+    includedirs {
+        "%{prj.name}/include" ,
+        "engine/include"
+    }
+
+    externalincludedirs {
+        "%{externals.sdl2}/include" ,
+        "%{externals.glad}/include" ,
+        "%{externals.glm}" ,
+        "%{externals.spdlog}/include" ,
+        "%{externals.entt}" ,
+        "%{externals.stb}" ,
+        "%{externals.mono}/include" ,
+        "%{externals.imgui}" ,
+        "%{externals.imguizmo}" ,
+        "%{externals.assimp}/include" ,
+        "%{externals.react}/include" ,
+        "%{externals.magic_enum}" ,
+        "%{externals.zep}/include" ,
+        "%{externals.nfd}/src"
+    }
+
+    libdirs {
+        "%{externals.sdl2}/lib/x64" ,
+        "%{externals.mono}/lib/%{cfg.buildcfg}" ,
+        "%{externals.assimp}/lib/%{cfg.buildcfg}"
+    }
+
+    links {
+        "engine" ,
+        "SDL2" ,
+        "glad" ,
+        "spdlog" ,
+        "imgui" ,
+        "imguizmo" ,
+        "mono-2.0-sgen" ,
+        "reactphysics3d" ,
+        "zep" ,
+        "nfd"
+    }
+
+    filter { "system:windows" , "configurations:*" }
+        systemversion "latest"
+        entrypoint "WinMainCRTStartup"
+        defines {
+            "YE_PLATFORM_WIN"
+        }
+        links {
+            "shlwapi.lib" ,
+            "ole32.lib" ,
+            "shell32.lib" ,
+            "propsys.lib" ,
+        }
+
+    filter { "system:linux" , "configurations:*" }
+        defines {
+            "YE_PLATFORM_LINUX"
+        }
+
+    filter "configurations:Debug"
+        runtime "Debug"
+        symbols "on"
+        defines {
+            "YE_DEBUG_BUILD"
+        }
+        links {
+            "assimp-vc143-mtd"
+        }
+
+    filter "configurations:Release"
+        runtime "Release"
+        symbols "off"
+        optimize "on"
+        defines {
+            "YE_RELEASE_BUILD"
+        }
+        links {
+            "assimp-vc143-mt"
+        }
@@ -0,0 +1,68 @@
+#ifndef YE_BENCH_HPP
+#define YE_BENCH_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+
+namespace YE {
+
+namespace bench {
+
+    using BenchFunction = int(*)(const std::vector<std::string>& args);
+
+    /// \note one benchmark or check , selected by name on the command line. a nonzero result fails the run
+    struct BenchCase {
+        const char* name = "";
+        const char* description = "";
+        BenchFunction run = nullptr;
+    };
+
+    /// \note returns true so it can initialize a static , every case registers itself that way
+    bool Register(const BenchCase& bench);
+    const std::vector<BenchCase>& Cases();
+
+    /// \note hidden window with a current GL context and loaded function pointers , for cases that
+    ///     create shaders or upload meshes without running the whole engine
+    bool OpenContext();
+    void CloseContext();
+
+    using Clock = std::chrono::steady_clock;
+
+    /// \note runs fn iterations times and returns the average time of one run in microseconds
+    template<typename Fn>
+    double Measure(uint32_t iterations , Fn&& fn) {
+        Clock::time_point start = Clock::now();
+        for (uint32_t i = 0; i < iterations; ++i)
+            fn();
+        std::chrono::duration<double , std::micro> elapsed = Clock::now() - start;
+        return elapsed.count() / std::max(iterations , 1u);
+    }
+
+    inline uint32_t ArgValue(const std::vector<std::string>& args , size_t index , uint32_t fallback) {
+        return index < args.size() ? static_cast<uint32_t>(std::stoul(args[index])) : fallback;
+    }
+
+}
+
+}
+
+#define YE_BENCH_CONCAT_IMPL(a , b) a##b
+#define YE_BENCH_CONCAT(a , b) YE_BENCH_CONCAT_IMPL(a , b)
+
+#define YE_BENCH(name , description , fn) \
+    static const bool YE_BENCH_CONCAT(registered_bench_ , __LINE__) = YE::bench::Register({ name , description , fn });
+
+// results go to stdout instead of the log , logging is compiled out of release builds where the numbers
+// matter. failures are counted instead of aborting so one run reports every broken check
+#define YE_BENCH_CHECK(failures , condition , ...) \
+    if (!(condition)) {                            \
+        std::printf("    FAILED :: " __VA_ARGS__); \
+        std::printf("\n");                         \
+        ++failures;                                \
+    }
+
+#endif // !YE_BENCH_HPP
@@ -0,0 +1,115 @@
+#include "bench.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include <SDL.h>
+#include <glad/glad.h>
+
+#include "log.hpp"
+#include "core/task_manager.hpp"
+
+namespace YE {
+
+namespace bench {
+
+    static std::vector<BenchCase>& Registry() {
+        static std::vector<BenchCase> cases;
+        return cases;
+    }
+
+    static SDL_Window* context_window = nullptr;
+    static SDL_GLContext context = nullptr;
+
+    bool Register(const BenchCase& bench) {
+        Registry().push_back(bench);
+        return true;
+    }
+
+    const std::vector<BenchCase>& Cases() {
+        return Registry();
+    }
+
+    bool OpenContext() {
+        if (context != nullptr)
+            return true;
+
+        if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+            std::printf("Failed to open GL context :: %s\n" , SDL_GetError());
+            return false;
+        }
+
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK , SDL_GL_CONTEXT_PROFILE_CORE);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION , 4);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION , 6);
+
+        context_window = SDL_CreateWindow("bench" , 0 , 0 , 64 , 64 , SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+        if (context_window == nullptr) {
+            std::printf("Failed to open GL context :: %s\n" , SDL_GetError());
+            return false;
+        }
+
+        context = SDL_GL_CreateContext(context_window);
+        if (context == nullptr || gladLoadGLLoader(SDL_GL_GetProcAddress) == 0) {
+            std::printf("Failed to open GL context :: %s\n" , SDL_GetError());
+            CloseContext();
+            return false;
+        }
+
+        return true;
+    }
+
+    void CloseContext() {
+        if (context != nullptr) SDL_GL_DeleteContext(context);
+        if (context_window != nullptr) SDL_DestroyWindow(context_window);
+        context = nullptr;
+        context_window = nullptr;
+        SDL_Quit();
+    }
+
+    static void PrintUsage() {
+        std::printf("usage: bench <case|all> [args...]\n\n");
+        for (const auto& bench : Cases())
+            std::printf("    %-24s %s\n" , bench.name , bench.description);
+    }
+
+}
+
+}
+
+// the engine library owns main and calls this , the same hook DECLARE_APP fills in for applications
+int YE2Entry(int argc , char* argv[]) {
+    YE::Logger::Instance()->OpenLog();
+
+    if (argc < 2) {
+        YE::bench::PrintUsage();
+        YE::Logger::Instance()->CloseLog();
+        return 1;
+    }
+
+    const bool run_all = std::strcmp(argv[1] , "all") == 0;
+    std::vector<std::string> args(argv + 2 , argv + argc);
+
+    int failed = 0;
+    bool found = false;
+    for (const auto& bench : YE::bench::Cases()) {
+        if (!run_all && std::strcmp(bench.name , argv[1]) != 0)
+            continue;
+
+        found = true;
+        std::printf("[%s]\n" , bench.name);
+        int result = bench.run(run_all ? std::vector<std::string>{} : args);
+        std::printf("[%s] %s\n\n" , bench.name , result == 0 ? "passed" : "FAILED");
+        failed += result != 0 ? 1 : 0;
+    }
+
+    if (!found) {
+        std::printf("Unknown case :: %s\n\n" , argv[1]);
+        YE::bench::PrintUsage();
+        failed = 1;
+    }
+
+    YE::TaskManager::Instance()->Cleanup();
+    YE::Logger::Instance()->CloseLog();
+    return failed;
+}
@@ -0,0 +1,219 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/defines.hpp"
+#include "core/mpsc_queue.hpp"
+#include "event/event_manager.hpp"
+
+namespace YE {
+
+namespace bench {
+
+    struct QueueItem {
+        uint32_t producer = 0;
+        uint32_t sequence = 0;
+    };
+
+    static constexpr uint32_t kCheckQueueSize = 1024;
+
+    // every producer numbers its items from zero , so the consumer sees a gap or a repeat as soon as
+    // one is lost , duplicated or overtaken by a later item from the same producer
+    struct OrderCheck {
+        std::vector<uint32_t> next;
+        uint32_t received = 0;
+        uint32_t out_of_order = 0;
+        uint32_t unknown = 0;
+
+        OrderCheck(uint32_t producers) : next(producers , 0) {}
+
+        void Receive(uint32_t producer , uint32_t sequence) {
+            ++received;
+            if (producer >= next.size()) {
+                ++unknown;
+                return;
+            }
+            if (sequence != next[producer])
+                ++out_of_order;
+            next[producer] = sequence + 1;
+        }
+    };
+
+    static glm::ivec2 EventSize(uint32_t producer , uint32_t sequence) {
+        return { static_cast<int32_t>(producer) , static_cast<int32_t>(sequence) };
+    }
+
+    template<typename Fn>
+    static void RunProducers(uint32_t producers , Fn&& fn) {
+        std::vector<std::thread> threads;
+        threads.reserve(producers);
+        for (uint32_t p = 0; p < producers; ++p)
+            threads.emplace_back([&fn , p]() { fn(p); });
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    /// \note many producers against one consumer , straight on MPSCQueue and through EventManager::Post and
+    ///     DispatchQueued. nothing pushed may be lost , items from one producer have to arrive in the order
+    ///     they were pushed and a full queue has to refuse and count exactly the pushes that did not fit
+    ///         args : [producers = 16] [items per producer = 200000]
+    static int EventQueueCheck(const std::vector<std::string>& args) {
+        const uint32_t producers = ArgValue(args , 0 , 16);
+        const uint32_t items = ArgValue(args , 1 , 200000);
+        const uint32_t total = producers * items;
+
+        int failures = 0;
+
+        // producers retry on full while the consumer drains , every item has to come through
+        auto* queue = ynew MPSCQueue<QueueItem , kCheckQueueSize>;
+        OrderCheck queue_order(producers);
+        std::atomic<uint32_t> queue_full{ 0 };
+
+        Clock::time_point start = Clock::now();
+        std::thread consumer([&]() {
+            QueueItem item;
+            while (queue_order.received < total) {
+                if (queue->Pop(item)) {
+                    queue_order.Receive(item.producer , item.sequence);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        RunProducers(producers , [&](uint32_t producer) {
+            for (uint32_t i = 0; i < items; ++i) {
+                while (!queue->Push({ producer , i })) {
+                    queue_full.fetch_add(1 , std::memory_order_relaxed);
+                    std::this_thread::yield();
+                }
+            }
+        });
+        consumer.join();
+        std::chrono::duration<double , std::milli> queue_time = Clock::now() - start;
+
+        QueueItem leftover;
+        YE_BENCH_CHECK(failures , queue_order.received == total , "queue delivered %u of %u items" , queue_order.received , total);
+        YE_BENCH_CHECK(failures , queue_order.out_of_order == 0 , "%u queue items out of producer order" , queue_order.out_of_order);
+        YE_BENCH_CHECK(failures , queue_order.unknown == 0 , "%u queue items from unknown producers" , queue_order.unknown);
+        YE_BENCH_CHECK(failures , !queue->Pop(leftover) , "queue not empty after every item was received");
+
+        ydelete queue;
+
+        // events carry the producer and sequence in the window size so the callback can check them
+        EventManager* event_manager = EventManager::Instance();
+
+        // with nobody dispatching exactly one queue worth of posts fits , the rest are refused and counted
+        const uint32_t attempts = std::max(items , kEventQueueSize / producers + 1);
+        std::atomic<uint32_t> accepted{ 0 };
+        std::atomic<uint32_t> refused{ 0 };
+        RunProducers(producers , [&](uint32_t producer) {
+            for (uint32_t i = 0; i < attempts; ++i) {
+                if (event_manager->Post<WindowResized>(EventSize(producer , i) , glm::ivec2{ 0 , 0 })) {
+                    accepted.fetch_add(1 , std::memory_order_relaxed);
+                } else {
+                    refused.fetch_add(1 , std::memory_order_relaxed);
+                }
+            }
+        });
+
+        const uint32_t dropped = event_manager->NumDropped();
+        YE_BENCH_CHECK(failures , accepted.load() == kEventQueueSize , "full queue accepted %u posts , capacity is %u" ,
+                       accepted.load() , kEventQueueSize);
+        YE_BENCH_CHECK(failures , dropped == refused.load() && dropped == producers * attempts - accepted.load() ,
+                       "%u posts dropped , %u refused of %u" , dropped , refused.load() , producers * attempts);
+
+        // accepted posts are not contiguous per producer here , only their order can be checked
+        std::vector<uint32_t> last(producers , 0);
+        std::vector<bool> seen(producers , false);
+        uint32_t full_received = 0;
+        uint32_t full_out_of_order = 0;
+        event_manager->RegisterWindowResizedCallback([&](WindowResized* event) -> bool {
+            const uint32_t producer = event->Width();
+            ++full_received;
+            if (producer < producers) {
+                if (seen[producer] && event->Height() <= last[producer])
+                    ++full_out_of_order;
+                seen[producer] = true;
+                last[producer] = event->Height();
+            }
+            return true;
+        } , "event_queue_check");
+
+        event_manager->DispatchQueued();
+        YE_BENCH_CHECK(failures , full_received == accepted.load() , "dispatched %u of %u accepted posts" , full_received , accepted.load());
+        YE_BENCH_CHECK(failures , full_out_of_order == 0 , "%u accepted posts out of producer order" , full_out_of_order);
+        YE_BENCH_CHECK(failures , event_manager->NumDropped() == 0 , "drop count not reset by DispatchQueued");
+
+        // producers retry while the main thread dispatches , like worker threads posting during a frame
+        OrderCheck event_order(producers);
+        event_manager->UnregisterCallback("event_queue_check" , EventType::WINDOW_RESIZE);
+        event_manager->RegisterWindowResizedCallback([&event_order](WindowResized* event) -> bool {
+            event_order.Receive(event->Width() , event->Height());
+            return true;
+        } , "event_queue_check");
+
+        std::atomic<uint32_t> posting{ producers };
+        start = Clock::now();
+        std::thread poster([&]() {
+            RunProducers(producers , [&](uint32_t producer) {
+                for (uint32_t i = 0; i < items; ++i) {
+                    while (!event_manager->Post<WindowResized>(EventSize(producer , i) , glm::ivec2{ 0 , 0 }))
+                        std::this_thread::yield();
+                }
+                posting.fetch_sub(1 , std::memory_order_release);
+            });
+        });
+
+        while (posting.load(std::memory_order_acquire) > 0)
+            event_manager->DispatchQueued();
+        poster.join();
+
+        // everything is in the queue now , drain until a dispatch finds nothing new
+        uint32_t drained = 0;
+        do {
+            drained = event_order.received;
+            event_manager->DispatchQueued();
+        } while (event_order.received != drained);
+        std::chrono::duration<double , std::milli> event_time = Clock::now() - start;
+
+        YE_BENCH_CHECK(failures , event_order.received == total , "dispatched %u of %u posted events" , event_order.received , total);
+        YE_BENCH_CHECK(failures , event_order.out_of_order == 0 , "%u events out of producer order" , event_order.out_of_order);
+        YE_BENCH_CHECK(failures , event_order.unknown == 0 , "%u events from unknown producers" , event_order.unknown);
+
+        // an event posted by a callback waits for the next DispatchQueued
+        uint32_t reposts = 0;
+        event_manager->UnregisterCallback("event_queue_check" , EventType::WINDOW_RESIZE);
+        event_manager->RegisterWindowResizedCallback([&reposts , event_manager](WindowResized* event) -> bool {
+            ++reposts;
+            event_manager->Post<WindowResized>(EventSize(0 , event->Height() + 1) , glm::ivec2{ 0 , 0 });
+            return true;
+        } , "event_queue_check");
+
+        event_manager->Post<WindowResized>(EventSize(0 , 0) , glm::ivec2{ 0 , 0 });
+        event_manager->DispatchQueued();
+        YE_BENCH_CHECK(failures , reposts == 1 , "one dispatch ran %u chained posts" , reposts);
+        event_manager->DispatchQueued();
+        YE_BENCH_CHECK(failures , reposts == 2 , "second dispatch left %u chained posts run" , reposts);
+
+        // drop the last repost
+        event_manager->UnregisterCallback("event_queue_check" , EventType::WINDOW_RESIZE);
+        event_manager->DispatchQueued();
+        event_manager->FlushEvents();
+
+        std::printf("    %u producers , %u items each\n" , producers , items);
+        std::printf("    MPSCQueue         : %9.2f ms (%.1f M items/s , %u full retries)\n" , queue_time.count() ,
+                    total / queue_time.count() / 1000.0 , queue_full.load());
+        std::printf("    Post + Dispatch   : %9.2f ms (%.1f M events/s)\n" , event_time.count() ,
+                    total / event_time.count() / 1000.0);
+
+        return failures;
+    }
+
+    YE_BENCH("event_queue" , "many producers through MPSCQueue and EventManager::Post without loss" , EventQueueCheck)
+
+}
+
+}
@@ -0,0 +1,242 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+
+#include "core/app.hpp"
+#include "event/event_manager.hpp"
+#include "scene/scene.hpp"
+#include "scene/entity.hpp"
+#include "scene/components.hpp"
+#include "scene/systems.hpp"
+#include "rendering/vertex.hpp"
+#include "rendering/vertex_array.hpp"
+#include "rendering/shader.hpp"
+#include "rendering/camera.hpp"
+#include "rendering/renderer.hpp"
+
+// every allocation in the process goes through these , they are only counted while a frame is measured
+static std::atomic<uint64_t> counted_allocations{ 0 };
+static std::atomic<bool> counting_allocations{ false };
+
+static void* CountedAlloc(std::size_t size) {
+    if (counting_allocations.load(std::memory_order_relaxed))
+        counted_allocations.fetch_add(1 , std::memory_order_relaxed);
+
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr , std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr , std::size_t) noexcept { std::free(ptr); }
+
+namespace YE {
+
+namespace bench {
+
+    static constexpr const char* kFrameVertex = R"(
+#version 460 core
+layout (location = 0) in vec3 in_pos;
+layout (location = 8) in mat4 in_instance_model;
+layout (std140 , binding = 0) uniform Camera {
+    mat4 view;
+    mat4 proj;
+    mat4 view_proj;
+    vec3 view_pos;
+    bool camera_active;
+};
+uniform bool instanced = false;
+uniform mat4 model;
+void main() {
+    mat4 model_matrix = instanced ? in_instance_model : model;
+    gl_Position = view_proj * model_matrix * vec4(in_pos , 1.0);
+}
+)";
+
+    static constexpr const char* kFrameFragment = R"(
+#version 460 core
+out vec4 frag_color;
+void main() {
+    frag_color = vec4(1.0);
+}
+)";
+
+    static bool WriteShaderSource(const std::filesystem::path& path , const char* source) {
+        std::ofstream file(path);
+        file << source;
+        return file.good();
+    }
+
+    // the renderer pulls the frame's draws from the app , the same way an application's Draw does
+    class FrameAllocApp : public App {
+        public:
+            Scene* scene = nullptr;
+
+            FrameAllocApp()
+                : App("frame_alloc_check") {}
+
+            virtual WindowConfig GetWindowConfig() override {
+                WindowConfig config;
+                config.title = "frame_alloc_check";
+                config.flags = SDL_WINDOW_HIDDEN;
+                return config;
+            }
+
+            virtual void Draw() override {
+                if (scene != nullptr)
+                    scene->Draw();
+            }
+    };
+
+    // one quad is enough , every entity draws it so the renderer batches them like repeated meshes
+    static VertexArray* CreateQuad() {
+        std::vector<Vertex> vertices(4);
+        vertices[0].position = { -0.5f , -0.5f , 0.f };
+        vertices[1].position = {  0.5f , -0.5f , 0.f };
+        vertices[2].position = {  0.5f ,  0.5f , 0.f };
+        vertices[3].position = { -0.5f ,  0.5f , 0.f };
+
+        VertexArray* vao = ynew VertexArray(vertices , { 0 , 1 , 2 , 2 , 3 , 0 });
+        vao->Prepare();
+        vao->Upload();
+        return vao;
+    }
+
+    /// \note the per frame draw path (transform propagation , bounds , culling , lod selection , syncing
+    ///     persistent draws , recording the frame into its arena and executing the sorted queue) must not
+    ///     allocate once the scene has settled. entities sweep in and out of the frustum so visibility
+    ///     changes are sent every frame
+    ///         args : [entities = 4096] [warm up frames = 8] [measured frames = 120]
+    static int FrameAllocCheck(const std::vector<std::string>& args) {
+        const uint32_t num_entities = ArgValue(args , 0 , 4096);
+        const uint32_t warm_up = ArgValue(args , 1 , 8);
+        const uint32_t frames = ArgValue(args , 2 , 120);
+
+        int failures = 0;
+
+        // the renderer opens its own hidden window and context
+        FrameAllocApp app;
+        Renderer* renderer = Renderer::Instance();
+        renderer->Initialize(&app);
+        renderer->OpenWindow();
+
+        const std::filesystem::path dir = std::filesystem::temp_directory_path();
+        const std::filesystem::path vert_path = dir / "ye_frame_alloc.vert";
+        const std::filesystem::path frag_path = dir / "ye_frame_alloc.frag";
+        if (!WriteShaderSource(vert_path , kFrameVertex) || !WriteShaderSource(frag_path , kFrameFragment)) {
+            std::printf("    Failed to write bench shaders :: %s\n" , dir.string().c_str());
+            renderer->CloseWindow();
+            renderer->Cleanup();
+            return 1;
+        }
+
+        VertexArray* quad = CreateQuad();
+        Shader* shader = ynew Shader(vert_path.string() , frag_path.string());
+        YE_BENCH_CHECK(failures , shader->Compile() , "bench shader failed to compile");
+
+        Systems::Initialize();
+        Scene* scene = ynew Scene("frame_alloc_check");
+        Systems::SetSceneContext(scene);
+        app.scene = scene;
+
+        Camera* camera = scene->AttachCamera("camera");
+        camera->SetPosition({ 0.f , 0.f , 40.f });
+        camera->SetFront({ 0.f , 0.f , -1.f });
+
+        const uint32_t row = static_cast<uint32_t>(std::sqrt(static_cast<float>(num_entities))) + 1;
+        std::vector<entt::entity> entities;
+        entities.reserve(num_entities);
+        for (uint32_t i = 0; i < num_entities; ++i) {
+            Entity* entity = scene->CreateEntity("entity " + std::to_string(i));
+
+            auto& renderable = entity->AddComponent<components::Renderable>();
+            renderable.vao = quad;
+            renderable.shader = shader;
+            renderable.shader_name = "bench";
+
+            auto& transform = entity->GetComponent<components::Transform>();
+            transform.position = { static_cast<float>(i % row) * 2.f , static_cast<float>(i / row) * 2.f , 0.f };
+
+            entities.push_back(entity->GetEntity());
+        }
+
+        auto& registry = scene->Registry();
+        auto run_frame = [&](uint32_t frame , uint64_t& allocations) {
+            const float sweep = std::sin(static_cast<float>(frame) * 0.1f) * static_cast<float>(row);
+            for (uint32_t i = 0; i < num_entities; ++i) {
+                auto& transform = registry.get<components::Transform>(entities[i]);
+                transform.position.x = static_cast<float>(i % row) * 2.f + sweep;
+                Systems::UpdateTransform(transform);
+            }
+
+            counted_allocations.store(0);
+            counting_allocations.store(true);
+
+            Systems::PropagateTransforms(scene);
+            Systems::UpdateBounds(scene);
+            renderer->Render();
+
+            counting_allocations.store(false);
+            allocations = counted_allocations.load();
+
+            Systems::ResetChangedTransforms(scene);
+        };
+
+        // the first frames push every draw and grow the scratch arrays to their working size
+        uint64_t allocations = 0;
+        for (uint32_t frame = 0; frame < warm_up; ++frame)
+            run_frame(frame , allocations);
+
+        uint64_t total = 0;
+        uint64_t worst = 0;
+        for (uint32_t frame = warm_up; frame < warm_up + frames; ++frame) {
+            run_frame(frame , allocations);
+            total += allocations;
+            worst = std::max(worst , allocations);
+        }
+
+        YE_BENCH_CHECK(failures , total == 0 , "%llu allocations over %u frames (worst frame %llu)" ,
+                       static_cast<unsigned long long>(total) , frames , static_cast<unsigned long long>(worst));
+
+        const RenderStats& stats = renderer->FrameStats();
+        YE_BENCH_CHECK(failures , stats.commands > 0 , "the renderer executed no draws");
+
+        std::printf("    %u entities , %u measured frames\n" , num_entities , frames);
+        std::printf("    allocations       : %llu total , %llu worst frame\n" ,
+                    static_cast<unsigned long long>(total) , static_cast<unsigned long long>(worst));
+        std::printf("    last frame        : %u commands , %u draw calls , %u instanced batches\n" ,
+                    stats.commands , stats.draw_calls , stats.instanced_batches);
+
+        app.scene = nullptr;
+        scene->Shutdown();
+        ydelete scene;
+        Systems::Teardown();
+
+        ydelete shader;
+        ydelete quad;
+        std::filesystem::remove(vert_path);
+        std::filesystem::remove(frag_path);
+
+        // the window's resize callback would outlive it , later cases dispatch window events of their own
+        EventManager::Instance()->UnregisterCallback("default-window-resize" , EventType::WINDOW_RESIZE);
+        renderer->CloseWindow();
+        renderer->Cleanup();
+
+        return failures;
+    }
+
+    YE_BENCH("frame_alloc" , "zero allocations per frame from the scene systems through Renderer::Render" , FrameAllocCheck)
+
+}
+
+}
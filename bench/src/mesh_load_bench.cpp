@@ -0,0 +1,92 @@
+#include "bench.hpp"
+
+#include <filesystem>
+
+#include "core/defines.hpp"
+#include "rendering/model.hpp"
+#include "rendering/baked_mesh.hpp"
+
+namespace YE {
+
+namespace bench {
+
+    struct LoadResult {
+        uint32_t vertices = 0;
+        uint32_t faces = 0;
+        AABB bounds;
+        bool imported = false;
+        bool baked = false;
+    };
+
+    static LoadResult ImportModel(const std::string& path) {
+        LoadResult result;
+
+        Model* model = ynew Model("bench" , path);
+        result.imported = model->Import();
+        result.vertices = model->NumVertices();
+        result.faces = model->NumFaces();
+        result.bounds = model->Bounds();
+        result.baked = model->Baked();
+
+        model->Cleanup();
+        ydelete model;
+        return result;
+    }
+
+    /// \note cpu side cost of Model::Import for one file , through assimp (which also writes the bake) and
+    ///     from the mapped bake. both paths have to produce the same mesh
+    ///         args : <model path> [iterations = 5]
+    static int MeshLoadBench(const std::vector<std::string>& args) {
+        if (args.empty()) {
+            std::printf("    skipped , pass a model path : bench mesh_load <model path> [iterations]\n");
+            return 0;
+        }
+
+        const std::string path = args[0];
+        const uint32_t iterations = ArgValue(args , 1 , 5);
+        const std::string baked_path = BakedMesh::BakedPath(path);
+
+        int failures = 0;
+        if (!std::filesystem::exists(path)) {
+            std::printf("    FAILED :: model does not exist :: %s\n" , path.c_str());
+            return 1;
+        }
+
+        // textures are decoded as part of the import and freed with the model
+        if (!OpenContext())
+            return 1;
+
+        LoadResult assimp;
+        double assimp_time = Measure(iterations , [&]() {
+            std::filesystem::remove(baked_path);
+            assimp = ImportModel(path);
+        });
+
+        YE_BENCH_CHECK(failures , assimp.imported && !assimp.baked , "assimp import failed");
+        YE_BENCH_CHECK(failures , std::filesystem::exists(baked_path) , "import did not write a bake :: %s" , baked_path.c_str());
+
+        LoadResult baked;
+        double baked_time = Measure(iterations , [&]() {
+            baked = ImportModel(path);
+        });
+
+        YE_BENCH_CHECK(failures , baked.imported && baked.baked , "second import did not map the bake");
+        YE_BENCH_CHECK(failures , baked.vertices == assimp.vertices && baked.faces == assimp.faces ,
+                       "bake has %u vertices , %u faces , assimp %u vertices , %u faces" ,
+                       baked.vertices , baked.faces , assimp.vertices , assimp.faces);
+        YE_BENCH_CHECK(failures , baked.bounds.min == assimp.bounds.min && baked.bounds.max == assimp.bounds.max ,
+                       "bake bounds differ from the assimp import");
+
+        std::printf("    %s , %u vertices , %u faces , %u iterations\n" , path.c_str() , assimp.vertices , assimp.faces , iterations);
+        std::printf("    assimp + bake     : %9.2f ms/load\n" , assimp_time / 1000.0);
+        std::printf("    mapped bake       : %9.2f ms/load (%.1fx)\n" , baked_time / 1000.0 , assimp_time / baked_time);
+
+        CloseContext();
+        return failures;
+    }
+
+    YE_BENCH("mesh_load" , "assimp import vs the mapped baked mesh" , MeshLoadBench)
+
+}
+
+}
@@ -0,0 +1,84 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/task_manager.hpp"
+
+namespace YE {
+
+namespace bench {
+
+    // a few microseconds of arithmetic , small enough that scheduling overhead dominates like it does for
+    // the per frame engine tasks
+    static void SpinWork(std::atomic<uint64_t>& sink) {
+        uint64_t value = 0x9E3779B97F4A7C15ull;
+        for (uint32_t i = 0; i < 512; ++i)
+            value = (value ^ (value >> 29)) * 0xBF58476D1CE4E5B9ull;
+        sink.fetch_add(value & 1 , std::memory_order_relaxed);
+    }
+
+    /// \note the engine's per frame pattern (a handful of tasks dispatched , then flushed) on a thread per
+    ///     task like the old TaskManager , on the pool , and split with DispatchParallel
+    ///         args : [frames = 2000] [tasks per frame = 4]
+    static int TaskPoolBench(const std::vector<std::string>& args) {
+        const uint32_t frames = ArgValue(args , 0 , 2000);
+        const uint32_t tasks = ArgValue(args , 1 , 4);
+
+        int failures = 0;
+        std::atomic<uint64_t> sink{ 0 };
+        std::atomic<uint32_t> executed{ 0 };
+
+        double thread_per_task = Measure(frames , [&]() {
+            std::vector<std::thread> threads;
+            threads.reserve(tasks);
+            for (uint32_t t = 0; t < tasks; ++t)
+                threads.emplace_back([&]() { SpinWork(sink); });
+            for (auto& thread : threads)
+                thread.join();
+        });
+
+        TaskManager* task_manager = TaskManager::Instance();
+        double pool = Measure(frames , [&]() {
+            for (uint32_t t = 0; t < tasks; ++t) {
+                task_manager->DispatchTask([&]() {
+                    SpinWork(sink);
+                    executed.fetch_add(1 , std::memory_order_relaxed);
+                });
+            }
+            task_manager->FlushTasks();
+        });
+
+        YE_BENCH_CHECK(failures , executed.load() == frames * tasks ,
+                       "pool executed %u of %u tasks" , executed.load() , frames * tasks);
+
+        std::atomic<uint32_t> covered{ 0 };
+        double parallel = Measure(frames , [&]() {
+            JobHandle handle = task_manager->DispatchParallel(tasks * 64 , 64 , [&](uint32_t begin , uint32_t end) {
+                for (uint32_t i = begin; i < end; i += 64)
+                    SpinWork(sink);
+                covered.fetch_add(end - begin , std::memory_order_relaxed);
+            });
+            task_manager->WaitFor(handle);
+        });
+
+        YE_BENCH_CHECK(failures , covered.load() == frames * tasks * 64 ,
+                       "DispatchParallel covered %u of %u elements" , covered.load() , frames * tasks * 64);
+
+        std::printf("    %u frames , %u tasks per frame , %u workers\n" , frames , tasks , task_manager->NumWorkers());
+        std::printf("    thread per task   : %9.2f us/frame\n" , thread_per_task);
+        std::printf("    pool              : %9.2f us/frame (%.1fx)\n" , pool , thread_per_task / pool);
+        std::printf("    DispatchParallel  : %9.2f us/frame (%.1fx)\n" , parallel , thread_per_task / parallel);
+        std::printf("    stolen            : %llu of %llu\n" ,
+                    static_cast<unsigned long long>(task_manager->Stats().jobs_stolen.load()) ,
+                    static_cast<unsigned long long>(task_manager->Stats().jobs_executed.load()));
+
+        return failures;
+    }
+
+    YE_BENCH("task_pool" , "thread per task vs the work stealing pool" , TaskPoolBench)
+
+}
+
+}
@@ -0,0 +1,121 @@
+#include "bench.hpp"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+
+#include <glad/glad.h>
+
+#include "core/defines.hpp"
+#include "rendering/shader.hpp"
+
+namespace YE {
+
+namespace bench {
+
+    static constexpr const char* kBenchVertex = R"(
+#version 460 core
+layout (location = 0) in vec3 position;
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 offset;
+void main() {
+    gl_Position = projection * view * model * vec4(position + offset , 1.0);
+}
+)";
+
+    static constexpr const char* kBenchFragment = R"(
+#version 460 core
+out vec4 frag_color;
+uniform vec3 tint;
+uniform float opacity;
+uniform float exposure;
+uniform int mode;
+void main() {
+    frag_color = vec4(tint * exposure * float(mode + 1) , opacity);
+}
+)";
+
+    static constexpr std::array<const char* , 8> kUniformNames = {
+        "model" , "view" , "projection" , "offset" , "tint" , "opacity" , "exposure" , "mode"
+    };
+
+    static constexpr std::array<UniformId , 8> kUniformIds = {
+        "model" , "view" , "projection" , "offset" , "tint" , "opacity" , "exposure" , "mode"
+    };
+
+    static bool WriteSource(const std::filesystem::path& path , const char* source) {
+        std::ofstream file(path);
+        file << source;
+        return file.good();
+    }
+
+    /// \note the cost of finding a uniform's location , the way it was done before (glGetUniformLocation on
+    ///     every set) against the hashed table probed with compile time ids and with ids hashed at runtime
+    ///         args : [iterations = 200000]
+    static int UniformLookupBench(const std::vector<std::string>& args) {
+        const uint32_t iterations = ArgValue(args , 0 , 200000);
+
+        int failures = 0;
+        if (!OpenContext())
+            return 1;
+
+        const std::filesystem::path dir = std::filesystem::temp_directory_path();
+        const std::filesystem::path vert_path = dir / "ye_uniform_bench.vert";
+        const std::filesystem::path frag_path = dir / "ye_uniform_bench.frag";
+        if (!WriteSource(vert_path , kBenchVertex) || !WriteSource(frag_path , kBenchFragment)) {
+            std::printf("    Failed to write bench shaders :: %s\n" , dir.string().c_str());
+            CloseContext();
+            return 1;
+        }
+
+        Shader* shader = ynew Shader(vert_path.string() , frag_path.string());
+        YE_BENCH_CHECK(failures , shader->Compile() , "bench shader failed to compile");
+
+        for (uint32_t i = 0; i < kUniformNames.size(); ++i) {
+            const int32_t expected = glGetUniformLocation(shader->ID() , kUniformNames[i]);
+            YE_BENCH_CHECK(failures , shader->UniformLocation(kUniformIds[i]) == expected ,
+                           "table location of [%s] is %d , GL reports %d" , kUniformNames[i] ,
+                           shader->UniformLocation(kUniformIds[i]) , expected);
+        }
+        YE_BENCH_CHECK(failures , shader->UniformLocation("not_a_uniform") == -1 , "unknown uniform found in the table");
+
+        const std::array<std::string , 8> names = {
+            "model" , "view" , "projection" , "offset" , "tint" , "opacity" , "exposure" , "mode"
+        };
+
+        int64_t sink = 0;
+        double gl_lookup = Measure(iterations , [&]() {
+            for (const auto& name : names)
+                sink += glGetUniformLocation(shader->ID() , name.c_str());
+        });
+
+        double runtime_hash = Measure(iterations , [&]() {
+            for (const auto& name : names)
+                sink += shader->UniformLocation(UniformId(name));
+        });
+
+        double table = Measure(iterations , [&]() {
+            for (const auto& id : kUniformIds)
+                sink += shader->UniformLocation(id);
+        });
+
+        std::printf("    %u iterations of %zu lookups (sink %lld)\n" , iterations , names.size() , static_cast<long long>(sink));
+        std::printf("    glGetUniformLocation : %9.3f us/iteration\n" , gl_lookup);
+        std::printf("    runtime hash + table : %9.3f us/iteration (%.1fx)\n" , runtime_hash , gl_lookup / runtime_hash);
+        std::printf("    UniformId + table    : %9.3f us/iteration (%.1fx)\n" , table , gl_lookup / table);
+
+        ydelete shader;
+        std::filesystem::remove(vert_path);
+        std::filesystem::remove(frag_path);
+        CloseContext();
+
+        return failures;
+    }
+
+    YE_BENCH("uniform_lookup" , "glGetUniformLocation vs the hashed uniform table" , UniformLookupBench)
+
+}
+
+}
@@ -90,7 +90,7 @@ namespace EngineY {
 #define DRAW(type , ...) std::unique_ptr<YE::RenderCommand> command = MAKE_RENDER_COMMAND(type , __VA_ARGS__); \
                          YE::Renderer::Instance()->SubmitRenderCmnd(command);
 #define ADD_SCRIPT_FUNCTION(class_name , call) mono_add_internal_call(#class_name"::"#call , (void*)call)
-#define EVENT(event) YE::EventManager::Instance()->DispatchEvent(ynew event)
+#define EVENT(type , ...) YE::EventManager::Instance()->Dispatch<type>(__VA_ARGS__)
 
     // Getters ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
     YE::Window* Window();
@@ -104,7 +104,16 @@ namespace EngineY {
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     /// Engine Functions ////////////////////////////////////////////////////////////////////////////////////////////////////
-    void DispatchEvent(YE::Event* event);
+    template<typename T>
+    void DispatchEvent(const T& event) {
+        YE::EventManager::Instance()->DispatchEvent(event);
+    }
+
+    // from any thread , dispatched on the main thread at the start of the next update
+    template<typename T>
+    bool PostEvent(const T& event) {
+        return YE::EventManager::Instance()->PostEvent(event);
+    }
     void ShaderReload();
     void ScriptReload();
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +141,7 @@ namespace EngineY {
 
     /// Render Callback Registration //////////////////////////////////////////////////////////////////////////////////////////
     void RegisterPreRenderCallback(std::function<void()> callback , const std::string& name);
+    // runs on the main thread while the render thread may still be executing the frame , no GL calls
     void RegisterPostRenderCallback(std::function<void()> callback , const std::string& name);
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
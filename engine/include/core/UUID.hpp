@@ -12,7 +12,7 @@ namespace YE {
     struct UUID32 {
         uint32_t uuid = 0;
         uint32_t operator()() { return uuid; }
-        inline void operator=(const UUID32& other) { uuid = other.uuid; }
+        UUID32& operator=(const UUID32& other) = default;
         inline bool operator==(const UUID32& other) const { return uuid == other.uuid; }
         inline bool operator!=(const UUID32& other) const { return uuid != other.uuid; }
         inline bool operator<(const UUID32& other) const { return uuid < other.uuid; }
@@ -28,6 +28,7 @@ namespace YE {
         inline bool operator>=(const uint32_t& other) const { return uuid >= other; }
         UUID32() : uuid(0) {}
         UUID32(uint32_t uuid) : uuid(uuid) {}
+        UUID32(const UUID32& other) = default;
     };
 
     /// \todo Register UUID with engine
@@ -44,7 +45,7 @@ namespace YE {
     struct UUID {
         uint64_t uuid = 0;
         uint64_t operator()() { return uuid; }
-        inline void operator=(const UUID& other) { uuid = other.uuid; }
+        UUID& operator=(const UUID& other) = default;
         inline bool operator==(const UUID& other) const { return uuid == other.uuid; }
         inline bool operator!=(const UUID& other) const { return uuid != other.uuid; }
         inline bool operator<(const UUID& other) const { return uuid < other.uuid; }
@@ -61,6 +62,7 @@ namespace YE {
         UUID() : uuid(0) {}
         UUID(uint64_t uuid) : uuid(uuid) {}
         UUID(UUID32 uuid) : uuid(uuid.uuid) {}
+        UUID(const UUID& other) = default;
     };
 
     /// \todo Register UUID with engine
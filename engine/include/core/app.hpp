@@ -14,6 +14,16 @@ namespace YE {
         std::string project_file_src;
 
         bool use_project_file = false;
+
+        // frames execute on a render thread of their own while the next one is simulated , the app may
+        // only touch GL from Draw and DrawGui then
+        bool threaded_rendering = false;
+
+        // every frame's input is written here on shutdown , or read from here in place of the devices. a
+        // replay ignores the recording path , runs without the frame rate cap and shuts down when it ends ,
+        // writing its frame times to <replay path>.frametimes
+        std::string record_input_path;
+        std::string replay_input_path;
     };
 
     class App {
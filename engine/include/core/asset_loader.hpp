@@ -0,0 +1,81 @@
+#ifndef YE_ASSET_LOADER_HPP
+#define YE_ASSET_LOADER_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+#include "core/defines.hpp"
+
+namespace YE {
+
+    // decoded assets waiting for the GL thread , loader threads block once this many are queued so
+    // decoded pixels and vertex data never pile up faster than they are uploaded
+    static constexpr uint32_t kAssetUploadQueueCapacity = 16;
+
+    // milliseconds of GL upload work ProcessUploads does per frame , at least one upload always runs
+    static constexpr float kAssetUploadBudget = 2.f;
+
+    /// \note decode runs on a loader thread and must not touch GL , upload runs on the GL thread and is
+    ///     skipped when decode returns false
+    struct AssetRequest {
+        std::string name;
+        std::function<bool()> decode;
+        std::function<void()> upload;
+    };
+
+    /// \note small pool of threads that only read and decode assets , kept apart from the TaskManager
+    ///     because the frame flushes that pool and a long decode would stall it. finished requests wait
+    ///     in a bounded queue until the GL thread drains it through ProcessUploads
+    class AssetLoader {
+
+        std::vector<std::thread> threads;
+
+        std::deque<AssetRequest> requests;
+        std::deque<AssetRequest> uploads;
+
+        std::mutex mutex;
+        std::condition_variable request_condition;
+        std::condition_variable space_condition;
+
+        uint32_t upload_capacity = kAssetUploadQueueCapacity;
+        bool running = false;
+
+        // requests that have not been uploaded or dropped yet
+        std::atomic<uint32_t> pending{ 0 };
+
+        AssetLoader(AssetLoader&&) = delete;
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(AssetLoader&&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+
+        void LoaderLoop();
+
+        public:
+            /// \note num_threads of 0 uses half the hardware threads
+            AssetLoader(uint32_t num_threads = 0 , uint32_t upload_capacity = kAssetUploadQueueCapacity);
+            ~AssetLoader();
+
+            void Enqueue(AssetRequest&& request);
+
+            /// \note runs queued uploads until budget milliseconds have passed , returns how many ran
+            uint32_t ProcessUploads(float budget = kAssetUploadBudget);
+
+            /// \note blocks the GL thread until every enqueued request has been uploaded
+            void Finish();
+
+            /// \note drops requests that have not started , waits for in flight decodes and joins the threads
+            void Stop();
+
+            inline bool Loading() const { return pending.load(std::memory_order_acquire) > 0; }
+            inline uint32_t Pending() const { return pending.load(std::memory_order_acquire); }
+    };
+
+}
+
+#endif // !YE_ASSET_LOADER_HPP
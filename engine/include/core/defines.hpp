@@ -28,6 +28,10 @@
 
 #define ybit(x) (1u << x)
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #define YE_SIMD_SSE 1
+#endif // !__SSE2__
+
 static constexpr uint32_t kTargetFps = 60;
 static constexpr uint32_t kTargetFrameTime = 1 / kTargetFps;
 
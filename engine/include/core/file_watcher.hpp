@@ -0,0 +1,75 @@
+#ifndef YE_FILE_WATCHER_HPP
+#define YE_FILE_WATCHER_HPP
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+
+namespace YE {
+
+    // a file is only reported once it has gone this many milliseconds without another event , editors
+    // often save in several writes or through a temporary file and a rename
+    static constexpr uint32_t kFileWatchSettleTime = 50;
+
+    // how long the watch thread sleeps between checks , also bounds how long Stop waits for it
+    static constexpr uint32_t kFileWatchInterval = 100;
+
+    /// \note watches directories and everything under them from its own thread. inotify is used on linux ,
+    ///     elsewhere the thread rescans write times every interval
+    class FileWatcher {
+
+        using Clock = std::chrono::steady_clock;
+
+        std::thread thread;
+        std::atomic<bool> running{ false };
+
+        std::vector<std::string> directories;
+
+        // changed paths and the time of their last event , guarded by the mutex
+        std::mutex mutex;
+        std::unordered_map<std::string , Clock::time_point> changes;
+
+#ifdef YE_PLATFORM_LINUX
+        int inotify_fd = -1;
+        std::unordered_map<int , std::string> watches;
+
+        void AddWatch(const std::string& directory);
+#else
+        std::unordered_map<std::string , std::filesystem::file_time_type> write_times;
+
+        void Scan(bool record);
+#endif // !YE_PLATFORM_LINUX
+
+        void WatchLoop();
+        void Record(const std::string& path);
+
+        FileWatcher(FileWatcher&&) = delete;
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(FileWatcher&&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        public:
+            FileWatcher() {}
+            ~FileWatcher();
+
+            /// \note only takes effect before Start , missing directories are skipped
+            void Watch(const std::string& directory);
+
+            bool Start();
+            void Stop();
+
+            /// \note appends every path that changed and has settled since the last call , paths are the
+            ///     watched directory joined with the file's path under it using forward slashes
+            void Poll(std::vector<std::string>& paths);
+
+            inline bool Running() const { return running.load(std::memory_order_acquire); }
+    };
+
+}
+
+#endif // !YE_FILE_WATCHER_HPP
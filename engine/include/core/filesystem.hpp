@@ -49,6 +49,7 @@ namespace YE {
             inline static std::string GetMonoConfigPath() { return script_engine_mono_config_path; }
             inline static std::string GetInternalModulesPath() { return internal_modules_path; }
             inline static std::string GetProjectModulesPath() { return project_modules_path; }
+            inline static std::string GetProjectBinPath() { return project_bin; }
 
             inline static std::string GetEngineRoot() { return engine_root; }
             inline static std::string GetEngineDir() { return engine_code_dir; }
@@ -0,0 +1,68 @@
+#ifndef YE_FRAME_ARENA_HPP
+#define YE_FRAME_ARENA_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include "core/defines.hpp"
+
+namespace YE {
+
+    static constexpr size_t kDefaultFrameArenaSize = 1024 * 1024;
+
+    /// \note bump allocator for data that only lives for one frame , nothing is freed individually and
+    ///     Reset hands the whole block back at once. running out of space chains an overflow block so the
+    ///     frame still succeeds , the next Reset folds them into one block big enough for the peak usage
+    ///     so a steady scene stops allocating after its first few frames
+    class FrameArena {
+
+        uint8_t* memory = nullptr;
+        size_t capacity = 0;
+        size_t offset = 0;
+
+        std::vector<uint8_t*> overflow_blocks;
+        size_t overflow_bytes = 0;
+        size_t high_water = 0;
+
+        FrameArena(FrameArena&&) = delete;
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(FrameArena&&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* AllocateOverflow(size_t size , size_t alignment);
+
+        public:
+            FrameArena(size_t capacity = kDefaultFrameArenaSize);
+            ~FrameArena();
+
+            void* Allocate(size_t size , size_t alignment = alignof(std::max_align_t));
+            void Reset();
+
+            /// \note only trivially destructible types , nothing runs destructors when the arena resets
+            template<typename T , typename... Args>
+            T* New(Args&&... args) {
+                static_assert(std::is_trivially_destructible_v<T> , "Frame arena objects must be trivially destructible");
+                void* ptr = Allocate(sizeof(T) , alignof(T));
+                return new (ptr) T(std::forward<Args>(args)...);
+            }
+
+            template<typename T>
+            T* NewArray(size_t count) {
+                static_assert(std::is_trivially_destructible_v<T> , "Frame arena objects must be trivially destructible");
+                if (count == 0) return nullptr;
+                void* ptr = Allocate(sizeof(T) * count , alignof(T));
+                return new (ptr) T[count];
+            }
+
+            inline size_t Used() const { return offset + overflow_bytes; }
+            inline size_t Capacity() const { return capacity; }
+            inline size_t HighWater() const { return high_water; }
+    };
+
+}
+
+#endif // !YE_FRAME_ARENA_HPP
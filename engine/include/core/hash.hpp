@@ -2,20 +2,42 @@
 #define YE_HASH_HPP
 
 #include <array>
+#include <cstdint>
 #include <string_view>
 
 namespace YE {
 
 namespace Hash {
 
-    static const uint32_t kFnvOffsetBasisU32 = 0x811C9DC5;
-    static const uint32_t kFnvPrimeU32 = 0x01000193;
+    static constexpr uint32_t kFnvOffsetBasisU32 = 0x811C9DC5;
+    static constexpr uint32_t kFnvPrimeU32 = 0x01000193;
 
-    static const uint64_t kFnvOffsetBasis = 0xBCF29CE484222325;
-    static const uint64_t kFnvPrime = 0x100000001B3;
+    static constexpr uint64_t kFnvOffsetBasis = 0xBCF29CE484222325;
+    static constexpr uint64_t kFnvPrime = 0x100000001B3;
 
-    uint64_t FNV(std::string_view str);
-    uint32_t FNV32(std::string_view str);
+    constexpr uint64_t FNV(std::string_view str) {
+        uint64_t hash = kFnvOffsetBasis;
+        for (auto& c : str) {
+            hash ^= c;
+            hash *= kFnvPrime;
+        }
+        hash ^= str.length();
+        hash *= kFnvPrime;
+
+        return hash;
+    }
+
+    // constexpr so names known at compile time (uniforms , keywords) hash to a constant
+    constexpr uint32_t FNV32(std::string_view str) {
+        uint32_t hash = kFnvOffsetBasisU32;
+        for (auto& c : str) {
+            hash ^= c;
+            hash *= kFnvPrimeU32;
+        }
+        hash ^= '\0';
+        hash *= kFnvPrimeU32;
+        return hash;
+    }
 
     constexpr auto GenCRC32Table() {
         constexpr int num_bytes = 256;
@@ -0,0 +1,43 @@
+#ifndef YE_MAPPED_FILE_HPP
+#define YE_MAPPED_FILE_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace YE {
+
+    /// \note read only view of a whole file mapped into memory , pages are faulted in by the OS as they
+    ///     are touched so nothing is copied until the data is actually read
+    class MappedFile {
+
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+
+#ifdef YE_PLATFORM_WIN
+        void* file_handle = nullptr;
+        void* mapping_handle = nullptr;
+#else
+        int file_descriptor = -1;
+#endif // !YE_PLATFORM_WIN
+
+        MappedFile(MappedFile&&) = delete;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        public:
+            MappedFile() {}
+            ~MappedFile();
+
+            bool Open(const std::string& path);
+            void Close();
+
+            inline bool IsOpen() const { return data != nullptr; }
+            inline const uint8_t* Data() const { return data; }
+            inline size_t Size() const { return size; }
+    };
+
+}
+
+#endif // !YE_MAPPED_FILE_HPP
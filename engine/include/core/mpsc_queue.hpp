@@ -0,0 +1,87 @@
+#ifndef YE_MPSC_QUEUE_HPP
+#define YE_MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace YE {
+
+    /// \note bounded multi producer , single consumer ring. every cell carries a sequence number that tells
+    ///     producers whether it is free and the consumer whether it has been written , so producers only
+    ///     contend on one compare exchange of the tail and nothing ever blocks or allocates. a full queue
+    ///     refuses the push instead of waiting
+    template<typename T , uint32_t N>
+    class MPSCQueue {
+        static_assert(N >= 2 && (N & (N - 1)) == 0 , "capacity has to be a power of two");
+
+        static constexpr uint32_t kMask = N - 1;
+
+        struct Cell {
+            std::atomic<uint32_t> sequence{ 0 };
+            T value;
+        };
+
+        std::array<Cell , N> cells;
+
+        // producers and the consumer sit on their own cache lines so pushing does not slow down popping
+        alignas(64) std::atomic<uint32_t> tail{ 0 };
+        alignas(64) uint32_t head = 0;
+
+        MPSCQueue(MPSCQueue&&) = delete;
+        MPSCQueue(const MPSCQueue&) = delete;
+        MPSCQueue& operator=(MPSCQueue&&) = delete;
+        MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+        public:
+            MPSCQueue() {
+                for (uint32_t i = 0; i < N; ++i)
+                    cells[i].sequence.store(i , std::memory_order_relaxed);
+            }
+
+            /// \note safe from any thread , false when the queue is full
+            bool Push(const T& value) {
+                uint32_t pos = tail.load(std::memory_order_relaxed);
+                while (true) {
+                    Cell& cell = cells[pos & kMask];
+                    const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+                    const int32_t diff = static_cast<int32_t>(sequence - pos);
+
+                    if (diff == 0) {
+                        if (tail.compare_exchange_weak(pos , pos + 1 , std::memory_order_relaxed)) {
+                            cell.value = value;
+                            cell.sequence.store(pos + 1 , std::memory_order_release);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = tail.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            /// \note consumer thread only , false when empty or when the oldest push has claimed its cell but
+            ///     not finished writing it yet (it is picked up by the next pop)
+            bool Pop(T& value) {
+                Cell& cell = cells[head & kMask];
+                const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+                if (static_cast<int32_t>(sequence - (head + 1)) < 0)
+                    return false;
+
+                value = cell.value;
+                cell.sequence.store(head + N , std::memory_order_release);
+                ++head;
+                return true;
+            }
+
+            /// \note consumer thread only , pushes claimed so far that have not been popped. the newest of them
+            ///     may still be writing their cells
+            inline uint32_t Pending() const { return tail.load(std::memory_order_acquire) - head; }
+
+            inline static constexpr uint32_t Capacity() { return N; }
+    };
+
+}
+
+#endif // !YE_MPSC_QUEUE_HPP
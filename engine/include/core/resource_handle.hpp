@@ -0,0 +1,124 @@
+#ifndef YE_RESOURCE_HANDLE_HPP
+#define YE_RESOURCE_HANDLE_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "core/hash.hpp"
+
+namespace YE {
+
+    class Shader;
+    class Texture;
+    class Model;
+    class VertexArray;
+
+    /// \note hashed resource name , literals hash at compile time and strings hash once at the call site.
+    ///     matches the keys of the resource maps (Hash::FNV of the resource name)
+    struct ResourceName {
+        uint64_t hash = 0;
+
+        constexpr ResourceName() = default;
+
+        template <size_t N>
+        consteval ResourceName(const char (&name)[N])
+            : hash(Hash::FNV(std::string_view(name , N - 1))) {}
+
+        ResourceName(const std::string& name)
+            : hash(Hash::FNV(name)) {}
+
+        explicit constexpr ResourceName(std::string_view name)
+            : hash(Hash::FNV(name)) {}
+    };
+
+    // low bits index the pool slot , high bits hold the slot's generation when the handle was made
+    static constexpr uint32_t kHandleIndexBits = 20;
+    static constexpr uint32_t kHandleGenerationBits = 32 - kHandleIndexBits;
+    static constexpr uint32_t kHandleIndexMask = (1u << kHandleIndexBits) - 1;
+    static constexpr uint32_t kHandleGenerationMask = (1u << kHandleGenerationBits) - 1;
+
+    /// \note 32 bit reference into a ResourcePool<T> , a value of 0 is the null handle. generations start
+    ///     at 1 so a live handle is never 0 , and bump whenever a slot is freed so stale handles stop resolving
+    template <typename T>
+    struct Handle {
+        uint32_t value = 0;
+
+        constexpr Handle() = default;
+        constexpr Handle(uint32_t index , uint32_t generation)
+            : value(((generation & kHandleGenerationMask) << kHandleIndexBits) | (index & kHandleIndexMask)) {}
+
+        constexpr uint32_t Index() const { return value & kHandleIndexMask; }
+        constexpr uint32_t Generation() const { return value >> kHandleIndexBits; }
+
+        constexpr bool Null() const { return value == 0; }
+        constexpr bool operator==(const Handle& other) const { return value == other.value; }
+        constexpr bool operator!=(const Handle& other) const { return value != other.value; }
+    };
+
+    using ShaderHandle = Handle<Shader>;
+    using TextureHandle = Handle<Texture>;
+    using ModelHandle = Handle<Model>;
+    using VertexArrayHandle = Handle<VertexArray>;
+
+    /// \note dense slots of non owning pointers , freed slots are reused through a free list. lookups are
+    ///     an index and a generation compare
+    template <typename T>
+    class ResourcePool {
+
+        std::vector<T*> slots;
+        std::vector<uint32_t> generations;
+        std::vector<uint32_t> free_slots;
+
+        public:
+            Handle<T> Insert(T* resource) {
+                uint32_t index = 0;
+                if (!free_slots.empty()) {
+                    index = free_slots.back();
+                    free_slots.pop_back();
+                } else {
+                    index = static_cast<uint32_t>(slots.size());
+                    slots.push_back(nullptr);
+                    generations.push_back(1);
+                }
+
+                slots[index] = resource;
+                return Handle<T>(index , generations[index]);
+            }
+
+            void Remove(Handle<T> handle) {
+                if (!Alive(handle)) return;
+
+                const uint32_t index = handle.Index();
+                slots[index] = nullptr;
+
+                // skip generation 0 on wrap around so a live handle can never equal the null handle
+                generations[index] = (generations[index] + 1) & kHandleGenerationMask;
+                if (generations[index] == 0) generations[index] = 1;
+
+                free_slots.push_back(index);
+            }
+
+            inline bool Alive(Handle<T> handle) const {
+                const uint32_t index = handle.Index();
+                return !handle.Null() && index < slots.size() && generations[index] == handle.Generation();
+            }
+
+            inline T* Get(Handle<T> handle) const {
+                return Alive(handle) ? slots[handle.Index()] : nullptr;
+            }
+
+            void Clear() {
+                for (uint32_t i = 0; i < slots.size(); ++i) {
+                    if (slots[i] == nullptr) continue;
+                    Remove(Handle<T>(i , generations[i]));
+                }
+            }
+
+            inline uint32_t Size() const { return static_cast<uint32_t>(slots.size() - free_slots.size()); }
+    };
+
+}
+
+#endif // !YE_RESOURCE_HANDLE_HPP
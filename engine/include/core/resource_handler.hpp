@@ -7,9 +7,13 @@
 
 #include "log.hpp"
 #include "UUID.hpp"
+#include "core/asset_loader.hpp"
+#include "core/file_watcher.hpp"
+#include "core/resource_handle.hpp"
 #include "rendering/vertex_array.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/texture.hpp"
+#include "rendering/texture_array.hpp"
 #include "rendering/model.hpp"
 
 namespace YE {
@@ -21,6 +25,13 @@ namespace YE {
 
         static ResourceHandler* singleton;
 
+        AssetLoader* asset_loader = nullptr;
+
+        // resource directories are watched for changes , changed files are picked up at the start of
+        // ProcessUploads and reloaded through the asset loader
+        FileWatcher* file_watcher = nullptr;
+        std::vector<std::string> changed_files;
+
         ResourceMap<ShaderResource> engine_shaders;
         ResourceMap<TextureResource> engine_textures;
 
@@ -32,6 +43,16 @@ namespace YE {
         ResourceMap<ModelResource> engine_models;
         ResourceMap<ModelResource> app_models;
 
+        // every live resource has a slot here , handles index them directly instead of going through the maps
+        ResourcePool<Shader> shader_pool;
+        ResourcePool<Texture> texture_pool;
+        ResourcePool<Model> model_pool;
+        ResourcePool<VertexArray> vao_pool;
+
+        // project textures of the same format and size share arrays so draws switching between them
+        // only change a layer index
+        TextureArrayManager texture_arrays;
+
         std::string engine_resource_dir;
         std::string engine_shader_dir;
         std::string engine_texture_dir;
@@ -44,6 +65,22 @@ namespace YE {
 
         bool shaders_reloaded = false;
 
+        // shaders and textures hot reload in place , the scene only has to rebuild the draws using them
+        std::vector<Shader*> reloaded_shaders;
+        std::vector<Texture*> reloaded_textures;
+        bool models_reloaded = false;
+
+        // reloaded models are new objects. staged ones are still importing , replaced ones stay alive until the
+        // scene has rebound its entities (physics meshes point into the vertex data) and no frame in flight
+        // can still draw them
+        struct RetiredModel {
+            Model* model = nullptr;
+            uint32_t frames = 0;
+        };
+
+        std::vector<Model*> staged_models;
+        std::vector<RetiredModel> retired_models;
+
         void StoreShaders(const std::string& dir_path , ResourceMap<ShaderResource>& shaders);
         void StoreTextures(const std::string& dir_path , ResourceMap<TextureResource>& textures);
         void GeneratePrimitiveVAOs(ResourceMap<VertexArrayResource>& vaos);
@@ -59,9 +96,23 @@ namespace YE {
         void CleanupPrimitiveVAOs(ResourceMap<VertexArrayResource>& vaos);
         void CleanupModels(ResourceMap<ModelResource>& models);
 
+        void WatchResources();
+        void ProcessReloads();
+        void ReleaseRetiredModels();
+        void HotReloadShaders(ResourceMap<ShaderResource>& shaders , const std::string& path);
+        void HotReloadTextures(ResourceMap<TextureResource>& textures , const std::string& path);
+        void HotReloadModels(ResourceMap<ModelResource>& models , const std::string& path);
+
         ResourceHandler() {}
         ~ResourceHandler() {}
 
+        template<typename T>
+        static auto FindHandle(const ResourceMap<T>& map , ResourceName name) -> decltype(T::handle) {
+            auto itr = map.find(name.hash);
+            if (itr == map.end()) return {};
+            return itr->second.handle;
+        }
+
         template<typename T>
         bool CheckID(UUID id , const std::string& name , const ResourceMap<T>& map) {
             if (map.find(id) != map.end()) {
@@ -80,31 +131,65 @@ namespace YE {
 
             static ResourceHandler* Instance();
 
+            /// \note shaders and primitives are ready when this returns , textures and models are created
+            ///     right away but decode on loader threads and bind a placeholder (or draw nothing) until
+            ///     ProcessUploads has uploaded them
             void Load();
             void Offload();
 
+            /// \note called once a frame on the GL thread , also queues reloads for files changed on disk so
+            ///     reloaded resources are swapped in here at a frame boundary
+            void ProcessUploads(float budget = kAssetUploadBudget);
+            /// \note blocks until every queued texture and model is uploaded
+            void FinishLoading();
+
             void AddShader(const std::string& vert_path , const std::string& frag_path ,
                            const std::string& geom_path = "");
             void AddTexture(const std::string& path);
             void AddModel(const std::string& path);
 
-            Shader* GetCoreShader(const std::string& name);
-            Shader* GetShader(const std::string& name);
+            Shader* GetCoreShader(ResourceName name);
+            Shader* GetShader(ResourceName name);
 
-            Texture* GetCoreTexture(const std::string& name);
-            Texture* GetTexture(const std::string& name);
+            Texture* GetCoreTexture(ResourceName name);
+            Texture* GetTexture(ResourceName name);
 
-            VertexArray* GetPrimitiveVAO(const std::string& name);
+            VertexArray* GetPrimitiveVAO(ResourceName name);
 
-            Model* GetCoreModel(const std::string& name);
-            Model* GetModel(const std::string& name);
+            Model* GetCoreModel(ResourceName name);
+            Model* GetModel(ResourceName name);
 
+            /// \note app resources are searched before the engine's , a null handle means no match
+            ShaderHandle FindShader(ResourceName name) const;
+            TextureHandle FindTexture(ResourceName name) const;
+            ModelHandle FindModel(ResourceName name) const;
+            VertexArrayHandle FindPrimitiveVAO(ResourceName name) const;
+
+            /// \note null once the resource has been unloaded or reloaded
+            inline Shader* Get(ShaderHandle handle) const { return shader_pool.Get(handle); }
+            inline Texture* Get(TextureHandle handle) const { return texture_pool.Get(handle); }
+            inline Model* Get(ModelHandle handle) const { return model_pool.Get(handle); }
+            inline VertexArray* Get(VertexArrayHandle handle) const { return vao_pool.Get(handle); }
+
+            /// \note recompiles every shader , the scene then rebinds every entity
             void ReloadShaders();
 
             void Cleanup();
 
             inline void AcknowledgeShaderReload() { shaders_reloaded = false; }
             inline bool ShadersReloaded() const { return shaders_reloaded; }
+
+            inline void AcknowledgeHotReload() {
+                reloaded_shaders.clear();
+                reloaded_textures.clear();
+                models_reloaded = false;
+            }
+            inline bool HotReloaded() const { return !reloaded_shaders.empty() || !reloaded_textures.empty() || models_reloaded; }
+            inline const std::vector<Shader*>& ReloadedShaders() const { return reloaded_shaders; }
+            inline const std::vector<Texture*>& ReloadedTextures() const { return reloaded_textures; }
+            inline bool ModelsReloaded() const { return models_reloaded; }
+            inline bool Loading() const { return asset_loader != nullptr && asset_loader->Loading(); }
+            inline const TextureArrayManager& TextureArrays() const { return texture_arrays; }
     };
 
 }
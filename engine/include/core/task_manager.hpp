@@ -1,20 +1,46 @@
 #ifndef YE_TASK_MANAGER_HPP
 #define YE_TASK_MANAGER_HPP
 
-#include <queue>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include "tasks.hpp"
 #include "log.hpp"
 
 namespace YE {
 
+    struct TaskStats {
+        std::atomic<uint64_t> jobs_dispatched{ 0 };
+        std::atomic<uint64_t> jobs_executed{ 0 };
+        std::atomic<uint64_t> jobs_stolen{ 0 };
+    };
+
+    /// \note fixed pool of worker threads with one work queue each, tasks dispatched from a worker
+    ///     land in its own queue and idle workers steal from the others. threads that are not workers
+    ///     (the main thread) hand tasks out round robin and help execute while they wait
     class TaskManager {
 
         static TaskManager* singleton;
+        static thread_local int32_t worker_index;
+
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+
+        std::atomic<uint32_t> outstanding_jobs{ 0 };
+        std::atomic<uint32_t> queued_jobs{ 0 };
+        std::atomic<uint32_t> sleeping_workers{ 0 };
+        std::atomic<uint32_t> next_queue{ 0 };
+        std::atomic<bool> running{ false };
 
-        std::queue<BaseTask*> task_queue;
-        
-        TaskManager() {}
+        std::mutex sleep_mutex;
+        std::condition_variable wake_condition;
+
+        TaskStats stats;
+
+        TaskManager();
         ~TaskManager() {}
 
         TaskManager(TaskManager&&) = delete;
@@ -22,27 +48,52 @@ namespace YE {
         TaskManager& operator=(TaskManager&&) = delete;
         TaskManager& operator=(const TaskManager&) = delete;
 
+        void WorkerLoop(uint32_t index);
+
+        Job* FindJob();
+        void Schedule(Job* job);
+        void Execute(Job* job);
+        void Resolve(Job* job);
+        void Submit(Job* job , const std::vector<JobHandle>& dependencies);
+
         public:
 
             static TaskManager* Instance();
 
-            void DispatchTask(BaseTask* task);
+            JobHandle DispatchTask(BaseTask* task);
+            JobHandle DispatchTaskAfter(const std::vector<JobHandle>& dependencies , BaseTask* task);
 
-        template<typename C , typename... Args>
-            void DispatchTask(C&& callable , Args&&... args)  {
+            template<typename C , typename... Args>
+            JobHandle DispatchTask(C&& callable , Args&&... args)  {
                 BaseTask* task = ynew Task(
-                    std::forward<C>(callable) , 
+                    std::forward<C>(callable) ,
                     std::forward<Args>(args)...
                 );
-                task_queue.push(task);
-                task->Dispatch();
+                return DispatchTask(task);
             }
 
+            template<typename C , typename... Args>
+            JobHandle DispatchTaskAfter(const std::vector<JobHandle>& dependencies , C&& callable , Args&&... args) {
+                BaseTask* task = ynew Task(
+                    std::forward<C>(callable) ,
+                    std::forward<Args>(args)...
+                );
+                return DispatchTaskAfter(dependencies , task);
+            }
+
+            /// \note splits [0 , count) into chunks of at most grain elements and runs fn(begin , end)
+            ///     for each chunk on the pool, the returned handle finishes once every chunk has
+            JobHandle DispatchParallel(uint32_t count , uint32_t grain , std::function<void(uint32_t , uint32_t)> fn);
+
+            void WaitFor(const JobHandle& handle);
             void FlushTasks();
 
             void Cleanup();
+
+            inline uint32_t NumWorkers() const { return static_cast<uint32_t>(workers.size()); }
+            inline const TaskStats& Stats() const { return stats; }
     };
 
 }
 
-#endif // !YE_TASK_MANAGER_HPP
\ No newline at end of file
+#endif // !YE_TASK_MANAGER_HPP
@@ -2,43 +2,102 @@
 #define YE_TASKS_HPP
 
 #include <functional>
-#include <thread>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <vector>
 
 namespace YE {
 
+    struct Job;
+
+    /// \note counts the jobs that still have to finish before anything waiting on this
+    ///     counter (a thread in TaskManager::WaitFor or a dependent job) is allowed to run
+    class JobCounter {
+        std::atomic<uint32_t> pending{ 0 };
+
+        std::mutex continuation_mutex;
+        std::vector<Job*> continuations{};
+
+        friend class TaskManager;
+
+        public:
+            JobCounter() {}
+            ~JobCounter() {}
+
+            inline bool Done() const { return pending.load(std::memory_order_acquire) == 0; }
+            inline uint32_t Pending() const { return pending.load(std::memory_order_acquire); }
+    };
+
+    using JobHandle = std::shared_ptr<JobCounter>;
+
     class BaseTask {
         public:
             BaseTask() {}
             virtual ~BaseTask() {}
-            virtual void Dispatch() = 0;
-            virtual void WaitFor() = 0;
+            virtual void Execute() = 0;
     };
 
     template<typename C , typename... Args>
     class Task : public BaseTask {
         std::function<void()> callable;
-        std::unique_ptr<std::thread> thread = nullptr;
 
         public:
-            Task(C&& func , Args... args) 
-                : callable([fn = std::forward<C>(func) , ...params = std::forward<Args>(args)]{ 
+            Task(C&& func , Args... args)
+                : callable([fn = std::forward<C>(func) , ...params = std::forward<Args>(args)]{
                         fn(params...);
                     }) {}
             virtual ~Task() override {}
 
-            virtual void Dispatch() override {
-                if (thread != nullptr) return;
-                thread = std::make_unique<std::thread>(callable);
+            virtual void Execute() override {
+                callable();
+            }
+    };
+
+    struct Job {
+        BaseTask* task = nullptr;
+        JobHandle counter = nullptr;
+
+        // dependencies that have not finished yet + 1 guard held while the job is being dispatched
+        std::atomic<uint32_t> unresolved{ 1 };
+
+        Job(BaseTask* task , const JobHandle& counter)
+            : task(task) , counter(counter) {}
+    };
+
+    /// \note owner pushes and pops from the back (LIFO keeps caches warm), thieves take from the
+    ///     front so they grab the oldest (and usually largest) pieces of work
+    class WorkQueue {
+        std::mutex mutex;
+        std::deque<Job*> jobs;
+
+        public:
+            WorkQueue() {}
+            ~WorkQueue() {}
+
+            inline void Push(Job* job) {
+                std::lock_guard<std::mutex> lock(mutex);
+                jobs.push_back(job);
             }
 
-            virtual void WaitFor() override {
-                if (thread == nullptr) return;
+            inline Job* Pop() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (jobs.empty()) return nullptr;
+                Job* job = jobs.back();
+                jobs.pop_back();
+                return job;
+            }
 
-                thread->join();
+            inline Job* Steal() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (jobs.empty()) return nullptr;
+                Job* job = jobs.front();
+                jobs.pop_front();
+                return job;
             }
     };
 
 }
 
-#endif // !YE_TASKS_HPP
\ No newline at end of file
+#endif // !YE_TASKS_HPP
@@ -2,6 +2,7 @@
 #define YE_TIMER_HPP
 
 #include <chrono>
+#include <thread>
 
 namespace YE {
 
@@ -77,6 +77,8 @@ namespace YE {
             void Open();
 
             void Clear();
+            /// \note for frames executed away from the main thread , they carry their own copy of size and color
+            void Clear(const glm::ivec2& viewport , const glm::vec4& color);
             void SwapBuffers();
             
             void Close();
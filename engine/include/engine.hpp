@@ -19,6 +19,8 @@ namespace YE {
     class ScriptEngine;
     class PhysicsEngine;
     class Renderer;
+    class RenderThread;
+    class InputRecorder;
     class TaskManager;
     class EventManager;
     class ResourceHandler;
@@ -39,9 +41,11 @@ namespace YE {
         ScriptEngine* script_engine = nullptr;
         PhysicsEngine* physics_engine = nullptr;
         Renderer* renderer = nullptr;
+        RenderThread* render_thread = nullptr;
         TaskManager* task_manager = nullptr;
         EventManager* event_manager = nullptr;
         ResourceHandler* resource_handler = nullptr;
+        InputRecorder* input_recorder = nullptr;
 
         time::DeltaTime delta_time;
         time::FrameRateEnforcer<kTargetFps> frame_rate;
@@ -1,9 +1,14 @@
 #ifndef YE_EVENT_MANAGER_HPP
 #define YE_EVENT_MANAGER_HPP
 
-#include <unordered_map>
+#include <new>
+#include <tuple>
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <cstddef>
 #include <functional>
-#include <queue>
+#include <type_traits>
 
 #include "log.hpp"
 #include "events.hpp"
@@ -13,52 +18,112 @@
 #include "scene_events.hpp"
 #include "editor_events.hpp"
 #include "core/UUID.hpp"
+#include "core/hash.hpp"
+#include "core/mpsc_queue.hpp"
 #include "input/mouse.hpp"
 #include "input/keyboard.hpp"
 
 namespace YE {
 
+    // events of one type a frame can hold before the oldest slot is reused
+    static constexpr uint32_t kEventRingSize = 64;
+
+    // events posted from other threads that can wait for the main thread at once , and the largest
+    // event that fits in one
+    static constexpr uint32_t kEventQueueSize = 1024;
+    static constexpr uint32_t kMaxQueuedEventSize = 48;
+
+    /// \note a posted event copied into raw bytes so every event type fits the same queue cell
+    struct QueuedEvent {
+        EventType type = EventType::EMPTY;
+        alignas(std::max_align_t) unsigned char data[kMaxQueuedEventSize];
+    };
+
     template<typename T>
-    using CallbackMap = std::unordered_map<UUID32 , std::function<bool(T*)>>;
+    struct EventCallback {
+        UUID32 id;
+        std::function<bool(T*)> callback;
+    };
 
-    class EventManager {
-        
-        static EventManager* singleton;
+    /// \note callbacks and storage for one event type. dispatched events are constructed in place in a
+    ///     fixed ring and callbacks get a pointer to the slot , which stays valid until the events are
+    ///     flushed at the end of the frame (or the ring wraps around to it)
+    template<typename T>
+    class EventChannel {
+        static_assert(std::is_trivially_destructible_v<T> , "events are never destroyed , only overwritten");
+
+        alignas(T) unsigned char ring[sizeof(T) * kEventRingSize];
+        uint32_t dispatched = 0;
+
+        public:
+            using EventT = T;
+            static constexpr EventType kType = T::kType;
+
+            std::vector<EventCallback<T>> callbacks;
+
+            template<typename... Args>
+            T* Emplace(Args&&... args) {
+                void* slot = ring + sizeof(T) * (dispatched % kEventRingSize);
+                ++dispatched;
+                return ::new (slot) T(std::forward<Args>(args)...);
+            }
+
+            void Dispatch(T* event) {
+                // indexed so a callback registering another one does not invalidate the loop
+                for (size_t i = 0; i < callbacks.size(); ++i)
+                    event->handled = callbacks[i].callback(event) || event->handled;
+            }
+
+            bool Contains(UUID32 id) const {
+                for (const auto& cb : callbacks) {
+                    if (cb.id == id) return true;
+                }
+                return false;
+            }
 
-        CallbackMap<WindowResized> window_resized_callbacks;
-        CallbackMap<WindowMinimized> window_minimized_callbacks;
-        CallbackMap<WindowClosed> window_closed_callbacks;
+            void Remove(UUID32 id) {
+                for (auto itr = callbacks.begin(); itr != callbacks.end(); ++itr) {
+                    if (itr->id == id) {
+                        callbacks.erase(itr);
+                        return;
+                    }
+                }
+            }
 
-        CallbackMap<KeyPressed> key_pressed_callbacks;
-        CallbackMap<KeyReleased> key_released_callbacks;
-        CallbackMap<KeyHeld> key_held_callbacks;
+            inline uint32_t Dispatched() const { return dispatched; }
+            inline void Flush() { dispatched = 0; }
+    };
 
-        CallbackMap<MouseMoved> mouse_moved_callbacks;
-        CallbackMap<MouseScrolled> mouse_scrolled_callbacks;
-        CallbackMap<MouseButtonPressed> mouse_button_pressed_callbacks;
-        CallbackMap<MouseButtonReleased> mouse_button_released_callbacks;
-        CallbackMap<MouseButtonHeld> mouse_button_held_callbacks;
+    class EventManager {
 
-        CallbackMap<SceneLoad> scene_load_callbacks;
-        CallbackMap<SceneStart> scene_start_callbacks;
-        CallbackMap<SceneStop> scene_stop_callbacks;
-        CallbackMap<SceneUnload> scene_unload_callbacks;
+        static EventManager* singleton;
 
-        CallbackMap<EditorPlay> editor_scene_play_callbacks;
-        CallbackMap<EditorPause> editor_scene_pause_callbacks;
-        CallbackMap<EditorStop> editor_scene_stop_callbacks;
+        // one channel per event type , std::get picks it at compile time so dispatch is a direct call
+        std::tuple<
+            EventChannel<WindowResized> , EventChannel<WindowMinimized> , EventChannel<WindowClosed> ,
+            EventChannel<KeyPressed> , EventChannel<KeyReleased> , EventChannel<KeyHeld> ,
+            EventChannel<MouseMoved> , EventChannel<MouseScrolled> ,
+            EventChannel<MouseButtonPressed> , EventChannel<MouseButtonReleased> , EventChannel<MouseButtonHeld> ,
+            EventChannel<SceneLoad> , EventChannel<SceneStart> , EventChannel<SceneStop> , EventChannel<SceneUnload> ,
+            EventChannel<EditorPlay> , EventChannel<EditorPause> , EventChannel<EditorStop> ,
+            EventChannel<ShutdownEvent>
+        > channels;
 
-        std::function<bool(ShutdownEvent*)> shutdown_callback;
+        MPSCQueue<QueuedEvent , kEventQueueSize> queued_events;
+        std::atomic<uint32_t> dropped_events{ 0 };
 
-        std::queue<Event*> dispatched_events;
+        template<typename T>
+        inline EventChannel<T>& Channel() { return std::get<EventChannel<T>>(channels); }
 
         template<typename T>
-        bool CheckID(UUID32 id , const std::string& name , const CallbackMap<T>& map) {
-            if (map.find(id) != map.end()) {
+        void RegisterCallback(std::function<bool(T*)> callback , const std::string& name) {
+            UUID32 id = Hash::FNV32(name);
+            EventChannel<T>& channel = Channel<T>();
+            if (channel.Contains(id)) {
                 YE_WARN("Failed to register callback :: [{0}] | Name already exists" , name);
-                return false;
+                return;
             }
-            return true;
+            channel.callbacks.push_back({ id , callback });
         }
 
         EventManager() {}
@@ -73,31 +138,75 @@ namespace YE {
 
             static EventManager* Instance();
 
-            void RegisterWindowResizedCallback(std::function<bool(WindowResized*)> callback , const std::string& name);
-            void RegisterWindowMinimizedCallback(std::function<bool(WindowMinimized*)> callback , const std::string& name);
-            void RegisterWindowClosedCallback(std::function<bool(WindowClosed*)> callback , const std::string& name);
-            void RegisterKeyPressedCallback(std::function<bool(KeyPressed*)> callback , const std::string& name);
-            void RegisterKeyReleasedCallback(std::function<bool(KeyReleased*)> callback , const std::string& name);
-            void RegisterKeyHeldCallback(std::function<bool(KeyHeld*)> callback , const std::string& name);
-            void RegisterMouseMovedCallback(std::function<bool(MouseMoved*)> callback , const std::string& name);
-            void RegisterMouseScrolledCallback(std::function<bool(MouseScrolled*)> callback , const std::string& name);
-            void RegisterMouseButtonPressedCallback(std::function<bool(MouseButtonPressed*)> callback , const std::string& name);
-            void RegisterMouseButtonReleasedCallback(std::function<bool(MouseButtonReleased*)> callback , const std::string& name);
-            void RegisterMouseButtonHeldCallback(std::function<bool(MouseButtonHeld*)> callback , const std::string& name);
-            void RegisterSceneLoadCallback(std::function<bool(SceneLoad*)> callback , const std::string& name);
-            void RegisterSceneStartCallback(std::function<bool(SceneStart*)> callback , const std::string& name);
-            void RegisterSceneStopCallback(std::function<bool(SceneStop*)> callback , const std::string& name);
-            void RegisterSceneUnloadCallback(std::function<bool(SceneUnload*)> callback , const std::string& name);
-            void RegisterEditorPlayCallback(std::function<bool(EditorPlay*)> callback , const std::string& name);
-            void RegisterEditorPauseCallback(std::function<bool(EditorPause*)> callback , const std::string& name);
-            void RegisterEditorStopCallback(std::function<bool(EditorStop*)> callback , const std::string& name);
-            
+            inline void RegisterWindowResizedCallback(std::function<bool(WindowResized*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterWindowMinimizedCallback(std::function<bool(WindowMinimized*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterWindowClosedCallback(std::function<bool(WindowClosed*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterKeyPressedCallback(std::function<bool(KeyPressed*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterKeyReleasedCallback(std::function<bool(KeyReleased*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterKeyHeldCallback(std::function<bool(KeyHeld*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterMouseMovedCallback(std::function<bool(MouseMoved*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterMouseScrolledCallback(std::function<bool(MouseScrolled*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterMouseButtonPressedCallback(std::function<bool(MouseButtonPressed*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterMouseButtonReleasedCallback(std::function<bool(MouseButtonReleased*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterMouseButtonHeldCallback(std::function<bool(MouseButtonHeld*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterSceneLoadCallback(std::function<bool(SceneLoad*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterSceneStartCallback(std::function<bool(SceneStart*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterSceneStopCallback(std::function<bool(SceneStop*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterSceneUnloadCallback(std::function<bool(SceneUnload*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterEditorPlayCallback(std::function<bool(EditorPlay*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterEditorPauseCallback(std::function<bool(EditorPause*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+            inline void RegisterEditorStopCallback(std::function<bool(EditorStop*)> callback , const std::string& name) { RegisterCallback(callback , name); }
+
+            /// \note there is only ever one shutdown callback , registering replaces it
             void RegisterShutdownCallback(std::function<bool(ShutdownEvent*)> callback);
 
             void UnregisterCallback(const std::string& name , EventType type);
 
             void PollEvents();
-            void DispatchEvent(Event* event);
+
+            /// \note builds the event in its channel's ring and runs every callback for its type right away
+            template<typename T , typename... Args>
+            void Dispatch(Args&&... args) {
+                EventChannel<T>& channel = Channel<T>();
+                channel.Dispatch(channel.Emplace(std::forward<Args>(args)...));
+            }
+
+            template<typename T>
+            inline void DispatchEvent(const T& event) { Dispatch<T>(event); }
+
+            /// \note safe from any thread , the event is dispatched on the main thread the next time
+            ///     DispatchQueued runs. false when the queue is full and the event was dropped
+            template<typename T , typename... Args>
+            bool Post(Args&&... args) {
+                static_assert(sizeof(T) <= kMaxQueuedEventSize , "event too large to be posted");
+                static_assert(std::is_trivially_copyable_v<T> , "posted events are copied as raw bytes");
+
+                const T event(std::forward<Args>(args)...);
+                QueuedEvent queued;
+                queued.type = T::kType;
+                std::memcpy(queued.data , &event , sizeof(T));
+
+                if (!queued_events.Push(queued)) {
+                    dropped_events.fetch_add(1 , std::memory_order_relaxed);
+                    return false;
+                }
+                return true;
+            }
+
+            template<typename T>
+            inline bool PostEvent(const T& event) { return Post<T>(event); }
+
+            /// \note main thread only , runs the callbacks of everything posted before the call. events posted
+            ///     by those callbacks wait for the next call
+            void DispatchQueued();
+
+            /// \note posts refused because the queue was full since the last DispatchQueued
+            inline uint32_t NumDropped() const { return dropped_events.load(std::memory_order_relaxed); }
+
+            /// \note events of this type dispatched since the last flush , the ring only keeps the last kEventRingSize
+            template<typename T>
+            inline uint32_t NumDispatched() { return Channel<T>().Dispatched(); }
+
             void FlushEvents();
 
             void Cleanup();
@@ -106,4 +215,4 @@ namespace YE {
 
 }
 
-#endif // !YE_EVENT_MANAGER_HPP
\ No newline at end of file
+#endif // !YE_EVENT_MANAGER_HPP
@@ -2,7 +2,8 @@
 #define YE_EVENTS_HPP
 
 #include <string>
-#include <functional>
+#include <ostream>
+#include <type_traits>
 
 #include "core/defines.hpp"
 
@@ -32,53 +33,29 @@ namespace YE {
         SHUTDOWN_EVENT     = ybit(8)
     };
 
-#define EVENT_TYPE(type) virtual EventType Type() const { return EventType::##type; } \
-                         virtual std::string Name() const override { return std::string{ #type }; }
+// events are plain values , the type and category are compile time constants so dispatch never has to
+// ask an event what it is
+#define EVENT_TYPE(type) static constexpr EventType kType = EventType::type; \
+                         static constexpr const char* kName = #type; \
+                         inline EventType Type() const { return kType; } \
+                         inline std::string Name() const { return std::string{ kName }; }
 
-#define EVENT_CATEGORY(category) virtual uint32_t CategoryFlags() const override { return category; }
+#define EVENT_CATEGORY(category) static constexpr uint32_t kCategory = category; \
+                                 inline uint32_t CategoryFlags() const { return kCategory; } \
+                                 inline bool InCategory(EventCategory c) const { return kCategory & c; }
 
+    /// \note base of every event , events are copied by value into their channel's ring so they have to
+    ///     stay trivially destructible
     class Event {
         public:
             bool handled = false;
-
-            Event() {}
-            virtual ~Event() {}
-            virtual EventType Type() const = 0;
-            virtual std::string Name() const = 0;
-            virtual uint32_t CategoryFlags() const = 0;
-            virtual std::string ToString() const { return Name(); }
-
-            inline bool InCategory(EventCategory category) { return CategoryFlags() & category; }
     };
 
-    inline std::ostream& operator<<(std::ostream& os , const Event& e) {
+    template <typename T , typename = std::enable_if_t<std::is_base_of_v<Event , T>>>
+    inline std::ostream& operator<<(std::ostream& os , const T& e) {
         return os << e.Name();
     }
 
-    /**
-     * Might be able to eliminate this class
-    */
-    class EventHandler {
-        template<typename T>
-        using EventFunc = std::function<bool(T&)>; 
-
-        Event* event = nullptr;
-
-        public:
-            EventHandler(Event* event)
-                : event(event) {}
-
-            template<typename T>
-            bool Handle(EventFunc<T> func) {
-                if (event == nullptr) return false;
-                if (event->Type() == T::Type() && !event->handled) {
-                    event->handled = func(*(T*)event);
-                    return true;
-                }
-                return false;
-            }
-    };
-
     class ShutdownEvent : public Event {
         public:
             ShutdownEvent() {}
@@ -24,7 +24,7 @@ namespace YE {
             KeyPressed(Keyboard::Key key_code)
                 : KeyEvent(key_code) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "Key Pressed :: " << static_cast<uint16_t>(key_code);
                 return ss.str();
@@ -38,7 +38,7 @@ namespace YE {
             KeyReleased(Keyboard::Key key_code)
                 : KeyEvent(key_code) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "Key Released :: " << static_cast<uint16_t>(key_code);
                 return ss.str();
@@ -55,7 +55,7 @@ namespace YE {
             KeyHeld(Keyboard::Key key_code , Keyboard::KeyState state)
                 : KeyEvent(key_code) , state(state) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "Key Held [ " << state.frames_held << " frames] :: " << static_cast<uint16_t>(key_code);
                 return ss.str();
@@ -24,7 +24,7 @@ namespace YE {
             inline float PreviousX() const { return previous_position.x; }
             inline float PreviousY() const { return previous_position.y; }
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "MouseMoved :: [" << position.x << ", " << position.y << "]";
                 return ss.str();
@@ -44,7 +44,7 @@ namespace YE {
             inline float DX() const { return offset.x; }
             inline float DY() const { return offset.y; }
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "MouseScrolled :: [" << offset.x << ", " << offset.y << "]";
                 return ss.str();
@@ -72,7 +72,7 @@ namespace YE {
             MouseButtonPressed(Mouse::Button button)
                 : MouseButton(button) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "MouseButtonPressed :: [" << static_cast<uint8_t>(button) << "]";
                 return ss.str();
@@ -86,7 +86,7 @@ namespace YE {
             MouseButtonReleased(Mouse::Button button)
                 : MouseButton(button) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "MouseButtonReleased :: [" << static_cast<uint8_t>(button) << "]";
                 return ss.str();
@@ -100,7 +100,7 @@ namespace YE {
             MouseButtonHeld(Mouse::Button button)
                 : MouseButton(button) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "MouseButtonHeld :: [" << static_cast<uint8_t>(button) << "]";
                 return ss.str();
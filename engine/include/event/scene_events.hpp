@@ -24,7 +24,7 @@ namespace YE {
             SceneLoad(Scene* context)
                 : SceneEvent(context) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "SceneLoad :: [" << context->SceneName() << "]";
                 return ss.str();
@@ -38,7 +38,7 @@ namespace YE {
             SceneStart(Scene* context)
                 : SceneEvent(context) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "SceneInitialize :: [" << context->SceneName() << "]";
                 return ss.str();
@@ -52,7 +52,7 @@ namespace YE {
             SceneStop(Scene* context)
                 : SceneEvent(context) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "SceneStop :: [" << context->SceneName() << "]";
                 return ss.str();
@@ -66,7 +66,7 @@ namespace YE {
             SceneUnload(Scene* context)
                 : SceneEvent(context) {}
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "SceneUnload :: [" << context->SceneName() << "]";
                 return ss.str();
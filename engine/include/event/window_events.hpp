@@ -24,7 +24,7 @@ namespace YE {
             inline uint32_t OldWidth() const { return old_size.x; }
             inline uint32_t OldHeight() const { return old_size.y; }
 
-            virtual std::string ToString() const override {
+            std::string ToString() const {
                 std::stringstream ss;
                 ss << "WindowResized :: [" << old_size.x << ", " << old_size.y << "] -> [" << size.x << ", " << size.y << "]";
                 return ss.str();
@@ -0,0 +1,42 @@
+#ifndef YE_INPUT_HPP
+#define YE_INPUT_HPP
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "input/keyboard.hpp"
+#include "input/mouse.hpp"
+
+namespace YE {
+
+    /// \note everything the devices reported for one frame , small and trivially copyable
+    struct InputSnapshot {
+        Keyboard::KeyBits keys{};
+        uint32_t buttons = 0;
+        glm::ivec2 mouse_position = glm::ivec2(0 , 0);
+        bool mouse_in_window = false;
+    };
+
+    /// \note input is read once a frame into a snapshot and the keyboard , mouse and actions are all advanced
+    ///     from it , so anything that can produce a snapshot can drive them
+    class Input {
+
+        static InputSnapshot current;
+        static InputSnapshot previous;
+
+        public:
+
+            static void Capture(InputSnapshot& snapshot);
+            static void Apply(const InputSnapshot& snapshot);
+
+            /// \note capture then apply , once per frame after the SDL events are polled
+            static void Update();
+
+            inline static const InputSnapshot& Current() { return current; }
+            inline static const InputSnapshot& Previous() { return previous; }
+    };
+
+}
+
+#endif // !YE_INPUT_HPP
@@ -0,0 +1,72 @@
+#ifndef YE_INPUT_ACTIONS_HPP
+#define YE_INPUT_ACTIONS_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "input/keyboard.hpp"
+#include "input/mouse.hpp"
+
+namespace YE {
+
+    /// \note named actions bound to any number of keys and mouse buttons. bindings are bitsets in the same
+    ///     layout as the input snapshot , so resolving an action is a handful of ands and checking one is a
+    ///     single bit test
+    class InputActions {
+        public:
+            using ActionID = uint32_t;
+
+            static constexpr ActionID kInvalidAction = UINT32_MAX;
+            static constexpr uint32_t kMaxActions = 64;
+
+            struct ActionBinding {
+                Keyboard::KeyBits keys{};
+                uint32_t buttons = 0;
+            };
+
+        private:
+            static std::vector<ActionBinding> bindings;
+            static std::unordered_map<uint32_t , ActionID> ids;
+
+            // one bit per action , set while any of its bindings is down
+            static uint64_t current_down;
+            static uint64_t previous_down;
+
+            inline static bool Valid(ActionID action) { return action < bindings.size(); }
+
+        public:
+
+            /// \note returns the existing id when the name is already registered
+            static ActionID Register(const std::string& name);
+            static ActionID Find(const std::string& name);
+
+            static void BindKey(ActionID action , Keyboard::Key key);
+            static void BindButton(ActionID action , Mouse::Button button);
+            static void Unbind(ActionID action);
+
+            static void Clear();
+
+            /// \note resolves every action against the snapshot
+            static void Update(const Keyboard::KeyBits& keys , uint32_t buttons);
+
+            inline static bool Down(ActionID action) { return action < kMaxActions && (current_down & (1ull << action)); }
+            inline static bool Pressed(ActionID action) { 
+                return action < kMaxActions && ((current_down & ~previous_down) & (1ull << action)); 
+            }
+            inline static bool Released(ActionID action) { 
+                return action < kMaxActions && ((previous_down & ~current_down) & (1ull << action)); 
+            }
+
+            inline static bool Down(const std::string& name) { return Down(Find(name)); }
+            inline static bool Pressed(const std::string& name) { return Pressed(Find(name)); }
+            inline static bool Released(const std::string& name) { return Released(Find(name)); }
+
+            inline static uint64_t Current() { return current_down; }
+            inline static uint64_t Previous() { return previous_down; }
+    };
+
+}
+
+#endif // !YE_INPUT_ACTIONS_HPP
@@ -0,0 +1,98 @@
+#ifndef YE_INPUT_RECORDER_HPP
+#define YE_INPUT_RECORDER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "core/timer.hpp"
+#include "input/input.hpp"
+
+namespace YE {
+
+    static constexpr uint32_t kInputRecordingMagic = 0x4E495059; // "YPIN"
+    static constexpr uint32_t kInputRecordingVersion = 1;
+    static constexpr const char* kInputRecordingExtension = ".yinput";
+
+    /// \note the frames follow the header. each one is its time step , a flag byte , a byte with one bit per
+    ///     key word that changed since the frame before , the button mask and cursor , then only the changed
+    ///     key words , so a frame where no key changed costs 18 bytes
+    struct InputRecordingHeader {
+        uint32_t magic = kInputRecordingMagic;
+        uint32_t version = kInputRecordingVersion;
+        uint32_t frame_count = 0;
+        float time_step = 0.0f;
+    };
+
+    /// \note records the input snapshot and time step of every frame , or feeds a recording back in place of
+    ///     the devices. a replay reproduces the session frame for frame , as long as nothing else the app
+    ///     depends on (random seeds , gui input , wall clock time) changes between runs
+    class InputRecorder {
+
+        static InputRecorder* singleton;
+
+        enum class Mode : uint8_t {
+            NONE ,
+            RECORDING ,
+            REPLAYING
+        };
+
+        Mode mode = Mode::NONE;
+        std::string path;
+
+        std::vector<uint8_t> data;
+        size_t cursor = 0;
+
+        uint32_t frame_count = 0;
+        uint32_t frame = 0;
+        float time_step = 0.0f;
+
+        // keys are stored as a diff against the frame before
+        Keyboard::KeyBits last_keys{};
+
+        // how long each replayed frame took , reported when the replay ends
+        std::vector<float> frame_times;
+        time::TimePoint frame_start;
+
+        void ReportFrameTimes();
+
+        InputRecorder() {}
+        ~InputRecorder() {}
+
+        InputRecorder(InputRecorder&&) = delete;
+        InputRecorder(const InputRecorder&) = delete;
+        InputRecorder& operator=(InputRecorder&&) = delete;
+        InputRecorder& operator=(const InputRecorder&) = delete;
+
+        public:
+
+            static InputRecorder* Instance();
+
+            /// \note nothing touches the disk until the recording stops
+            bool StartRecording(const std::string& path , float time_step);
+            bool StopRecording();
+
+            void Record(const InputSnapshot& snapshot , float dt);
+
+            bool StartReplay(const std::string& path);
+            void StopReplay();
+
+            /// \note the next recorded frame , false once the recording has run out (the replay stops then)
+            bool Next(InputSnapshot& snapshot , float& dt);
+
+            /// \note call once at the end of every replayed frame
+            void MeasureFrame();
+
+            /// \note stops a recording in progress , so it still reaches the disk
+            void Cleanup();
+
+            inline bool Recording() const { return mode == Mode::RECORDING; }
+            inline bool Replaying() const { return mode == Mode::REPLAYING; }
+            inline uint32_t Frame() const { return frame; }
+            inline uint32_t FrameCount() const { return frame_count; }
+            inline float TimeStep() const { return time_step; }
+    };
+
+}
+
+#endif // !YE_INPUT_RECORDER_HPP
@@ -1,16 +1,22 @@
 #ifndef YE_KEYBOARD_HPP
 #define YE_KEYBOARD_HPP
 
-#include <map>
+#include <array>
+#include <cstdint>
 #include <sstream>
 
 namespace YE {
 
     class Keyboard {
 
-        const static uint16_t kKeyCount = 287;
-
         public:
+            // one slot per SDL scancode , key codes index straight into the state arrays
+            static constexpr uint16_t kKeyCount = 512;
+            static constexpr uint32_t kKeyWords = kKeyCount / 64;
+
+            // one bit per key , set while the key is down
+            using KeyBits = std::array<uint64_t , kKeyWords>;
+
             enum class Key : uint16_t;
 
             enum class State : uint8_t {
@@ -27,24 +33,47 @@ namespace YE {
             };
 
             static void Initialize();
-            static void Update();
 
-            inline static KeyState GetKeyState(Key key) { return keys[key]; }
+            /// \note packs SDL's keyboard state into a bitset
+            static void Capture(KeyBits& down);
 
-            inline static bool Pressed(Key key) { return keys[key].current_state == State::PRESSED; }
-            inline static bool Blocked(Key key) { return keys[key].current_state == State::BLOCKED; }
-            inline static bool Held(Key key) { return keys[key].current_state == State::HELD; }
-            inline static bool KeyDown(Key key) { 
-                return keys[key].current_state == State::PRESSED  || 
-                       keys[key].current_state == State::BLOCKED ||
-                       keys[key].current_state == State::HELD; 
-            }
-            inline static bool Released(Key key) { return keys[key].current_state == State::RELEASED; }
+            /// \note advances every key to the given snapshot , only keys that are down or were down last
+            ///     frame are visited and events only go out when a key changes state
+            static void Apply(const KeyBits& down);
+
+            inline static bool Valid(uint32_t key) { return key < kKeyCount; }
+
+            inline static KeyState GetKeyState(Key key) { return keys[Index(key)]; }
+
+            inline static bool Pressed(Key key) { return keys[Index(key)].current_state == State::PRESSED; }
+            inline static bool Blocked(Key key) { return keys[Index(key)].current_state == State::BLOCKED; }
+            inline static bool Held(Key key) { return keys[Index(key)].current_state == State::HELD; }
+            inline static bool KeyDown(Key key) { return keys[Index(key)].current_state != State::RELEASED; }
+            inline static bool Released(Key key) { return keys[Index(key)].current_state == State::RELEASED; }
+
+            // edges of the last Apply , straight from the snapshot diff
+            inline static bool JustPressed(Key key) { return Test(pressed_edges , Index(key)); }
+            inline static bool JustReleased(Key key) { return Test(released_edges , Index(key)); }
+
+            inline static const KeyBits& Current() { return current_down; }
+            inline static const KeyBits& Previous() { return previous_down; }
+
+            inline static bool Test(const KeyBits& bits , uint32_t key) { return (bits[key / 64] >> (key % 64)) & 1; }
 
         private:
-            
-            // const uint8_t* state = nullptr;
-            static std::map<Key , KeyState> keys;
+
+            static std::array<KeyState , kKeyCount> keys;
+
+            static KeyBits current_down;
+            static KeyBits previous_down;
+            static KeyBits pressed_edges;
+            static KeyBits released_edges;
+
+            // out of range codes land on the unknown key instead of reading past the arrays
+            inline static uint32_t Index(Key key) { 
+                uint32_t index = static_cast<uint32_t>(key);
+                return index < kKeyCount ? index : 0;
+            }
 
         public:
 
@@ -328,4 +357,4 @@ namespace YE {
 
 }
 
-#endif // !YE_YEBOARD_HPP
\ No newline at end of file
+#endif // !YE_KEYBOARD_HPP
\ No newline at end of file
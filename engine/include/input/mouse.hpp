@@ -1,7 +1,8 @@
 #ifndef YE_MOUSE_HPP
 #define YE_MOUSE_HPP
 
-#include <map>
+#include <array>
+#include <cstdint>
 #include <sstream>
 
 #include <glm/glm.hpp>
@@ -42,22 +43,40 @@ namespace YE {
                 uint32_t frames_held = 0;
             };
 
-        private:
-
             constexpr static const uint32_t kButtonCount = 5;
 
+        private:
+
             static MouseState state;
-            static std::map<Button , ButtonState> buttons;
+            static std::array<ButtonState , kButtonCount> buttons;
+
+            // one bit per button , set while it is down
+            static uint32_t current_buttons;
+            static uint32_t previous_buttons;
+
+            inline static uint32_t Index(Button button) { 
+                uint32_t index = static_cast<uint32_t>(button);
+                return index < kButtonCount ? index : 0;
+            }
 
         public:
 
             static void Initialize();
-            static void Update();
+
+            /// \note reads the cursor and packs the buttons that are down into a mask
+            static void Capture(glm::ivec2& position , uint32_t& down , bool& in_window);
+
+            /// \note advances the cursor and every button to the given snapshot , events only go out when a
+            ///     button changes state
+            static void Apply(const glm::ivec2& position , uint32_t down , bool in_window);
+
             static void SnapToCenter();
             static void FreeCursor();
             static void HideCursor();
 
-            inline static ButtonState GetButtonState(Button button) { return buttons[button]; }
+            inline static bool Valid(uint32_t button) { return button < kButtonCount; }
+
+            inline static ButtonState GetButtonState(Button button) { return buttons[Index(button)]; }
 
             inline static uint32_t X() { return state.position.x; }
             inline static uint32_t Y() { return state.position.y; }
@@ -71,11 +90,17 @@ namespace YE {
             inline static bool InWindow() { return state.in_window; }
 
 
-            inline static uint32_t FramesHeld(Button button) { return buttons[button].frames_held; }
-            inline static bool Pressed(Button button) { return buttons[button].current_state == State::PRESSED; }
-            inline static bool Blocked(Button button) { return buttons[button].current_state == State::BLOCKED; }
-            inline static bool Held(Button button) { return buttons[button].current_state == State::HELD; }
-            inline static bool Released(Button button) { return buttons[button].current_state == State::RELEASED; }
+            inline static uint32_t FramesHeld(Button button) { return buttons[Index(button)].frames_held; }
+            inline static bool Pressed(Button button) { return buttons[Index(button)].current_state == State::PRESSED; }
+            inline static bool Blocked(Button button) { return buttons[Index(button)].current_state == State::BLOCKED; }
+            inline static bool Held(Button button) { return buttons[Index(button)].current_state == State::HELD; }
+            inline static bool Released(Button button) { return buttons[Index(button)].current_state == State::RELEASED; }
+
+            inline static bool JustPressed(Button button) { return (current_buttons & ~previous_buttons) & (1u << Index(button)); }
+            inline static bool JustReleased(Button button) { return (previous_buttons & ~current_buttons) & (1u << Index(button)); }
+
+            inline static uint32_t Current() { return current_buttons; }
+            inline static uint32_t Previous() { return previous_buttons; }
     };
 
 }
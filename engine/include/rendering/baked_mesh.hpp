@@ -0,0 +1,153 @@
+#ifndef YE_BAKED_MESH_HPP
+#define YE_BAKED_MESH_HPP
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "rendering/bounds.hpp"
+#include "rendering/vertex_format.hpp"
+
+namespace YE {
+
+    class MappedFile;
+
+    static constexpr uint32_t kBakedMeshMagic = 0x48534d59; // "YMSH"
+    static constexpr uint32_t kBakedMeshVersion = 3;
+    static constexpr uint32_t kBakedMeshAlignment = 16;
+    static constexpr const char* kBakedMeshExtension = ".ymesh";
+    static constexpr uint32_t kMaxMeshLods = 4;
+
+    /// \note every section offset is from the start of the file and aligned to kBakedMeshAlignment so the
+    ///     sections can be handed to GL straight out of the mapping
+    struct BakedMeshHeader {
+        uint32_t magic = kBakedMeshMagic;
+        uint32_t version = kBakedMeshVersion;
+
+        // size and write time of the source file , a mismatch means the source changed and the bake is stale
+        uint64_t source_size = 0;
+        int64_t source_time = 0;
+
+        // the vertex block is already packed with this format and is uploaded as is
+        uint32_t vertex_stride = 0;
+        std::array<AttributeType , kNumVertexAttributes> attribute_types{};
+        uint8_t attribute_padding = 0;
+
+        uint32_t num_vertices = 0;
+        uint32_t num_indices = 0;
+        uint32_t num_faces = 0;
+        uint32_t num_submeshes = 0;
+        uint32_t num_textures = 0;
+        uint32_t string_bytes = 0;
+        uint32_t num_lods = 1;
+
+        // settings the lods were generated with , a model asking for different ones rebuilds the bake
+        std::array<float , kMaxMeshLods> lod_ratios{};
+        float lod_max_error = 0.f;
+        uint32_t lod_padding = 0;
+
+        uint64_t vertex_offset = 0;
+        uint64_t index_offset = 0;
+        uint64_t submesh_offset = 0;
+        uint64_t lod_offset = 0;
+        uint64_t texture_offset = 0;
+        uint64_t string_offset = 0;
+
+        glm::vec3 bounds_min{ 0.f };
+        glm::vec3 bounds_max{ 0.f };
+        glm::vec3 diffuse{ 1.f };
+        glm::vec3 ambient{ 1.f };
+        float shininess = 0.f;
+    };
+
+    /// \note indices are local to the submesh , first_vertex is only where its vertices start in the file.
+    ///     the index span holds every lod of the submesh back to back
+    struct BakedSubmesh {
+        uint32_t first_vertex = 0;
+        uint32_t num_vertices = 0;
+        uint32_t first_index = 0;
+        uint32_t num_indices = 0;
+        glm::vec3 bounds_min{ 0.f };
+        glm::vec3 bounds_max{ 0.f };
+    };
+
+    /// \note one per lod per submesh , the range is relative to the submesh's first index. a level the
+    ///     simplifier could not reduce any further points at the range of the level before it
+    struct BakedLod {
+        uint32_t first_index = 0;
+        uint32_t num_indices = 0;
+    };
+
+    struct BakedTextureRef {
+        uint32_t type = 0;
+        uint32_t path_offset = 0;
+        uint32_t path_length = 0;
+        uint32_t padding = 0;
+    };
+
+    /// \note everything the baker needs , gathered while the source is imported
+    struct BakedMeshSource {
+        const uint8_t* vertices = nullptr;
+        uint32_t num_vertices = 0;
+        VertexFormat format;
+        const std::vector<uint32_t>* indices = nullptr;
+        std::vector<BakedSubmesh> submeshes;
+        // num_lods per submesh
+        std::vector<BakedLod> lods;
+        uint32_t num_lods = 1;
+        std::array<float , kMaxMeshLods> lod_ratios{};
+        float lod_max_error = 0.f;
+        // texture paths are relative to the model directory
+        std::vector<std::pair<uint32_t , std::string>> textures;
+
+        uint32_t num_faces = 0;
+        AABB bounds;
+        glm::vec3 diffuse{ 1.f };
+        glm::vec3 ambient{ 1.f };
+        float shininess = 0.f;
+    };
+
+    /// \note read only view over a mapped bake , pointers are valid as long as the mapping is open
+    struct BakedMeshView {
+        const BakedMeshHeader* header = nullptr;
+        const uint8_t* vertices = nullptr;
+        const uint32_t* indices = nullptr;
+        const BakedSubmesh* submeshes = nullptr;
+        const BakedLod* lods = nullptr;
+        const BakedTextureRef* textures = nullptr;
+        const char* strings = nullptr;
+
+        inline const BakedLod& Lod(uint32_t submesh , uint32_t lod) const { return lods[submesh * header->num_lods + lod]; }
+
+        inline VertexFormat Format() const { return VertexFormat(header->attribute_types); }
+
+        inline const uint8_t* SubmeshVertices(uint32_t i) const {
+            return vertices + static_cast<size_t>(header->vertex_stride) * submeshes[i].first_vertex;
+        }
+
+        inline std::string TexturePath(uint32_t i) const {
+            return std::string(strings + textures[i].path_offset , textures[i].path_length);
+        }
+    };
+
+namespace BakedMesh {
+
+    inline std::string BakedPath(const std::string& source_path) { return source_path + kBakedMeshExtension; }
+
+    /// \note fills size and time of the source file , returns false if it does not exist
+    bool SourceStamp(const std::string& source_path , uint64_t& size , int64_t& time);
+
+    /// \note writes to a temporary file first and renames it over the old bake so a half written
+    ///     file is never picked up by the loader
+    bool Write(const std::string& baked_path , const std::string& source_path , const BakedMeshSource& source);
+
+    /// \note checks the header , version , stamp and that every section fits inside the file , on
+    ///     success the view points into the mapping
+    bool Read(const MappedFile& file , const std::string& source_path , BakedMeshView& view);
+
+}
+
+}
+
+#endif // !YE_BAKED_MESH_HPP
@@ -0,0 +1,111 @@
+#ifndef YE_BOUNDS_HPP
+#define YE_BOUNDS_HPP
+
+#include <array>
+#include <limits>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace YE {
+
+    struct Vertex;
+
+    struct AABB {
+        glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+        AABB() {}
+        AABB(const glm::vec3& min , const glm::vec3& max)
+            : min(min) , max(max) {}
+
+        // an AABB that has not seen a point yet is inverted so the first Expand sets it
+        inline bool Valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+        inline glm::vec3 Center() const { return (min + max) * 0.5f; }
+        inline glm::vec3 Extents() const { return (max - min) * 0.5f; }
+
+        inline void Expand(const glm::vec3& point) {
+            min = glm::min(min , point);
+            max = glm::max(max , point);
+        }
+
+        inline void Merge(const AABB& other) {
+            if (!other.Valid()) return;
+            min = glm::min(min , other.min);
+            max = glm::max(max , other.max);
+        }
+
+        inline bool Contains(const AABB& other) const {
+            return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+                   max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+        }
+
+        inline bool Intersects(const AABB& other) const {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                   min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        inline float SurfaceArea() const {
+            glm::vec3 d = max - min;
+            return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+
+        inline static AABB Union(const AABB& lhs , const AABB& rhs) {
+            return AABB(glm::min(lhs.min , rhs.min) , glm::max(lhs.max , rhs.max));
+        }
+
+        /// \note box around this one after transforming it , the transformed extents are projected onto
+        ///     the world axes so it costs one matrix multiply instead of eight corner transforms
+        AABB Transform(const glm::mat4& transform) const;
+    };
+
+    struct BoundingSphere {
+        glm::vec3 center = glm::vec3(0.f);
+        float radius = 0.f;
+    };
+
+    /// \note fraction of the screen height the sphere covers seen from eye through a perspective projection
+    ///     with the given tan(fov / 2) , an eye inside the sphere sees it filling the screen
+    inline float ProjectedSize(const BoundingSphere& sphere , const glm::vec3& eye , float tan_half_fov) {
+        const float distance = glm::length(sphere.center - eye);
+        if (distance <= sphere.radius) return std::numeric_limits<float>::max();
+        return sphere.radius / (distance * tan_half_fov);
+    }
+
+    /// \note six normalized planes (left , right , bottom , top , near , far) pointing into the frustum ,
+    ///     stored a second time transposed so the SIMD test reads four planes with one load per axis
+    struct Frustum {
+        std::array<glm::vec4 , 6> planes;
+
+        alignas(16) float px[8];
+        alignas(16) float py[8];
+        alignas(16) float pz[8];
+        alignas(16) float pw[8];
+
+        Frustum() {}
+        Frustum(const glm::mat4& view_projection);
+
+        bool Intersects(const AABB& aabb) const;
+        bool Intersects(const BoundingSphere& sphere) const;
+
+        /// \note writes 1 to visible[i] for every box touching the frustum and 0 for the rest ,
+        ///     returns the number of visible boxes
+        uint32_t Cull(const AABB* boxes , uint32_t count , uint8_t* visible) const;
+    };
+
+    AABB CalculateBounds(const Vertex* vertices , uint32_t count);
+    // stride and position_size are counted in floats , flat layouts keep the position in the first attribute
+    AABB CalculateBounds(const float* vertices , uint32_t count , uint32_t stride , uint32_t position_size);
+    BoundingSphere CalculateSphere(const AABB& aabb);
+
+    bool Intersects(const BoundingSphere& sphere , const AABB& aabb);
+
+    /// \note slab test , inv_direction is 1 / direction per axis (infinite where the direction is 0). on a hit
+    ///     distance is where the ray enters the box (0 when it starts inside)
+    bool RayIntersects(const glm::vec3& origin , const glm::vec3& inv_direction , float max_distance , 
+                       const AABB& aabb , float& distance);
+
+}
+
+#endif // !YE_BOUNDS_HPP
@@ -46,6 +46,9 @@ namespace YE {
 
         bool is_primary = false;
 
+        // a snapshot keeps the matrices it was copied with , it never looks at the window again
+        bool snapshot = false;
+
         std::function<void(Camera* camera , float dt)> mouse_callback = nullptr;
         std::function<void(Camera* camera , float dt)> keyboard_callback = nullptr;
 
@@ -67,6 +70,10 @@ namespace YE {
 
             void Recalculate();
 
+            /// \note copies what draws read (matrices , position and clip planes) so a frame can execute
+            ///     with the camera as it was when the frame was recorded , callbacks are not copied
+            void CopyFrameState(Camera& other);
+
             void Rotate(const glm::vec3& rotation);
 
             void Update(float dt);
@@ -15,14 +15,20 @@ namespace YE {
             Gui() {}
             ~Gui() {}
 
-            void Initialize(Window* window);
+            /// \note platform windows render through their own contexts , they are left off when frames
+            ///     execute on the render thread
+            void Initialize(Window* window , bool platform_windows = true);
             void Update();
             
             void BeginRender(SDL_Window* window);
 
             void Render(Window* window);
 
-            void EndRender(SDL_Window* window , void* gl_context);
+            /// \note finishes the frame's draw data , needs the context only when platform windows are on
+            void EndRender();
+
+            /// \note draws the data built by the last EndRender , runs wherever the frame executes
+            void Draw(SDL_Window* window , void* gl_context);
             void Shutdown();
     };
 
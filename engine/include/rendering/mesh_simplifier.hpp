@@ -0,0 +1,25 @@
+#ifndef YE_MESH_SIMPLIFIER_HPP
+#define YE_MESH_SIMPLIFIER_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include "rendering/vertex.hpp"
+
+namespace YE {
+
+namespace MeshSimplifier {
+
+    /// \note quadric error edge collapse over a triangle list , every collapse moves one vertex onto a
+    ///     neighbour so the result indexes the same vertices and can share their buffer. vertices on open
+    ///     borders or uv/normal seams (several vertices at one position) are never moved so the outline and
+    ///     texture layout survive. stops at target_indices or when the next collapse would move the surface
+    ///     further than max_error , returns the number of indices written to result
+    uint32_t Simplify(const Vertex* vertices , uint32_t num_vertices , const uint32_t* indices , uint32_t num_indices , 
+                      uint32_t target_indices , float max_error , std::vector<uint32_t>& result);
+
+}
+
+}
+
+#endif // !YE_MESH_SIMPLIFIER_HPP
@@ -1,11 +1,15 @@
 #ifndef YE_MODEL_HPP
 #define YE_MODEL_HPP
 
+#include <array>
 #include <string>
 
 #include <glm/glm.hpp>
 #include <assimp/scene.h>
 
+#include "core/resource_handle.hpp"
+#include "rendering/baked_mesh.hpp"
+#include "rendering/bounds.hpp"
 #include "rendering/vertex_array.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/texture.hpp"
@@ -13,12 +17,36 @@
 namespace YE {
 
     class Model;
+    class MappedFile;
+
+    struct ModelMemory {
+        uint32_t vertex_bytes = 0;
+        uint32_t index_bytes = 0;
+        // what the vertices would take as plain Vertex structs
+        uint32_t full_vertex_bytes = 0;
+    };
+
+    /// \note triangle ratio of each lod against the full mesh and the projected size (the fraction of the
+    ///     screen height its bounding sphere covers) below which the lod is drawn , level 0 is the full
+    ///     mesh. hysteresis widens every switch point so a model resting on one does not flicker
+    struct LodSettings {
+        std::array<float , kMaxMeshLods> ratios{ 1.f , 0.5f , 0.25f , 0.1f };
+        std::array<float , kMaxMeshLods> screen_sizes{ 1.f , 0.4f , 0.18f , 0.07f };
+        uint32_t num_lods = kMaxMeshLods;
+        // how far the simplified surface may move , as a fraction of the model's bounds diagonal
+        float max_error = 0.02f;
+        float hysteresis = 0.1f;
+    };
 
     struct ModelResource {
         std::string name;
         std::string filename;
         std::string path;
         Model* model = nullptr;
+        ModelHandle handle;
+
+        // a hot reload is in flight , further changes wait for it to land
+        bool reloading = false;
 
         ModelResource() {}
     };
@@ -35,6 +63,29 @@ namespace YE {
         std::vector<VertexArray*> vaos;
         std::vector<Texture*> textures;
 
+        // filled while importing with assimp so the result can be baked
+        std::vector<BakedSubmesh> submeshes;
+        std::vector<std::pair<uint32_t , std::string>> texture_refs;
+
+        // smallest format that fits every vertex of the model , shared by all of its vertex arrays
+        VertexFormat format;
+        std::vector<uint8_t> packed;
+        ModelMemory memory;
+
+        // num_lods ranges per vertex array , lod_indices holds every level of every submesh until upload
+        LodSettings lod_settings;
+        std::vector<BakedLod> lods;
+        std::vector<uint32_t> lod_indices;
+        uint32_t num_lods = 1;
+
+        // kept open for the lifetime of the model when it was loaded from a bake , the vertex arrays
+        // upload straight out of it and collision data is read from it on demand
+        MappedFile* mapping = nullptr;
+        BakedMeshView baked;
+
+        AABB bounds;
+        BoundingSphere sphere;
+
         glm::vec3 diffuse = glm::vec3(1.0f);
         glm::vec3 specular = glm::vec3(1.0f);
         glm::vec3 ambient = glm::vec3(1.0f);
@@ -43,6 +94,7 @@ namespace YE {
         float shininess = 0.0f;
         float metallic = 0.0f;
 
+        bool imported = false;
         bool valid = false;
         bool textured = false;
         
@@ -52,15 +104,39 @@ namespace YE {
 
         void ProcessNode(aiNode* mesh , const aiScene* scene);
         void ProcessMesh(aiMesh* mesh , const aiScene* scene); 
+        void ProcessTextures(aiMaterial* material , aiTextureType ai_type , TextureType type);
+
+        void BuildLods();
+        void PackVertices();
+        void CalculateMemory();
+
+        bool LoadBaked();
+        void Bake();
+        void LoadCollisionData();
 
         public:
             Model(const std::string& name , const std::string& path) 
                 : name(name) , path(path) {}
-            ~Model() {}
+            ~Model();
 
             void Load();
 
-            void Draw(Shader* shader , DrawMode mode = DrawMode::TRIANGLES);
+            /// \note reads the file with assimp , builds the vertex data and decodes textures without
+            ///     touching GL , safe to call from a worker thread. returns false if the file failed to import.
+            ///     a baked copy next to the source is mapped instead of running assimp when it is up to date ,
+            ///     otherwise one is written after the import
+            bool Import();
+            /// \note uploads everything Import prepared , the model draws nothing until this has run
+            void Upload();
+
+            void Draw(Shader* shader , DrawMode mode = DrawMode::TRIANGLES , uint32_t lod = 0);
+
+            /// \note lods are generated on import , change the settings before the model is loaded
+            void SetLodSettings(const LodSettings& settings);
+
+            /// \note level to draw at a projected size given the level drawn last frame , a level only changes
+            ///     once the size is past its switch point by the hysteresis margin
+            uint32_t SelectLod(float screen_size , uint32_t current) const;
 
             void Cleanup();
 
@@ -79,17 +155,28 @@ namespace YE {
             inline void SetMetallic(float metallic) { this->metallic = metallic; }
 
             inline bool Valid() const { return valid; }
+
+            // union of the bounds of every mesh in the model
+            inline const AABB& Bounds() const { return bounds; }
+            inline const BoundingSphere& Sphere() const { return sphere; }
             
             inline const std::string& Name() const { return name; }
             inline const std::string& Path() const { return path; }
 
             inline const uint32_t NumVertices() const { return num_vertices; }
             inline const uint32_t NumFaces() const { return num_faces; }
-            inline const std::vector<Vertex>& YVertices() const { return yvertices; }
-            inline const std::vector<float>& Vertices() const { return vertices; }
-            inline const std::vector<uint32_t>& Indices() const { return indices; }
+            inline bool Baked() const { return mapping != nullptr; }
+            inline const VertexFormat& Format() const { return format; }
+            inline const ModelMemory& Memory() const { return memory; }
+            inline const LodSettings& Lods() const { return lod_settings; }
+            inline uint32_t NumLods() const { return num_lods; }
+
+            /// \note copied out of the bake the first time they are asked for when the model was baked
+            const std::vector<Vertex>& YVertices();
+            const std::vector<float>& Vertices();
+            const std::vector<uint32_t>& Indices();
             inline const std::vector<VertexArray*>& VertexArrays() const { return vaos; }
-            inline const std::vector<Texture*> Textures() const { return textures; }
+            inline const std::vector<Texture*>& Textures() const { return textures; }
     };
     
 }
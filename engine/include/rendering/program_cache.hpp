@@ -0,0 +1,51 @@
+#ifndef YE_PROGRAM_CACHE_HPP
+#define YE_PROGRAM_CACHE_HPP
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace YE {
+
+    static constexpr uint32_t kProgramCacheMagic = 0x47525059; // "YPRG"
+    static constexpr uint32_t kProgramCacheVersion = 1;
+    static constexpr const char* kProgramCacheExtension = ".yprog";
+    static constexpr const char* kProgramCacheDir = "shader_cache";
+
+    /// \note the binary itself follows the header , its format is whatever the driver reported for it
+    struct ProgramCacheHeader {
+        uint32_t magic = kProgramCacheMagic;
+        uint32_t version = kProgramCacheVersion;
+
+        // hash of every stage's source and the driver's vendor , renderer and version strings
+        uint64_t key = 0;
+
+        uint32_t binary_format = 0;
+        uint32_t binary_size = 0;
+    };
+
+namespace ProgramCache {
+
+    /// \note false when the driver reports no binary formats , nothing is read or written then
+    bool Supported();
+
+    /// \note one file per set of stage paths under the project's bin directory , a changed source
+    ///     overwrites the old binary instead of leaving it behind
+    std::string CachePath(const std::string& vertex_path , const std::string& fragment_path , const std::string& geometry_path);
+
+    /// \note needs a current GL context for the driver strings
+    uint64_t Key(std::string_view vertex_src , std::string_view fragment_src , std::string_view geometry_src);
+
+    /// \note loads the binary into the program and checks the link status , false on any mismatch or
+    ///     when the driver refuses the binary , the program has to be linked from source then
+    bool Load(const std::string& cache_path , uint64_t key , uint32_t program);
+
+    /// \note the program has to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set , writes to a
+    ///     temporary file first and renames it over the old binary
+    bool Store(const std::string& cache_path , uint64_t key , uint32_t program);
+
+}
+
+}
+
+#endif // !YE_PROGRAM_CACHE_HPP
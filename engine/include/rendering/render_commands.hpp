@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 #include <utility>
+#include <cstdint>
+#include <type_traits>
 
 #include <glm/glm.hpp>
 
@@ -24,11 +26,109 @@ namespace components {
 
 }
 
+    /// \note sort keys are laid out most significant field first so that sorting the queue by key groups
+    ///     draws by the state that is most expensive to switch
+    ///         [ pass : 4 | shader program : 16 | texture set : 16 | vertex array : 16 | depth : 12 ]
+    namespace SortKey {
+
+        constexpr uint32_t kPassBits = 4;
+        constexpr uint32_t kProgramBits = 16;
+        constexpr uint32_t kTextureBits = 16;
+        constexpr uint32_t kVertexArrayBits = 16;
+        constexpr uint32_t kDepthBits = 12;
+
+        constexpr uint32_t kDepthShift = 0;
+        constexpr uint32_t kVertexArrayShift = kDepthShift + kDepthBits;
+        constexpr uint32_t kTextureShift = kVertexArrayShift + kVertexArrayBits;
+        constexpr uint32_t kProgramShift = kTextureShift + kTextureBits;
+        constexpr uint32_t kPassShift = kProgramShift + kProgramBits;
+
+        static_assert(kPassShift + kPassBits == 64 , "Sort key fields must fill 64 bits");
+
+        constexpr uint64_t Field(uint64_t value , uint32_t bits , uint32_t shift) {
+            return (value & ((1ull << bits) - 1)) << shift;
+        }
+
+        constexpr uint64_t Build(uint32_t pass , uint32_t program , uint32_t texture_set , uint32_t vertex_array , uint32_t depth) {
+            return Field(pass , kPassBits , kPassShift) | 
+                   Field(program , kProgramBits , kProgramShift) |
+                   Field(texture_set , kTextureBits , kTextureShift) | 
+                   Field(vertex_array , kVertexArrayBits , kVertexArrayShift) |
+                   Field(depth , kDepthBits , kDepthShift);
+        }
+
+        // folds the ids of every bound texture into one field , 0 means the draw samples nothing
+        uint32_t TextureSet(const std::vector<Texture*>& textures);
+
+        // distance from the camera to the draw's origin mapped onto [0 , far clip] so near draws sort first
+        uint32_t Depth(Camera* camera , const glm::mat4& model);
+
+    }
+
+    enum class DrawCommandType : uint8_t {
+        VERTEX_ARRAY = 0 ,
+        MODEL = 1
+    };
+
+    /// \note plain draw record submitted in place of a heap allocated RenderCommand , the renderer copies it
+    ///     into its frame arena so it only lives until the frame it was submitted in has been executed
+    struct DrawCommand {
+        DrawCommandType type = DrawCommandType::VERTEX_ARRAY;
+        DrawMode mode = DrawMode::TRIANGLES;
+        bool has_light_color = false;
+        bool has_material = false;
+
+        uint32_t num_textures = 0;
+        Texture* const* textures = nullptr;
+
+        // level of detail a model is drawn at
+        uint32_t lod = 0;
+
+        Shader* shader = nullptr;
+        VertexArray* vao = nullptr;
+        Model* model = nullptr;
+
+        glm::mat4 transform = glm::mat4(1.f);
+        glm::vec3 light_color = glm::vec3(1.f);
+
+        // the material's shininess , set when the draw is executed instead of every update
+        float shininess = 0.f;
+    };
+
+    static_assert(std::is_trivially_copyable_v<DrawCommand> && std::is_trivially_destructible_v<DrawCommand> ,
+                  "DrawCommand has to stay a plain record so it can live in the frame arena");
+
+    /// \note one entry of an instance buffer , matches kInstanceLayout
+    struct InstanceData {
+        glm::mat4 transform = glm::mat4(1.f);
+        glm::vec4 layers = glm::vec4(0.f);
+    };
+
+    static_assert(sizeof(InstanceData) == 20 * sizeof(float) , "InstanceData has to match kInstanceLayout");
+    static_assert(kTextureArrayUniforms.size() == kMaxArrayTextures , "Every array texture slot needs a sampler name");
+
+    uint64_t DrawCommandKey(const DrawCommand& cmnd , Camera* camera , uint32_t pass);
+    void ExecuteDrawCommand(const DrawCommand& cmnd , Camera* camera);
+
+    /// \note true when every texture of the draw sits in an array and its shader can sample them that way ,
+    ///     draws that only differ by layer then share their binds and can be instanced together
+    bool UsesTextureArrays(const DrawCommand& cmnd);
+    glm::vec4 TextureLayers(const DrawCommand& cmnd);
+
+    // true when both records only differ by transform (or by array layer) and their shader reads the per
+    // instance attributes
+    bool CanInstance(const DrawCommand& lhs , const DrawCommand& rhs);
+
+    /// \note draws count copies of cmnd in one call , instances holds the model matrix and layers of each
+    void ExecuteInstancedDrawCommand(const DrawCommand& cmnd , const InstanceData* instances , uint32_t count , Camera* camera);
+
     class RenderCommand {
-        protected:
-            void SetCameraUniforms(Shader* shader , Camera* camera);
         public:
+            static void SetCameraUniforms(Shader* shader , Camera* camera);
+
+            virtual ~RenderCommand() {}
             virtual void Execute(Camera* camera , const ShaderUniforms& uniforms) = 0;
+            virtual uint64_t Key([[maybe_unused]] Camera* camera , uint32_t pass) const { return SortKey::Build(pass , 0 , 0 , 0 , 0); }
     };
 
     class DrawVao : public RenderCommand {
@@ -41,56 +141,67 @@ namespace components {
             DrawVao(VertexArray* vao , Shader* shader , const glm::mat4& model , DrawMode mode = DrawMode::TRIANGLES) 
                     : vao(vao) , shader(shader) , model(model) , mode(mode) {}
             virtual void Execute(Camera* camera , const ShaderUniforms& uniforms) override;
+            virtual uint64_t Key(Camera* camera , uint32_t pass) const override;
     };
 
+    // the component commands copy what they draw when they are built , frames can execute on the render
+    // thread after the main thread has already changed or destroyed the component
+
     class DrawRenderable : public RenderCommand {
-        components::Renderable& renderable;
+        VertexArray* vao = nullptr;
+        Shader* shader = nullptr;
         const glm::mat4 model;
         DrawMode mode;
 
         public:
-            DrawRenderable(components::Renderable& renderable , const glm::mat4& model , 
-                    DrawMode mode = DrawMode::TRIANGLES) 
-                    : renderable(renderable) , model(model) , mode(mode) {}
+            DrawRenderable(const components::Renderable& renderable , const glm::mat4& model , 
+                    DrawMode mode = DrawMode::TRIANGLES);
             virtual void Execute(Camera* camera , const ShaderUniforms& uniforms) override;
+            virtual uint64_t Key(Camera* camera , uint32_t pass) const override;
 
     };
 
     class DrawTexturedRenderable : public RenderCommand {
-        components::TexturedRenderable& renderable;
+        VertexArray* vao = nullptr;
+        Shader* shader = nullptr;
+        std::vector<Texture*> textures;
         const glm::mat4 model;
         DrawMode mode;
 
         public:
-            DrawTexturedRenderable(components::TexturedRenderable& renderable , const glm::mat4& model ,
-                            DrawMode mode = DrawMode::TRIANGLES) 
-                            : renderable(renderable) , model(model) , mode(mode) {}
+            DrawTexturedRenderable(const components::TexturedRenderable& renderable , const glm::mat4& model ,
+                            DrawMode mode = DrawMode::TRIANGLES);
             virtual void Execute(Camera* camera , const ShaderUniforms& uniforms) override;
+            virtual uint64_t Key(Camera* camera , uint32_t pass) const override;
     };
 
     class DrawRenderableModel : public RenderCommand {
-        components::RenderableModel& renderable;
+        Model* model = nullptr;
+        Shader* shader = nullptr;
+        uint32_t lod = 0;
         const glm::mat4 model_matrix;
         DrawMode mode;
 
         public:
-            DrawRenderableModel(components::RenderableModel& renderable , const glm::mat4& model_matrix , 
-                      DrawMode mode = DrawMode::TRIANGLES) 
-                      : renderable(renderable) , model_matrix(model_matrix) , mode(mode) {}
+            DrawRenderableModel(const components::RenderableModel& renderable , const glm::mat4& model_matrix , 
+                      DrawMode mode = DrawMode::TRIANGLES);
             virtual void Execute(Camera* camera , const ShaderUniforms& uniforms) override;
+            virtual uint64_t Key(Camera* camera , uint32_t pass) const override;
     };
 
     class DrawPointLight : public RenderCommand {
-        components::Renderable& renderable;
-        components::PointLight* light = nullptr;
+        VertexArray* vao = nullptr;
+        Shader* shader = nullptr;
+        glm::vec3 light_color = glm::vec3(1.f);
+        bool has_light = false;
         const glm::mat4 model_matrix;
         DrawMode mode;
 
         public:
-            DrawPointLight(components::Renderable& renderable , components::PointLight* light , const glm::mat4& model_matrix , 
-                           DrawMode mode = DrawMode::TRIANGLES) 
-                           : renderable(renderable) , light(light) , model_matrix(model_matrix) , mode(mode) {}
+            DrawPointLight(const components::Renderable& renderable , const components::PointLight* light , 
+                           const glm::mat4& model_matrix , DrawMode mode = DrawMode::TRIANGLES);
             virtual void Execute(Camera* camera , const ShaderUniforms& uniforms) override;
+            virtual uint64_t Key(Camera* camera , uint32_t pass) const override;
     };
 
 }
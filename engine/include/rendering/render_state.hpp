@@ -0,0 +1,89 @@
+#ifndef YE_RENDER_STATE_HPP
+#define YE_RENDER_STATE_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace YE {
+
+    struct RenderStats {
+        uint32_t commands = 0;
+        uint32_t draw_calls = 0;
+        uint32_t triangles = 0;
+        uint32_t program_binds = 0;
+        uint32_t program_binds_skipped = 0;
+        uint32_t vao_binds = 0;
+        uint32_t vao_binds_skipped = 0;
+        uint32_t texture_binds = 0;
+        uint32_t texture_binds_skipped = 0;
+        uint32_t frame_arena_bytes = 0;
+        uint32_t persistent_commands = 0;
+        uint32_t persistent_updates = 0;
+        uint32_t instanced_batches = 0;
+        uint32_t instanced_draws = 0;
+        uint32_t cull_tested = 0;
+        uint32_t cull_visible = 0;
+    };
+
+    /// \note shadows the pieces of GL state the renderer changes between draws so consecutive commands
+    ///     sharing a program , vertex array or texture do not rebind them. the shadow is only trusted
+    ///     between Begin and End (while the renderer executes its queues) , outside of that every call
+    ///     goes straight to GL because framebuffers , the gui and resource loading bind things directly
+    class RenderState {
+
+        static constexpr uint32_t kMaxTextureUnits = 32;
+        static constexpr uint32_t kUnknown = 0xFFFFFFFF;
+
+        static uint32_t program;
+        static uint32_t vertex_array;
+        static uint32_t active_unit;
+        static std::array<uint32_t , kMaxTextureUnits> textures;
+        static std::array<uint32_t , kMaxTextureUnits> targets;
+
+        // one bit per unit the queues left a texture bound on
+        static uint32_t bound_units;
+
+        static RenderStats stats;
+
+        static bool tracking;
+        static bool texture_arrays;
+
+        public:
+            static void Begin();
+            static void End();
+            static void Invalidate();
+            static void ResetStats();
+
+            static void UseProgram(uint32_t id);
+            static void BindVertexArray(uint32_t id);
+            static void BindTexture(uint32_t unit , uint32_t target , uint32_t id);
+
+            /// \note unbinds every unit outside of used that still holds a texture from an earlier draw , so a
+            ///     draw binding fewer textures than the one before never samples what that one left behind
+            static void ReleaseTextureUnits(uint32_t used);
+
+            inline static constexpr uint32_t UnitBit(uint32_t unit) { return unit < kMaxTextureUnits ? 1u << unit : 0; }
+
+            // called when objects are destroyed so a recycled GL name is never mistaken for a bound one
+            static void ProgramDeleted(uint32_t id);
+            static void VertexArrayDeleted(uint32_t id);
+            static void TextureDeleted(uint32_t id);
+
+            inline static void CountCommand(uint32_t count = 1) { stats.commands += count; }
+            inline static void CountDraw() { ++stats.draw_calls; }
+            inline static void CountTriangles(uint32_t count) { stats.triangles += count; }
+            inline static void CountInstancedBatch(uint32_t instances) { 
+                ++stats.instanced_batches; 
+                stats.instanced_draws += instances; 
+            }
+
+            inline static const RenderStats& Stats() { return stats; }
+
+            // lets draws read textures through their arrays , off falls back to one bind per texture
+            inline static void EnableTextureArrays(bool enable) { texture_arrays = enable; }
+            inline static bool TextureArraysEnabled() { return texture_arrays; }
+    };
+
+}
+
+#endif // !YE_RENDER_STATE_HPP
@@ -4,28 +4,49 @@
 #include <thread>
 #include <memory>
 #include <mutex>
+#include <vector>
+#include <functional>
 #include <condition_variable>
 
-#include "render_commands.hpp"
-#include "renderer.hpp"
+#include "rendering/renderer.hpp"
 
 namespace YE {
 
+    class Window;
+
+    using RenderJob = std::function<void()>;
+
+    /// \note executes recorded frames on a thread of its own so the main thread can simulate the next frame
+    ///     while the last one is submitted. the GL context moves between the two threads , it belongs to the
+    ///     render thread from Kick until the next Sync and to the main thread everywhere else
     class RenderThread {
 
         static RenderThread* singleton;
 
-        // std::unique_ptr<Renderer> renderer = nullptr;
-        std::unique_ptr<RenderQueue> render_queue = nullptr;
+        Window* window = nullptr;
+        std::thread::id main_thread;
 
         std::unique_ptr<std::thread> thread = nullptr;
 
-        std::mutex shutdown_mutex;
-        std::condition_variable shutdown_condition;
-        
+        std::mutex frame_mutex;
+        std::condition_variable frame_condition;
+        std::condition_variable done_condition;
+        FrameData* pending = nullptr;
+        bool running = false;
+        bool context_released = false;
+
+        // GL work that showed up while the context was away , run on the main thread at the next Sync
+        std::mutex job_mutex;
+        std::vector<RenderJob> jobs;
+        std::vector<RenderJob> running_jobs;
+
+        float wait_time = 0.0f;
+
+        void RenderLoop();
+
         RenderThread() {}
         ~RenderThread() {}
-        
+
         RenderThread(RenderThread&&) = delete;
         RenderThread(const RenderThread&) = delete;
         RenderThread& operator=(RenderThread&&) = delete;
@@ -35,14 +56,30 @@ namespace YE {
 
             static RenderThread* Instance();
 
-            // inline std::unique_ptr<Renderer>& GetRenderer() { return renderer; }
-            inline std::unique_ptr<RenderQueue>& GetQueue() { return render_queue; }
+            /// \note call from the thread the window's context is current on
+            void Launch(Window* window);
+
+            /// \note blocks until the frame kicked last has executed and makes the context current here again ,
+            ///     does nothing when there is no render thread or nothing in flight
+            void Sync();
+
+            /// \note releases the context and hands the frame to the render thread , returns at once. the frame
+            ///     must not be touched again before the next Sync
+            void Kick(FrameData* frame);
 
-            void Launch();
+            /// \note runs the job now when this thread can use GL , otherwise at the next Sync
+            void Submit(RenderJob job);
+
+            /// \note syncs , joins the render thread and leaves the context current on the caller
             void WaitFor();
             void Cleanup();
+
+            inline bool Running() const { return running; }
+
+            // how long the last Sync blocked , close to zero while the simulation is the slower side
+            inline float WaitTime() const { return wait_time; }
     };
 
 }
 
-#endif // !YE_RENDER_THREAD_HPP
\ No newline at end of file
+#endif // !YE_RENDER_THREAD_HPP
@@ -2,7 +2,8 @@
 #define YE_RENDERER_HPP
 
 #include <string>
-#include <queue>
+#include <array>
+#include <vector>
 #include <memory>
 #include <unordered_map>
 #include <functional>
@@ -12,13 +13,18 @@
 #include "core/defines.hpp"
 #include "core/UUID.hpp"
 #include "core/timer.hpp"
+#include "core/frame_arena.hpp"
 #include "rendering/render_commands.hpp"
+#include "rendering/render_state.hpp"
+#include "rendering/uniform_buffer.hpp"
+#include "rendering/camera.hpp"
 
 namespace YE {
 
 namespace components {
 
     struct Renderable;
+    struct PointLight;
 
 }
 
@@ -28,11 +34,10 @@ namespace components {
     class VertexArray;
     class Framebuffer;
     class Scene;
-    class Camera;
 
-    using RenderQueue = std::queue<std::unique_ptr<RenderCommand>>;
+    using RenderQueue = std::vector<std::unique_ptr<RenderCommand>>;
+    using DrawList = std::vector<DrawCommand*>;
     using VertexMap = std::unordered_map<UUID32 , VertexArray*>;
-    using RenderMap = std::unordered_map<UUID32 , RenderCommand*>;
     using FramebufferMap = std::unordered_map<UUID32 , Framebuffer*>;
     using RenderCallbackMap = std::unordered_map<UUID32 , std::function<void()>>;
 
@@ -47,6 +52,64 @@ namespace components {
         DEBUG = 1
     };
 
+    static constexpr uint32_t kFramesInFlight = 2;
+    static constexpr size_t kInitialDrawListSize = 1024;
+
+    // runs shorter than this are cheaper to draw one by one than to stream into an instance buffer
+    static constexpr uint32_t kMinInstanceBatch = 4;
+
+    // distinct shaders without the Lights block a frame is expected to draw with
+    static constexpr size_t kInitialLitShaders = 16;
+
+    /// \note a draw that stays registered with the renderer between frames , the texture list is owned
+    ///     here so the record does not depend on the component that pushed it
+    struct PersistentDraw {
+        UUID id;
+        DrawCommand cmnd;
+        std::vector<Texture*> textures;
+        bool visible = true;
+    };
+
+    // kept sorted by id so lookups are a binary search over one contiguous array
+    using PersistentDrawList = std::vector<PersistentDraw>;
+
+    struct SortEntry {
+        uint64_t key = 0;
+        uint32_t index = 0;
+    };
+
+    /// \note everything one frame needs to execute. the main thread records into one slot while the
+    ///     render thread executes the other , so nothing in here may point at state the main thread
+    ///     changes before the frame is done (draw records live in the frame's arena , the camera and
+    ///     lights are copies , heap allocated commands copy what they draw when they are built)
+    struct FrameData {
+        DrawList draw_commands;
+        DrawList debug_draw_commands;
+        RenderQueue commands;
+        RenderQueue debug_commands;
+
+        Camera camera;
+        bool has_camera = false;
+
+        LightUniforms light_uniforms;
+        uint32_t light_upload_size = 0;
+        bool lights_dirty = false;
+
+        Framebuffer* framebuffer = nullptr;
+        glm::ivec2 viewport = glm::ivec2(0);
+        glm::vec4 clear_color = glm::vec4(0.0f);
+        RenderMode render_mode = RenderMode::FILL;
+
+        uint32_t arena_bytes = 0;
+        uint32_t persistent_commands = 0;
+        uint32_t persistent_updates = 0;
+        uint32_t cull_tested = 0;
+        uint32_t cull_visible = 0;
+
+        // written by the thread executing the frame , read once the frame has been synced
+        RenderStats stats;
+    };
+
     class Renderer {
 
         static Renderer* singleton;
@@ -56,13 +119,42 @@ namespace components {
         Camera* render_camera = nullptr;
 
         App* app_handle = nullptr;
+
+        // draw records live in the arena of the frame they were submitted in , the arena is reset
+        // the next time its frame comes around so a record never outlives kFramesInFlight frames
+        std::array<FrameArena , kFramesInFlight> frame_arenas;
+        std::array<FrameData , kFramesInFlight> frames;
+        uint32_t frame_index = 0;
+
+        // frames execute on the render thread , set before the window opens
+        bool threaded = false;
+
+        // reused every frame so sorting does not allocate once the queues reach their usual size
+        std::vector<SortEntry> sort_entries;
+        std::vector<SortEntry> sort_scratch;
+        std::vector<InstanceData> instance_data;
+
+        // shaders without the Lights block that already had this frame's point lights set
+        std::vector<Shader*> lit_shaders;
+
+        RenderStats frame_stats;
+
+        // camera and light data shared by every shader declaring the Camera / Lights blocks
+        UniformBuffer* camera_buffer = nullptr;
+        UniformBuffer* light_buffer = nullptr;
+        CameraUniforms camera_uniforms;
+        LightUniforms light_uniforms;
+        uint32_t light_upload_size = offsetof(LightUniforms , plights);
+        bool lights_dirty = true;
         
-        RenderQueue commands;
-        RenderQueue debug_commands;
-        
-        // used for persisting render commands
-        RenderMap persistent_renderables;
-        RenderMap debug_renderables;
+        // draws that persist between frames , scenes only send changes to these
+        PersistentDrawList persistent_draws;
+        PersistentDrawList debug_persistent_draws;
+        uint32_t persistent_updates = 0;
+
+        // reported by the scene's frustum test , copied into the stats of the next executed frame
+        uint32_t cull_tested = 0;
+        uint32_t cull_visible = 0;
 
         FramebufferMap framebuffers;
         RenderCallbackMap PreRenderCallbacks;
@@ -78,10 +170,20 @@ namespace components {
         bool framebuffer_active = false;
 
         bool CheckID(UUID32 id , const std::string& name , const RenderCallbackMap& map);
+
+        PersistentDrawList& PersistentDraws(DrawGroup group);
+        PersistentDrawList::iterator FindPersistentDraw(PersistentDrawList& draws , UUID id);
+        void AssignPersistentDraw(PersistentDraw& draw , const DrawCommand& cmnd);
+
+        DrawCommand* RecordDraw(const DrawCommand& cmnd);
+        void RecordPersistentDraws(PersistentDrawList& draws , DrawList& records);
+
+        void ApplyPointLights(Shader* shader , const LightUniforms& lights);
+        void SortQueue(const DrawList& records , const RenderQueue& queue , DrawGroup group , Camera* camera);
+        void ExecuteQueue(DrawList& records , RenderQueue& queue , DrawGroup group , Camera* camera , 
+                          const LightUniforms& lights);
         
-        void BeginRender();
-        void Execute();
-        void EndRender();
+        void Record();
 
         Renderer() {}
         ~Renderer() {}
@@ -96,19 +198,29 @@ namespace components {
             static Renderer* Instance();
 
             void RegisterPreRenderCallback(std::function<void()> callback , const std::string& name);
+            /// \note post render callbacks run on the main thread right after the frame is handed off , with a
+            ///     render thread that frame is still executing. they must not make GL calls or touch the frame's
+            ///     commands , GL work goes through RenderThread::Submit
             void RegisterPostRenderCallback(std::function<void()> callback , const std::string& name);
 
-            void Initialize(App* app);
+            void Initialize(App* app , bool threaded = false);
             void OpenWindow();
             
             void PushFramebuffer(const std::string& name , Framebuffer* framebuffer);
             void SubmitRenderCmnd(std::unique_ptr<RenderCommand>& cmnd);
             void SubmitDebugRenderCmnd(std::unique_ptr<RenderCommand>& cmnd);
+            void SubmitDraw(const DrawCommand& cmnd , DrawGroup group = DrawGroup::DEFAULT);
 
-            /// \todo implement these functions so we can stop submitting render commands every frame that can persist between frames
-            // void PushRenderable(RenderCommand* cmnd , const std::string& name , DrawGroup group = DrawGroup::DEFAULT);
-            // void UpdateRenderCmnd(RenderCommand* new_cmnd , const std::string& name , DrawGroup group = DrawGroup::DEFAULT);
-            // void RemoveRenderCmnd(const std::string& name , DrawGroup group = DrawGroup::DEFAULT);
+            void PushRenderable(UUID id , const DrawCommand& cmnd , DrawGroup group = DrawGroup::DEFAULT);
+            void PushRenderable(const std::string& name , const DrawCommand& cmnd , DrawGroup group = DrawGroup::DEFAULT);
+            void UpdateRenderCmnd(UUID id , const DrawCommand& new_cmnd , DrawGroup group = DrawGroup::DEFAULT);
+            void UpdateRenderCmnd(const std::string& name , const DrawCommand& new_cmnd , DrawGroup group = DrawGroup::DEFAULT);
+            void UpdateRenderTransform(UUID id , const glm::mat4& transform , DrawGroup group = DrawGroup::DEFAULT);
+            void SetRenderableVisible(UUID id , bool visible , DrawGroup group = DrawGroup::DEFAULT);
+            void RemoveRenderCmnd(UUID id , DrawGroup group = DrawGroup::DEFAULT);
+            void RemoveRenderCmnd(const std::string& name , DrawGroup group = DrawGroup::DEFAULT);
+
+            const DrawCommand* PersistentRenderable(UUID id , DrawGroup group = DrawGroup::DEFAULT);
 
             void PopFramebuffer(const std::string& name);
             
@@ -121,17 +233,27 @@ namespace components {
 
             void RegisterSceneContext(Scene* scene);
             void PushCamera(Camera* camera);
+            void UploadCameraUniforms(Camera* camera);
+            void UpdatePointLights(const std::vector<components::PointLight>& lights);
+            void SetCullingStats(uint32_t tested , uint32_t visible);
             
             void SetSceneRenderMode(RenderMode mode);
 
+            /// \note records the frame on the calling thread and executes it there , or kicks it to the
+            ///     render thread when one is running
             void Render();
 
+            /// \note issues every GL call of a recorded frame , called by whichever thread owns the context
+            void ExecuteFrame(FrameData& frame);
+
             void CloseWindow();
             void Cleanup();
             
             inline FramebufferMap* Framebuffers() { return &framebuffers; }
             inline Window* ActiveWindow() { return window; }
             inline UUID32 ActiveFramebuffer() const { return active_framebuffer; }
+            inline const RenderStats& FrameStats() const { return frame_stats; }
+            inline FrameArena& FrameMemory() { return frame_arenas[frame_index]; }
             inline bool DebugRendering() const { return debug_rendering; }
             inline bool FramebufferActive() const { return framebuffer_active; }
     };
@@ -1,14 +1,20 @@
 #ifndef YE_SHADER_HPP
 #define YE_SHADER_HPP
 
+#include <array>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 #include <variant>
 
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 
 #include "core/UUID.hpp"
+#include "core/hash.hpp"
+#include "core/resource_handle.hpp"
+#include "rendering/render_state.hpp"
+#include "rendering/uniform_buffer.hpp"
 
 namespace YE {
 
@@ -35,6 +41,33 @@ namespace YE {
     //     glm::mat3 , glm::mat4
     // >;
 
+    /// \note names a uniform by the FNV32 of its name , a string literal is hashed by the compiler so
+    ///     hot paths never build or hash strings. names only known at runtime go through the explicit
+    ///     constructor and should be built once and kept
+    struct UniformId {
+        uint32_t hash = 0;
+
+        constexpr UniformId() = default;
+
+        template <size_t N>
+        consteval UniformId(const char (&name)[N])
+            : hash(Hash::FNV32(std::string_view{ name , N - 1 })) {}
+
+        explicit constexpr UniformId(std::string_view name)
+            : hash(Hash::FNV32(name)) {}
+    };
+
+    // sampler names the default shaders use for a draw's textures , "tex0" through "tex15"
+    static constexpr std::array<UniformId , 16> kTextureUniforms = {
+        "tex0" , "tex1" , "tex2" , "tex3" , "tex4" , "tex5" , "tex6" , "tex7" ,
+        "tex8" , "tex9" , "tex10" , "tex11" , "tex12" , "tex13" , "tex14" , "tex15"
+    };
+
+    // sampler2DArray names for the same slots when a draw reads its textures out of arrays
+    static constexpr std::array<UniformId , 4> kTextureArrayUniforms = {
+        "tex_array0" , "tex_array1" , "tex_array2" , "tex_array3"
+    };
+
     struct UniformData {
         UniformType type;
         void* data_handle;
@@ -42,7 +75,13 @@ namespace YE {
 
     struct Uniform {
         std::string name;
+        // hashed once here so setting the uniform is only the table probe
+        UniformId id;
         UniformData data;
+
+        Uniform() {}
+        Uniform(const std::string& name , UniformData data)
+            : name(name) , id(name) , data(data) {}
     };
 
     struct ShaderUniforms {
@@ -62,12 +101,21 @@ namespace YE {
         std::string geom_path;
 
         bool has_geom = false;
+        // a hot reload is in flight , further changes wait for it to land
+        bool reloading = false;
 
         Shader* shader = nullptr;
+        ShaderHandle handle;
 
         ShaderResource() {}
     };
 
+    /// \note one entry of a shader's uniform table , empty slots have a location of -1
+    struct UniformSlot {
+        uint32_t hash = 0;
+        int32_t location = -1;
+    };
+
     class Shader {
 
         enum ShaderType {
@@ -80,6 +128,11 @@ namespace YE {
 
         bool valid = false;
         bool has_geometry = false;
+        bool instancing = false;
+        bool texture_arrays = false;
+        bool camera_block = false;
+        bool light_block = false;
+        bool from_cache = false;
 
         uint32_t vertex_shader = 0;
         uint32_t fragment_shader = 0;
@@ -90,13 +143,25 @@ namespace YE {
         std::string fragment_path;
         std::string geometry_path;
 
-        std::unordered_map<UUID32 , int32_t> uniform_locations;
+        // stage sources read ahead of Compile , held only until the next compile
+        std::string vertex_src;
+        std::string fragment_src;
+        std::string geometry_src;
+        bool sources_read = false;
+
+        // every active uniform , filled once after linking. open addressing on the name hash with the
+        // table kept at most half full so a lookup is a mask and a probe or two
+        std::vector<UniformSlot> uniform_table;
+        uint32_t uniform_mask = 0;
 
-        uint32_t GetUniformLocation(const std::string& name);
+        void InsertUniform(std::string_view name , int32_t location);
+        void BuildUniformTable();
 
         void ShaderError(ShaderType type , uint32_t shader);
         void CompileShader(ShaderType type , uint32_t& shader , const char* buffer);
         void Link();
+        void QueryProgram();
+        bool BindUniformBlock(const char* block , UniformBinding binding);
 
         Shader(Shader&&) = delete;
         Shader(const Shader&) = delete;
@@ -109,19 +174,45 @@ namespace YE {
                 has_geometry(geometry_path == "" ? false : true) {}
             ~Shader();
 
+            /// \note reads every stage from disk without touching GL , safe to call from a worker thread
+            void ReadSources();
+
+            /// \note uses the sources from ReadSources when it ran , otherwise reads them first
             bool Compile();
 
+            /// \note compiles a new program from the current sources and swaps it in , on failure the
+            ///     previous program stays in use
+            bool Recompile();
+
+            // -1 for names the program does not use , GL ignores uniform calls at that location
+            inline int32_t UniformLocation(UniformId id) const {
+                if (uniform_table.empty()) return -1;
+
+                for (uint32_t i = id.hash & uniform_mask; ; i = (i + 1) & uniform_mask) {
+                    const UniformSlot& slot = uniform_table[i];
+                    if (slot.location == -1 || slot.hash == id.hash)
+                        return slot.location;
+                }
+            }
+
             void SetUniform(const Uniform& uniform);
-            void SetUniformInt(const std::string& name , uint32_t val);
-            void SetUniformFloat(const std::string& name , float val);
-            void SetUniformVec2(const std::string& name , const glm::vec2& val);
-            void SetUniformVec3(const std::string& name , const glm::vec3& val);
-            void SetUniformVec4(const std::string& name , const glm::vec4& val);
-            void SetUniformMat3(const std::string& name , const glm::mat3& mat);
-            void SetUniformMat4(const std::string& name , const glm::mat4& mat);
-
-            inline void Bind() const { glUseProgram(program); }
-            inline void Unbind() const { glUseProgram(0); }
+            void SetUniformInt(UniformId id , uint32_t val);
+            void SetUniformFloat(UniformId id , float val);
+            void SetUniformVec2(UniformId id , const glm::vec2& val);
+            void SetUniformVec3(UniformId id , const glm::vec3& val);
+            void SetUniformVec4(UniformId id , const glm::vec4& val);
+            void SetUniformMat3(UniformId id , const glm::mat3& mat);
+            void SetUniformMat4(UniformId id , const glm::mat4& mat);
+
+            inline void Bind() const { RenderState::UseProgram(program); }
+            inline void Unbind() const { RenderState::UseProgram(0); }
+
+            inline uint32_t ID() const { return program; }
+            inline bool SupportsInstancing() const { return instancing; }
+            inline bool SupportsTextureArrays() const { return texture_arrays; }
+            inline bool UsesCameraBlock() const { return camera_block; }
+            inline bool UsesLightBlock() const { return light_block; }
+            inline bool FromCache() const { return from_cache; }
 
             inline std::string Name() const { return name; }
             inline void SetName(const std::string& name) { this->name = name; }
@@ -3,16 +3,22 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <glm/glm.hpp>
 
 #include <glad/glad.h>
 
+#include "core/resource_handle.hpp"
+#include "rendering/texture_cache.hpp"
+#include "rendering/texture_array.hpp"
+
 #define PIXEL_INDEX(i , j , width) (i*width + j)
 
 namespace YE {
 
     class Texture;
+    class MappedFile;
     
     enum FilterType {
         nearest = GL_NEAREST ,
@@ -54,13 +60,22 @@ namespace YE {
         ChannelType channels = ChannelType::RGB;
         TargetType target = TargetType::TEX_2D;
 
+        // a hot reload is in flight , further changes wait for it to land
+        bool reloading = false;
+
         Texture* texture = nullptr;
+        TextureHandle handle;
 
         TextureResource() {}
     };
 
     class Texture {
 
+        // shared checkerboard bound in place of textures that are still loading
+        static uint32_t placeholder;
+        // whether the context can sample s3tc , decided once the context exists and before any decode
+        static bool block_compression;
+
         ChannelType channels = ChannelType::RGB;
         TargetType target = TargetType::TEX_2D;
         FilterType filter = linear;
@@ -69,7 +84,21 @@ namespace YE {
         uint32_t texture = 0;
         glm::ivec2 size;
 
-        uint8_t* pixels = nullptr;
+        int32_t num_channels = 0;
+
+        // the decoded mip chain either lives in the mapped cache file or , right after a rebuild , in
+        //  the built image. both are released once the GL texture owns the data
+        MappedFile* cache = nullptr;
+        std::vector<uint8_t> built;
+        TextureCacheView view;
+
+        // set when the texture lives in a layer of an array , texture is then a view of that layer
+        TextureArray* array = nullptr;
+        uint32_t layer = 0;
+
+        bool compress = true;
+        bool decoded = false;
+        bool ready = false;
 
         std::string name;
         std::string path;
@@ -84,8 +113,29 @@ namespace YE {
                 : path(path) {}
             ~Texture();
 
+            /// \note creates and destroys the shared placeholder , both need a current GL context
+            static void CreatePlaceholder();
+            static void DestroyPlaceholder();
+
             void Load(TargetType target = TEX_2D , ChannelType channels = RGB);
 
+            /// \note maps the cached mip chain , or decodes the source and rebuilds the cache when it is missing
+            ///     or stale. never touches GL , safe to call from a worker thread
+            void Decode();
+            /// \note creates the GL texture from the cached mips , until then the texture binds the placeholder.
+            ///     with a manager the mips go into a shared array when one fits the texture
+            void Upload(TargetType target = TEX_2D , ChannelType channels = RGB , TextureArrayManager* arrays = nullptr);
+
+            /// \note forgets the decode so the next Decode reads the source again , the current image stays
+            ///     bound until Reload swaps it. only for textures that are Ready
+            inline void Invalidate() { decoded = false; }
+            /// \note replaces the GL texture with the image decoded since Invalidate , a failed decode keeps
+            ///     the current image
+            void Reload(TextureArrayManager* arrays = nullptr);
+
+            /// \note only takes effect before Decode , normal maps are never block compressed
+            inline void SetCompressed(bool compress) { this->compress = compress; }
+
             void SetFilterType(FilterType filter);
             void SetTextureType(TextureType type);
 
@@ -94,6 +144,16 @@ namespace YE {
 
             std::string GetTypeName() const;
 
+            inline TextureType Type() const { return type; }
+
+            inline uint32_t ID() const { return ready ? texture : placeholder; }
+            inline bool Ready() const { return ready; }
+
+            inline TextureArray* Array() const { return ready ? array : nullptr; }
+            inline uint32_t Layer() const { return layer; }
+            // the array for textures living in one , so draws sharing an array sort next to each other
+            inline uint32_t BatchID() const { return Array() != nullptr ? array->ID() : ID(); }
+
             inline std::string Name() const { return name; }
             inline void SetName(const std::string& name) { this->name = name; }
     };
@@ -0,0 +1,89 @@
+#ifndef YE_TEXTURE_ARRAY_HPP
+#define YE_TEXTURE_ARRAY_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include "rendering/texture_cache.hpp"
+
+namespace YE {
+
+    static constexpr uint32_t kTextureArrayLayers = 64;
+
+    // storage is reserved for every layer up front , an array never reserves more than this
+    static constexpr uint64_t kTextureArrayBudget = 64ull * 1024 * 1024;
+
+    // texture slots a draw can read through arrays , the layer of each slot travels in one vec4
+    static constexpr uint32_t kMaxArrayTextures = 4;
+
+    // array samplers sit on their own units so they never alias a sampler2D unit of the same program
+    static constexpr uint32_t kTextureArrayUnit = 16;
+
+    /// \note GL_TEXTURE_2D_ARRAY with immutable storage for textures sharing format , size and mip count.
+    ///     each texture keeps a GL_TEXTURE_2D view of its layer so code binding single textures still works
+    class TextureArray {
+
+        uint32_t texture = 0;
+
+        TextureFormat format = TextureFormat::RGBA8;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t num_mips = 0;
+        uint32_t capacity = 0;
+
+        uint32_t num_layers = 0;
+        std::vector<uint32_t> free_layers;
+
+        TextureArray(TextureArray&&) = delete;
+        TextureArray(const TextureArray&) = delete;
+        TextureArray& operator=(TextureArray&&) = delete;
+        TextureArray& operator=(const TextureArray&) = delete;
+
+        public:
+            TextureArray(TextureFormat format , uint32_t width , uint32_t height , uint32_t num_mips ,
+                         uint32_t capacity = kTextureArrayLayers);
+            ~TextureArray();
+
+            bool Matches(const TextureCacheHeader& header) const;
+
+            /// \note uploads every mip of the view into a free layer and returns it , check Full first
+            uint32_t AddLayer(const TextureCacheView& view);
+            void ReleaseLayer(uint32_t layer);
+
+            void Bind(uint32_t unit) const;
+
+            inline uint32_t ID() const { return texture; }
+            inline TextureFormat Format() const { return format; }
+            inline uint32_t NumMips() const { return num_mips; }
+            inline uint32_t NumLayers() const { return num_layers - static_cast<uint32_t>(free_layers.size()); }
+            inline bool Full() const { return free_layers.empty() && num_layers == capacity; }
+    };
+
+    /// \note owns every texture array , textures are placed into the first array that matches them and a
+    ///     new array is started when all matching ones are full
+    class TextureArrayManager {
+
+        std::vector<TextureArray*> arrays;
+
+        TextureArrayManager(TextureArrayManager&&) = delete;
+        TextureArrayManager(const TextureArrayManager&) = delete;
+        TextureArrayManager& operator=(TextureArrayManager&&) = delete;
+        TextureArrayManager& operator=(const TextureArrayManager&) = delete;
+
+        public:
+            TextureArrayManager() {}
+            ~TextureArrayManager();
+
+            /// \note needs a current GL context , returns null when the texture can not live in an array. textures
+            ///     so large that fewer than two fit the budget stay on their own
+            TextureArray* Place(const TextureCacheView& view , uint32_t& layer);
+
+            /// \note every texture placed here has to be destroyed first
+            void Cleanup();
+
+            inline uint32_t NumArrays() const { return static_cast<uint32_t>(arrays.size()); }
+    };
+
+}
+
+#endif // !YE_TEXTURE_ARRAY_HPP
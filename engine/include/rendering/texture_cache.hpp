@@ -0,0 +1,102 @@
+#ifndef YE_TEXTURE_CACHE_HPP
+#define YE_TEXTURE_CACHE_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+namespace YE {
+
+    static constexpr uint32_t kTextureCacheMagic = 0x58455459; // "YTEX"
+    static constexpr uint32_t kTextureCacheVersion = 1;
+    static constexpr uint32_t kTextureCacheAlignment = 16;
+    static constexpr const char* kTextureCacheExtension = ".ytex";
+    static constexpr uint32_t kMaxTextureMips = 16;
+
+    /// \note BC1 and BC3 are the s3tc formats , BC4 is a single channel block format (rgtc1).
+    ///     every block format stores 4x4 pixel blocks so mips smaller than a block still take a whole one
+    enum class TextureFormat : uint32_t {
+        R8 = 0 ,
+        RGB8 ,
+        RGBA8 ,
+        BC1 ,
+        BC3 ,
+        BC4
+    };
+
+    /// \note every offset is from the start of the file and aligned to kTextureCacheAlignment so each mip
+    ///     can be handed to GL straight out of the mapping
+    struct TextureCacheHeader {
+        uint32_t magic = kTextureCacheMagic;
+        uint32_t version = kTextureCacheVersion;
+
+        // the cache is keyed by the crc of the source bytes , size and write time only spare the rehash
+        uint64_t source_size = 0;
+        int64_t source_time = 0;
+        uint32_t source_hash = 0;
+        uint32_t source_channels = 0;
+
+        TextureFormat format = TextureFormat::RGBA8;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t num_mips = 0;
+
+        uint64_t mip_offset = 0;
+    };
+
+    struct TextureCacheMip {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    /// \note read only view over a cache image , pointers are valid as long as the memory behind it is
+    struct TextureCacheView {
+        const TextureCacheHeader* header = nullptr;
+        const TextureCacheMip* mips = nullptr;
+        const uint8_t* data = nullptr;
+
+        inline const uint8_t* MipData(uint32_t i) const { return data + mips[i].offset; }
+    };
+
+namespace TextureCache {
+
+    inline std::string CachePath(const std::string& source_path) { return source_path + kTextureCacheExtension; }
+
+    bool IsCompressed(TextureFormat format);
+    uint64_t MipBytes(TextureFormat format , uint32_t width , uint32_t height);
+    uint32_t NumMips(uint32_t width , uint32_t height);
+
+    GLenum InternalFormat(TextureFormat format);
+    /// \note pixel format for the uncompressed formats , GL_NONE for block formats
+    GLenum PixelFormat(TextureFormat format);
+    const char* FormatName(TextureFormat format);
+
+    /// \note picks BC4 for single channel images , BC3 for images with any translucent pixel and BC1 for
+    ///     everything else , without compression the source channels are kept as they are
+    TextureFormat ChooseFormat(const uint8_t* pixels , uint32_t width , uint32_t height , uint32_t channels , bool compress);
+
+    /// \note builds the mip chain with a box filter and block compresses every level , the result is the
+    ///     complete cache file so it can be written as is and viewed without a round trip through disk
+    bool Build(const std::string& source_path , uint32_t source_hash , const uint8_t* pixels ,
+               uint32_t width , uint32_t height , uint32_t channels , bool compress , std::vector<uint8_t>& result);
+
+    /// \note writes to a temporary file first and renames it over the old cache so a half written
+    ///     file is never picked up by the loader
+    bool Write(const std::string& cache_path , const std::vector<uint8_t>& image);
+
+    /// \note checks the layout of a cache image without looking at the source
+    bool View(const uint8_t* data , size_t size , TextureCacheView& view);
+
+    /// \note checks the header and layout and that the source has not changed , the source is only
+    ///     rehashed when its size matches but its write time does not
+    bool Read(const uint8_t* data , size_t size , const std::string& source_path , TextureCacheView& view);
+
+}
+
+}
+
+#endif // !YE_TEXTURE_CACHE_HPP
@@ -0,0 +1,115 @@
+#ifndef YE_UNIFORM_BUFFER_HPP
+#define YE_UNIFORM_BUFFER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <glm/glm.hpp>
+
+namespace YE {
+
+    static constexpr uint32_t kMaxPointLights = 128;
+
+    /// \note binding points are fixed so shaders can declare them with layout (binding = N) and never
+    ///     need glUniformBlockBinding , Shader::Link still binds blocks it finds by name for older GLSL
+    enum class UniformBinding : uint32_t {
+        CAMERA = 0 ,
+        LIGHTS = 1
+    };
+
+namespace std140 {
+
+    // base alignment of vec3 , vec4 , mat4 columns , array elements and structs
+    constexpr size_t kVec4Alignment = 16;
+
+    constexpr size_t Align(size_t offset , size_t alignment) {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    // array elements and structs are rounded up to a full vec4
+    constexpr size_t ArrayStride(size_t element_size) {
+        return Align(element_size , kVec4Alignment);
+    }
+
+}
+
+    /// \note mirrors
+    ///     layout (std140 , binding = 0) uniform Camera {
+    ///         mat4 view; mat4 proj; mat4 view_proj; vec3 view_pos; bool camera_active;
+    ///     };
+    ///     a scalar after a vec3 packs into the vec3's spare lane
+    struct CameraUniforms {
+        glm::mat4 view = glm::mat4(1.f);
+        glm::mat4 proj = glm::mat4(1.f);
+        glm::mat4 view_proj = glm::mat4(1.f);
+        glm::vec3 view_pos = glm::vec3(0.f);
+        int32_t camera_active = 0;
+    };
+
+    static_assert(offsetof(CameraUniforms , view_pos) == 192 , "Camera block view_pos must sit at offset 192");
+    static_assert(offsetof(CameraUniforms , camera_active) == 204 , "Camera block camera_active must share view_pos's vec4");
+    static_assert(sizeof(CameraUniforms) == 208 , "Camera block must match its std140 size");
+
+    /// \note mirrors the PointLight struct in the default shaders
+    ///     struct PointLight { vec3 position; vec3 diffuse; vec3 ambient; vec3 specular; float constant; float linear; float quadratic; };
+    struct PointLightUniforms {
+        glm::vec3 position = glm::vec3(0.f);
+        float padding0 = 0.f;
+        glm::vec3 diffuse = glm::vec3(1.f);
+        float padding1 = 0.f;
+        glm::vec3 ambient = glm::vec3(1.f);
+        float padding2 = 0.f;
+        glm::vec3 specular = glm::vec3(1.f);
+        float constant = 1.f;
+        float linear = 0.f;
+        float quadratic = 0.f;
+        float padding3[2] = { 0.f , 0.f };
+    };
+
+    static_assert(offsetof(PointLightUniforms , constant) == 60 , "PointLight constant must share specular's vec4");
+    static_assert(sizeof(PointLightUniforms) == std140::ArrayStride(72) , "PointLight must match its std140 array stride");
+
+    /// \note mirrors
+    ///     layout (std140 , binding = 1) uniform Lights {
+    ///         int point_light_count; PointLight plights[MAX_POINT_LIGHTS];
+    ///     };
+    struct LightUniforms {
+        int32_t point_light_count = 0;
+        int32_t padding[3] = { 0 , 0 , 0 };
+        PointLightUniforms plights[kMaxPointLights];
+    };
+
+    static_assert(offsetof(LightUniforms , plights) == std140::kVec4Alignment , "Lights block array must start on a vec4 boundary");
+
+    class UniformBuffer {
+        uint32_t ubo = 0;
+        uint32_t binding = 0;
+        uint32_t size = 0;
+
+        UniformBuffer(UniformBuffer&&) = delete;
+        UniformBuffer(const UniformBuffer&) = delete;
+        UniformBuffer& operator=(UniformBuffer&&) = delete;
+        UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+        public:
+            UniformBuffer(uint32_t size , UniformBinding binding);
+            ~UniformBuffer();
+
+            void Upload(const void* data , uint32_t size , uint32_t offset = 0);
+            void Bind() const;
+
+            template<typename T>
+            void Upload(const T& block , uint32_t size = sizeof(T)) {
+                static_assert(std::is_trivially_copyable_v<T> , "Uniform blocks must be plain data");
+                Upload(static_cast<const void*>(&block) , size , 0);
+            }
+
+            inline uint32_t ID() const { return ubo; }
+            inline uint32_t Binding() const { return binding; }
+            inline uint32_t Size() const { return size; }
+    };
+
+}
+
+#endif // !YE_UNIFORM_BUFFER_HPP
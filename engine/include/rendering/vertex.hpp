@@ -7,6 +7,10 @@
 
 namespace YE {
 
+    // per instance attributes start here , well past the slots any vertex layout uses , so shaders can
+    // declare them at a fixed location no matter which layout the mesh was uploaded with
+    static constexpr uint32_t kInstanceAttributeLocation = 8;
+
     struct Vertex {
         glm::vec3 position{ 0.f , 0.f , 0.f };
         glm::vec3 color{ 1.f , 1.f , 1.f };
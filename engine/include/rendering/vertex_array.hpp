@@ -7,6 +7,9 @@
 #include <glad/glad.h>
 
 #include "vertex.hpp"
+#include "vertex_format.hpp"
+#include "bounds.hpp"
+#include "core/resource_handle.hpp"
 
 namespace YE {
 
@@ -27,8 +30,13 @@ namespace YE {
 
     class VertexArray;
 
+    // one mat4 per instance spread over four vec4 attributes , then a vec4 holding the array layer of
+    // each texture slot
+    inline const std::vector<uint32_t> kInstanceLayout{ 4 , 4 , 4 , 4 , 4 };
+
     struct VertexArrayResource {
         VertexArray* vao = nullptr;
+        VertexArrayHandle handle;
         std::string name;
     };
 
@@ -41,17 +49,38 @@ namespace YE {
 
         uint32_t stride = 0;
 
+        uint32_t instance_VBO = 0;
+        uint32_t instance_stride = 0;
+        uint32_t instance_capacity = 0;
+
         bool has_indices = false;
+        bool prepared = false;
         bool valid = false;
 
         bool yverts = false;
 
+        // vertices built from Vertex are packed with a declared format , raw float vertices use layout
+        VertexFormat format;
+        bool formatted = false;
+
         std::vector<Vertex> yvertices;
+        std::vector<uint8_t> packed;
         std::vector<float> vertices;
         std::vector<uint32_t> indices;
         std::vector<uint32_t> layout;
+        std::vector<uint32_t> instance_layout = kInstanceLayout;
+
+        // what Upload copies into GL , either the owned vectors above or memory owned by someone else
+        const uint8_t* vertex_data = nullptr;
+        const uint32_t* index_data = nullptr;
+        uint32_t vertex_count = 0;
+        uint32_t index_count = 0;
 
-        void LoadVertices();
+        AABB bounds;
+        BoundingSphere sphere;
+
+        void CalculateBounds();
+        void SetupInstanceAttributes();
         
         VertexArray(VertexArray&&) = delete;
         VertexArray(const VertexArray&) = delete;
@@ -60,15 +89,44 @@ namespace YE {
 
         public:
             VertexArray(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices , BufferType buffer_type = BufferType::STATIC) 
-                        : yvertices(vertices) , indices(indices) , layout(Vertex::Layout()) , buffer_type(buffer_type) , yverts(true) {}
+                        : yvertices(vertices) , indices(indices) , layout(Vertex::Layout()) , buffer_type(buffer_type) , yverts(true) , formatted(true) {}
+            VertexArray(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices , const VertexFormat& format , 
+                        BufferType buffer_type = BufferType::STATIC) 
+                        : yvertices(vertices) , indices(indices) , layout(Vertex::Layout()) , buffer_type(buffer_type) , yverts(true) , 
+                          format(format) , formatted(true) {}
             VertexArray(const std::vector<float>& vertices, const std::vector<uint32_t>& indices , const std::vector<uint32_t>& layout ,
                         BufferType buffer_type = BufferType::STATIC) 
                         : vertices(vertices) , indices(indices) , layout(layout) , buffer_type(buffer_type) , yverts(false) {}
+            /// \note does not copy or own the data , it must stay alive until Upload has run. Used to upload
+            ///     vertices already packed with format , straight out of a memory mapped baked mesh
+            VertexArray(const void* vertices , uint32_t num_vertices , const uint32_t* indices , uint32_t num_indices , 
+                        const VertexFormat& format , const AABB& bounds , BufferType buffer_type = BufferType::STATIC);
             ~VertexArray();
 
+            /// \note interleaves the vertex data and calculates bounds without touching GL , safe to call
+            ///     from a worker thread. Upload calls it if it has not run yet
+            void Prepare();
             void Upload();
             void Draw(DrawMode mode) const;
-
+            /// \note draws a sub range of the index buffer (or of the vertices when there are no indices)
+            void Draw(DrawMode mode , uint32_t first , uint32_t count) const;
+
+            /// \note the instance buffer is created on the first upload , change the layout before then
+            void SetInstanceLayout(const std::vector<uint32_t>& layout);
+            void UploadInstances(const void* data , uint32_t count);
+            void DrawInstanced(DrawMode mode , uint32_t count) const;
+
+            /// \note local space bounds of the vertex data , calculated on upload
+            inline const AABB& Bounds() const { return bounds; }
+            inline const BoundingSphere& Sphere() const { return sphere; }
+
+            inline uint32_t ID() const { return VAO; }
+            inline uint32_t NumVertices() const { return vertex_count; }
+            inline uint32_t NumIndices() const { return index_count; }
+            inline uint32_t VertexBytes() const { return vertex_count * stride; }
+            inline uint32_t IndexBytes() const { return index_count * sizeof(uint32_t); }
+            inline const VertexFormat& Format() const { return format; }
+            inline bool Instanced() const { return instance_VBO != 0; }
             inline bool Valid() const { return valid; }
     };
 
@@ -0,0 +1,93 @@
+#ifndef YE_VERTEX_FORMAT_HPP
+#define YE_VERTEX_FORMAT_HPP
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "rendering/vertex.hpp"
+
+namespace YE {
+
+    /// \note one per member of Vertex , the value is the attribute location shaders declare it at
+    enum class VertexAttribute : uint32_t {
+        POSITION = 0 ,
+        COLOR = 1 ,
+        NORMAL = 2 ,
+        TANGENT = 3 ,
+        BITANGENT = 4 ,
+        TEXCOORD = 5 ,
+        OPACITY = 6
+    };
+
+    static constexpr uint32_t kNumVertexAttributes = 7;
+
+    /// \note how an attribute is stored in the vertex buffer , GL converts every type back to floats
+    ///     before the shader sees it so shaders do not change with the format
+    enum class AttributeType : uint8_t {
+        // left out of the buffer , the shader reads the attribute's default instead
+        NONE = 0 ,
+        FLOAT32 = 1 ,
+        HALF_FLOAT = 2 ,
+        UNORM16 = 3 ,
+        // four bytes , when color and opacity are both unorm8 the opacity lives in the color's alpha byte
+        UNORM8 = 4 ,
+        // four bytes , signed normalized 10 bits per component. a tangent stored this way carries the
+        // bitangent sign in the 2 bit w so the bitangent can be left out and derived in the shader
+        SNORM_10_10_10_2 = 5
+    };
+
+    // round trip errors Select accepts before it falls back to a wider type
+    static constexpr float kDirectionTolerance = 1.f / 256.f;
+    static constexpr float kColorTolerance = 1.f / 255.f;
+    static constexpr float kTexcoordTolerance = 1.f / 2048.f;
+    static constexpr float kDerivedBitangentTolerance = 0.05f;
+
+    /// \note declares the type of every attribute of a vertex , offsets and stride follow from the types
+    ///     in attribute order. Full is byte for byte the layout of Vertex , Select picks the smallest
+    ///     format that reproduces a set of vertices within the tolerances above
+    class VertexFormat {
+
+        std::array<AttributeType , kNumVertexAttributes> types{};
+        std::array<uint32_t , kNumVertexAttributes> offsets{};
+        uint32_t stride = 0;
+
+        void CalculateOffsets();
+
+        public:
+            VertexFormat();
+            VertexFormat(const std::array<AttributeType , kNumVertexAttributes>& types);
+
+            static VertexFormat Full();
+            static VertexFormat Select(const Vertex* vertices , uint32_t count);
+
+            /// \note writes count vertices of Stride() bytes each to out
+            void Pack(const Vertex* vertices , uint32_t count , uint8_t* out) const;
+            void Unpack(const uint8_t* data , uint32_t count , Vertex* out) const;
+
+            /// \note sets up the attribute pointers of the bound vertex array for the bound buffer ,
+            ///     attributes the format leaves out read one vec4 per attribute from constants_offset on
+            ///     with a divisor nothing reaches , so the default stays part of the vertex array
+            void SetupAttributes(uint32_t constants_offset) const;
+            /// \note defaults of the attributes left out , in attribute order , NumConstants vec4s
+            void WriteConstants(float* out) const;
+            uint32_t NumConstants() const;
+
+            std::string Describe() const;
+
+            inline AttributeType Type(VertexAttribute attribute) const { return types[static_cast<uint32_t>(attribute)]; }
+            inline uint32_t Offset(VertexAttribute attribute) const { return offsets[static_cast<uint32_t>(attribute)]; }
+            inline bool Has(VertexAttribute attribute) const { return Type(attribute) != AttributeType::NONE; }
+            inline const std::array<AttributeType , kNumVertexAttributes>& Types() const { return types; }
+            inline uint32_t Stride() const { return stride; }
+
+            inline bool operator==(const VertexFormat& other) const { return types == other.types; }
+            inline bool operator!=(const VertexFormat& other) const { return types != other.types; }
+    };
+
+}
+
+#endif // !YE_VERTEX_FORMAT_HPP
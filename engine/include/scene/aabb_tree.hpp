@@ -0,0 +1,170 @@
+#ifndef YE_AABB_TREE_HPP
+#define YE_AABB_TREE_HPP
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <entt/entt.hpp>
+
+#include "rendering/bounds.hpp"
+
+namespace YE {
+
+    static constexpr int32_t kNullTreeNode = -1;
+
+    // leaves are stored fattened by this much so small movements do not touch the tree at all
+    static constexpr float kAABBTreeMargin = 0.1f;
+
+    // number of centroid bins the surface area heuristic evaluates during a rebuild
+    static constexpr uint32_t kAABBTreeSahBins = 12;
+
+    // leaves Optimize reinserts per call , the rest stay refitted in place until a later frame
+    static constexpr uint32_t kAABBTreeReinsertBudget = 256;
+
+    struct AABBTreeNode {
+        AABB aabb;
+        AABB tight;
+        entt::entity entity = entt::null;
+
+        // free nodes reuse parent as the next link of the free list
+        int32_t parent = kNullTreeNode;
+        int32_t left = kNullTreeNode;
+        int32_t right = kNullTreeNode;
+
+        // leaves are 0 , free nodes -1
+        int32_t height = -1;
+
+        // leaf was refitted in place and is waiting for Optimize to find it a better sibling
+        bool stale = false;
+
+        inline bool IsLeaf() const { return left == kNullTreeNode; }
+    };
+
+    struct RayHit {
+        entt::entity entity = entt::null;
+        float distance = 0.f;
+    };
+
+    /// \note dynamic bounding volume hierarchy over entity bounds. proxies are inserted with a fattened box
+    ///     so most movers cost a containment check , a leaf that escapes its fat box is refitted in place by
+    ///     walking its ancestors and queued for Optimize , which reinserts a bounded number of them per frame.
+    ///     inserts pick the sibling that grows the tree's surface area least and rotate ancestors to stay
+    ///     balanced , Rebuild throws that away and builds the whole tree top down with a binned surface area
+    ///     heuristic
+    class AABBTree {
+
+        std::vector<AABBTreeNode> nodes;
+        std::vector<int32_t> stale_leaves;
+        int32_t root = kNullTreeNode;
+        int32_t free_list = kNullTreeNode;
+        uint32_t num_proxies = 0;
+
+        // traversal stack that only touches the heap for unusually deep trees
+        class NodeStack {
+            std::array<int32_t , 128> local;
+            std::vector<int32_t> overflow;
+            uint32_t count = 0;
+
+            public:
+                inline void Push(int32_t node) {
+                    if (count < local.size()) {
+                        local[count] = node;
+                    } else {
+                        overflow.push_back(node);
+                    }
+                    ++count;
+                }
+
+                inline int32_t Pop() {
+                    --count;
+                    if (count < local.size())
+                        return local[count];
+
+                    int32_t node = overflow.back();
+                    overflow.pop_back();
+                    return node;
+                }
+
+                inline bool Empty() const { return count == 0; }
+        };
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t node);
+
+        void InsertLeaf(int32_t leaf);
+        void RemoveLeaf(int32_t leaf);
+        void RefitAncestors(int32_t node);
+        int32_t Balance(int32_t node);
+
+        int32_t BuildRange(int32_t* leaves , uint32_t count);
+
+        /// \note visits every leaf whose fat and tight boxes pass overlaps , fn(entity) returns false to stop
+        template <typename Overlaps , typename Fn>
+        void Traverse(Overlaps&& overlaps , Fn&& fn) const {
+            if (root == kNullTreeNode) return;
+
+            NodeStack stack;
+            stack.Push(root);
+
+            while (!stack.Empty()) {
+                const AABBTreeNode& node = nodes[stack.Pop()];
+                if (!overlaps(node.aabb)) continue;
+
+                if (node.IsLeaf()) {
+                    if (overlaps(node.tight) && !fn(node.entity))
+                        return;
+                } else {
+                    stack.Push(node.left);
+                    stack.Push(node.right);
+                }
+            }
+        }
+
+        public:
+            AABBTree() {}
+            ~AABBTree() {}
+
+            int32_t CreateProxy(const AABB& aabb , entt::entity entity);
+            void DestroyProxy(int32_t proxy);
+
+            /// \note returns true when the leaf escaped its fat box and the tree was refitted
+            bool MoveProxy(int32_t proxy , const AABB& aabb);
+
+            /// \note reinserts up to max_reinserts leaves that were refitted in place since the last call
+            void Optimize(uint32_t max_reinserts = kAABBTreeReinsertBudget);
+            void Rebuild();
+            void Clear();
+
+            template <typename Fn>
+            void Query(const AABB& aabb , Fn&& fn) const {
+                Traverse([&aabb](const AABB& box) { return box.Intersects(aabb); } , fn);
+            }
+
+            template <typename Fn>
+            void Query(const BoundingSphere& sphere , Fn&& fn) const {
+                Traverse([&sphere](const AABB& box) { return Intersects(sphere , box); } , fn);
+            }
+
+            template <typename Fn>
+            void Query(const Frustum& frustum , Fn&& fn) const {
+                Traverse([&frustum](const AABB& box) { return frustum.Intersects(box); } , fn);
+            }
+
+            /// \note closest entity whose bounds the ray enters within max_distance
+            bool RayCast(const glm::vec3& origin , const glm::vec3& direction , float max_distance , RayHit& hit) const;
+
+            void Query(const AABB& aabb , std::vector<entt::entity>& result) const;
+            void Query(const BoundingSphere& sphere , std::vector<entt::entity>& result) const;
+            void Query(const Frustum& frustum , std::vector<entt::entity>& result) const;
+
+            inline const AABB& FatBounds(int32_t proxy) const { return nodes[proxy].aabb; }
+            inline entt::entity Entity(int32_t proxy) const { return nodes[proxy].entity; }
+            inline int32_t Height() const { return root == kNullTreeNode ? 0 : nodes[root].height; }
+            inline uint32_t NumProxies() const { return num_proxies; }
+    };
+
+}
+
+#endif // !YE_AABB_TREE_HPP
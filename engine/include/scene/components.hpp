@@ -14,6 +14,7 @@
 #include "native_script_entity.hpp"
 #include "core/UUID.hpp"
 #include "core/RNG.hpp"
+#include "rendering/bounds.hpp"
 #include "rendering/vertex_array.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/texture.hpp"
@@ -54,16 +55,35 @@ namespace components {
         glm::vec3 scale = glm::vec3(1.0f);
         glm::vec3 rotation = glm::vec3(1.0f);
 
+        // world space matrix , parent world * local
         glm::mat4 model = glm::mat4(1.0f);
 
+        /// \note the local matrix and the values it was last built from, the transform system
+        ///     compares against these so only transforms that actually moved are rebuilt
+        glm::mat4 local = glm::mat4(1.0f);
+        glm::vec3 cached_position = glm::vec3(0.0f);
+        glm::vec3 cached_scale = glm::vec3(1.0f);
+        glm::vec3 cached_rotation = glm::vec3(1.0f);
+
+        // local needs to be rebuilt regardless of the cached values
+        bool dirty = true;
+        // world matrix was recomputed this frame
+        bool changed = false;
+
         glm::mat4& Model();
         glm::quat RotationQuat() const { return glm::quat(rotation); }
 
+        inline void MarkDirty() { dirty = true; }
+        inline bool NeedsUpdate() const {
+            return dirty || position != cached_position || 
+                   rotation != cached_rotation || scale != cached_scale;
+        }
+
         Transform() {}
         Transform(const Transform& other) 
             : position(other.position) , scale(other.scale) ,
             rotation(other.rotation) ,
-            model(other.model) {} 
+            model(other.model) , local(other.local) {} 
         Transform(const glm::vec3& pos , const glm::vec3& scale ,
                   const glm::vec3& rotation);
     };
@@ -73,15 +93,24 @@ namespace components {
         Material material;
         Shader* shader = nullptr;
         std::string shader_name;
+        // resolved once from shader_name , reloads only go back to the name when the handle goes stale
+        ShaderHandle shader_handle;
 
         bool corrupted = false;
 
+        // retained draw state , copies start unsubmitted so they get their own record in the renderer
+        bool submitted = false;
+        UUID draw_id = 0;
+        bool dirty = true;
+
         Renderable() {}
         Renderable(const Renderable& other) 
-            : vao(other.vao) , shader_name(other.shader_name) , 
-            material(other.material) , corrupted(other.corrupted) {}
+            : vao(other.vao) , material(other.material) , shader_name(other.shader_name) , 
+            shader_handle(other.shader_handle) , corrupted(other.corrupted) {}
         Renderable(VertexArray* vao , Material material , const std::string& shader_name)
             : vao(vao) , material(material) , shader_name(shader_name) {}
+
+        inline void MarkDirty() { dirty = true; }
     };
 
     struct TexturedRenderable {
@@ -89,18 +118,43 @@ namespace components {
         Shader* shader = nullptr;
         Material material;
         std::string shader_name;
+        ShaderHandle shader_handle;
         std::vector<Texture*> textures{};
 
         bool corrupted = false;
 
+        bool submitted = false;
+        UUID draw_id = 0;
+        bool dirty = true;
+
         TexturedRenderable() {}
         TexturedRenderable(const TexturedRenderable& other) 
-            : vao(other.vao) , shader_name(other.shader_name) , textures(other.textures) ,
-            corrupted(other.corrupted) {}
+            : vao(other.vao) , shader_name(other.shader_name) , shader_handle(other.shader_handle) , 
+            textures(other.textures) , corrupted(other.corrupted) {}
         TexturedRenderable(VertexArray* vao , Material material , const std::string& shader_name , 
                            const std::vector<Texture*>& textures) 
             : vao(vao) , material(material) , 
             shader_name(shader_name) , textures(textures) {}
+
+        inline void MarkDirty() { dirty = true; }
+    };
+
+    /// \note bounds of everything an entity draws , local is the union of its meshes and world follows
+    ///     the transform. visible holds the result of the last frustum test
+    struct Bounds {
+        AABB local;
+        AABB world;
+        BoundingSphere sphere;
+
+        bool visible = true;
+        bool visibility_changed = false;
+
+        // leaf in the scene's spatial tree , -1 until the world box is valid
+        int32_t tree_proxy = -1;
+
+        Bounds() {}
+        Bounds(const AABB& local)
+            : local(local) {}
     };
 
     struct CubeMapRenderable {
@@ -116,14 +170,26 @@ namespace components {
         Material material;
         std::string model_name = "";
         std::string shader_name = "";
+        ModelHandle model_handle;
+        ShaderHandle shader_handle;
+
+        // picked every frame from the projected size of the entity's bounds
+        uint32_t lod = 0;
 
         bool corrupted = false;
 
+        bool submitted = false;
+        UUID draw_id = 0;
+        bool dirty = true;
+
         RenderableModel() {}
         RenderableModel(const RenderableModel& other) 
-            : model(other.model) , shader_name(other.shader_name) , corrupted(other.corrupted) {}
+            : model(other.model) , shader_name(other.shader_name) , model_handle(other.model_handle) , 
+            shader_handle(other.shader_handle) , corrupted(other.corrupted) {}
         RenderableModel(Material material , const std::string& model_name , const std::string& shader_name) 
             : material(material) , model_name(model_name) , shader_name(shader_name) {}
+
+        inline void MarkDirty() { dirty = true; }
     };
 
     struct DirectionalLight {
@@ -256,13 +322,16 @@ namespace components {
         rp3d::ConvexMeshShape* shape = nullptr;
         rp3d::Collider* collider = nullptr;
 
+        // set when the model never produced vertex data , the collider is not retried
+        bool failed = false;
+
         uint32_t num_faces = 0;
         std::vector<float> vertices{};
         std::vector<uint32_t> indices{};
 
         MeshCollider() {}
         MeshCollider(const MeshCollider& other) 
-            : mesh(other.mesh) , shape(other.shape) , collider(other.collider) {}
+            : mesh(other.mesh) , shape(other.shape) , collider(other.collider) , failed(other.failed) {}
         MeshCollider(const std::vector<float>& vertices , const std::vector<uint32_t>& indices , uint32_t num_faces)
             : vertices(vertices) , indices(indices) {}
     };
@@ -10,12 +10,11 @@
 
 #include "log.hpp"
 #include "systems.hpp"
+#include "aabb_tree.hpp"
 #include "core/RNG.hpp"
 #include "core/UUID.hpp"
 #include "rendering/renderer.hpp"
 
-constexpr uint32_t kMaxPointLights = 128;
-
 namespace YE {
 
 namespace components {
@@ -36,6 +35,11 @@ namespace components {
     class Texture;
     class Camera;
 
+    struct TransformNode {
+        entt::entity entity = entt::null;
+        entt::entity parent = entt::null;
+    };
+
     template<typename T>
     using SceneMapU64 = typename std::unordered_map<UUID , T*>;
 
@@ -51,6 +55,19 @@ namespace components {
 
         std::vector<UUID> living_entities;
 
+        // parents always come before their children
+        std::vector<TransformNode> transform_order;
+        std::vector<entt::entity> changed_transforms;
+
+        // entities with bounds , gathered each frame for the frustum test
+        std::vector<entt::entity> cull_entities;
+
+        // scratch for Systems::ParallelEach , reused by every parallel pass in Update
+        std::vector<entt::entity> each_entities;
+        bool hierarchy_dirty = true;
+
+        AABBTree spatial_tree;
+
         Camera* active_camera = nullptr;
         UUID32 active_camera_id = 0;
         RenderMode current_render_mode = RenderMode::FILL;
@@ -62,6 +79,10 @@ namespace components {
         std::string scene_name = "[Blank Scene]";
         UUID scene_id = 0;
 
+        // unique per scene for the life of the process , names can repeat so ids built from them would collide
+        inline static uint32_t next_draw_tag = 1;
+        uint32_t draw_tag = 0;
+
         bool render_debug = false;
 
         friend class Entity;
@@ -70,7 +91,7 @@ namespace components {
 
         public:
             Scene(const std::string& name)
-                : scene_name(name) , scene_id(Hash::FNV(name)) {}
+                : scene_name(name) , scene_id(Hash::FNV(name)) , draw_tag(next_draw_tag++) {}
             ~Scene() {}
 
             Entity* CreateEntity(const std::string& name = "[Blank Entity]");
@@ -105,8 +126,15 @@ namespace components {
 
             inline std::string SceneName() const { return scene_name; }
             inline entt::registry& Registry() { return registry; }
+            inline void MarkHierarchyDirty() { hierarchy_dirty = true; }
+            /// \note entities whose world matrix was recomputed during the last Update
+            inline const std::vector<entt::entity>& ChangedTransforms() const { return changed_transforms; }
+            /// \note world bounds of every entity with a renderable , for ray , box , sphere and frustum queries
+            inline const AABBTree& SpatialTree() const { return spatial_tree; }
             inline Camera* ActiveCamera() { return active_camera; }
             inline UUID SceneID() const { return sceneID; }
+            /// \note upper bits of every persistent draw id this scene's renderables register with the renderer
+            inline uint32_t DrawTag() const { return draw_tag; }
             inline void ActivateDebug() { render_debug = true; }
             inline void DeactivateDebug() { render_debug = false; }
 
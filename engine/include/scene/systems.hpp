@@ -1,8 +1,14 @@
 #ifndef YE_SYSTEMS_HPP
 #define YE_SYSTEMS_HPP
 
+#include <vector>
+
 #include <entt/entt.hpp>
 
+#include "core/UUID.hpp"
+#include "core/task_manager.hpp"
+#include "core/resource_handle.hpp"
+
 namespace YE {
 
 namespace components {
@@ -19,6 +25,7 @@ namespace components {
     class Shader;
     class Entity;
     class Scene;
+    class Camera;
 
     using EntityConstructSignal = entt::sigh<void(entt::registry& registry , entt::entity entity)>;
     using EntityCreatedSignal = entt::sigh<void(Scene* context , const std::string&)>;
@@ -57,8 +64,34 @@ namespace components {
     using RenderableModelUpdateSignal = entt::sigh<void(components::RenderableModel& renderable , const std::vector<components::PointLight>& lights)>;
     using RenderableModelUpdateSink = entt::sink<RenderableModelUpdateSignal>;
 
+    enum class RenderableKind : uint32_t {
+        RENDERABLE = 0 ,
+        TEXTURED = 1 ,
+        MODEL = 2
+    };
+
+    // id of an entity's persistent draw in the renderer. the scene's draw tag keeps two scenes from sharing
+    // records , the kind gives an entity carrying more than one renderable component one record per component
+    // and the full entity (index and version) keeps a recycled index from picking up a destroyed entity's draw
+    //      [ scene draw tag : 24 | kind : 8 | entity : 32 ]
+    inline UUID RenderableID(uint32_t scene_tag , entt::entity entity , RenderableKind kind) {
+        return UUID{ 
+            (static_cast<uint64_t>(scene_tag & 0xFFFFFF) << 40) | (static_cast<uint64_t>(kind) << 32) | 
+            static_cast<uint64_t>(entt::to_integral(entity)) 
+        };
+    }
+
+    static constexpr uint32_t kDefaultEachGrain = 256;
+    static constexpr uint32_t kTransformEachGrain = 1024;
+    static constexpr uint32_t kPhysicsEachGrain = 128;
+    static constexpr uint32_t kCullEachGrain = 2048;
+
+    // boxes gathered per frustum test call , small enough to live on the stack of each task
+    static constexpr uint32_t kCullBatchSize = 64;
+
     class Systems {
-        static void LoadShader(Shader *& shader , const std::string& entity_name , const std::string& shader_name , bool& corrupted);
+        static void LoadShader(Shader *& shader , ShaderHandle& handle , const std::string& entity_name , 
+                               const std::string& shader_name , bool& corrupted);
 
         public:
             static EntityCreatedSignal entity_created_signal;
@@ -76,6 +109,32 @@ namespace components {
 
             static void Initialize();
 
+            /// \note partitions the entities of view into chunks of grain entities and runs
+            ///     fn(components...) over them on the task manager, blocks until every chunk is done
+            ///     (the calling thread helps out) , fn must be safe to call from multiple threads.
+            ///     entities is caller owned scratch so the entity list is not reallocated every call
+            template<typename... Components , typename View , typename Fn>
+            static void ParallelEach(std::vector<entt::entity>& entities , View& view , Fn&& fn , uint32_t grain = kDefaultEachGrain) {
+                entities.assign(view.begin() , view.end());
+                const uint32_t count = static_cast<uint32_t>(entities.size());
+                if (count == 0) return;
+
+                if (count <= grain) {
+                    for (auto entity : entities)
+                        fn(view.template get<Components>(entity)...);
+                    return;
+                }
+
+                TaskManager* task_manager = TaskManager::Instance();
+                JobHandle handle = task_manager->DispatchParallel(count , grain , 
+                    [&view , &fn , &entities](uint32_t begin , uint32_t end) {
+                        for (uint32_t i = begin; i < end; ++i)
+                            fn(view.template get<Components>(entities[i])...);
+                    }
+                );
+                task_manager->WaitFor(handle);
+            }
+
             static void SetSceneContext(Scene* context);
 
             static void EntityConstructed(entt::registry& registry , entt::entity entity);
@@ -87,23 +146,37 @@ namespace components {
             static void SphereColliderCreated(entt::registry& registry , entt::entity entity);
             static void CapsuleColliderCreated(entt::registry& registry , entt::entity entity);
             static void MeshColliderCreated(entt::registry& registry , entt::entity entity);
+            static void BuildPendingColliders(Scene* context);
 
             static void LoadShaders(Scene* context);
+            static void RebindReloaded(Scene* context);
 
             static void BindScripts(Scene* context);
             
             static void UpdateScene(Scene* context , float dt);
 
+            static void BuildTransformOrder(Scene* context);
+            static void ResetChangedTransforms(Scene* context);
+            static void PropagateTransforms(Scene* context);
+            static void UpdateBounds(Scene* context);
+            static void CullRenderables(Scene* context , Camera* camera);
+            static void SelectLods(Scene* context , Camera* camera);
+
             static void UpdateTransform(components::Transform& transform);
             static void UpdatePhysicsBody(components::PhysicsBody& body , components::Transform& transform);
             static void UpdateRenderable(components::Renderable& renderable , const std::vector<components::PointLight>& lights);
             static void UpdateTexturedRenderable(components::TexturedRenderable& renderable , const std::vector<components::PointLight>& lights);
             static void UpdateRenderableModel(components::RenderableModel& renderable , const std::vector<components::PointLight>& lights);
 
+            static void SyncRenderables(Scene* context);
+            static void RemoveRenderables(Scene* context);
+
             static void UnbindScripts(Scene* context);
 
             static void EntityDestroyed(Scene* context , Entity* entity);
-            static void ModelDestroyed(entt::registry& registry , entt::entity entity);
+            static void RenderableDestroyed(Scene& context , entt::registry& registry , entt::entity entity);
+            static void TexturedRenderableDestroyed(Scene& context , entt::registry& registry , entt::entity entity);
+            static void ModelDestroyed(Scene& context , entt::registry& registry , entt::entity entity);
             static void PhysicsBodyDestroyed(entt::registry& context , entt::entity entity);
             static void BoxColliderDestroyed(entt::registry& context , entt::entity entity);
             static void SphereColliderDestroyed(entt::registry& context , entt::entity entity);
@@ -161,6 +161,13 @@ namespace ScriptInternalCalls {
     uint64_t GetEntityByName(MonoString* name);
     ///////////////////////////
 
+    /// \section Spatial Query Functions
+    MonoArray* QueryEntitiesInBox(glm::vec3* min , glm::vec3* max);
+    MonoArray* QueryEntitiesInSphere(glm::vec3* center , float radius);
+    MonoArray* QueryEntitiesInFrustum(uint32_t camera_id);
+    bool RayCastEntities(glm::vec3* origin , glm::vec3* direction , float max_distance , uint64_t* entity_id , float* distance);
+    ///////////////////////////////////////////
+
     /// \section Keyboard Functions
     uint32_t KeyFramesHeld(uint32_t key);
     bool IsKeyPressed(uint32_t key);
@@ -40,10 +40,6 @@ namespace EngineY {
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     /// Engine Functions ////////////////////////////////////////////////////////////////////////////////////////////////////
-    void DispatchEvent(YE::Event* event) {
-        YE::EventManager::Instance()->DispatchEvent(event);
-    }
-    
     void ShaderReload() {
         YE::ResourceHandler::Instance()->ReloadShaders();
     }
@@ -0,0 +1,115 @@
+#include "core/asset_loader.hpp"
+
+#include <chrono>
+#include <limits>
+#include <algorithm>
+
+#include "log.hpp"
+
+namespace YE {
+
+    void AssetLoader::LoaderLoop() {
+        while (true) {
+            AssetRequest request;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                request_condition.wait(lock , [this]() { return !running || !requests.empty(); });
+                if (!running) return;
+
+                request = std::move(requests.front());
+                requests.pop_front();
+            }
+
+            if (!request.decode()) {
+                YE_WARN("Failed to load asset :: [{0}] | Decode failed" , request.name);
+                pending.fetch_sub(1 , std::memory_order_acq_rel);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            space_condition.wait(lock , [this]() { return !running || uploads.size() < upload_capacity; });
+            if (!running) return;
+
+            uploads.push_back(std::move(request));
+        }
+    }
+
+    AssetLoader::AssetLoader(uint32_t num_threads , uint32_t upload_capacity)
+            : upload_capacity(std::max(upload_capacity , 1u)) {
+        if (num_threads == 0)
+            num_threads = std::max(std::thread::hardware_concurrency() / 2 , 1u);
+
+        running = true;
+        threads.reserve(num_threads);
+        for (uint32_t i = 0; i < num_threads; ++i)
+            threads.emplace_back(&AssetLoader::LoaderLoop , this);
+    }
+
+    AssetLoader::~AssetLoader() {
+        Stop();
+    }
+
+    void AssetLoader::Enqueue(AssetRequest&& request) {
+        pending.fetch_add(1 , std::memory_order_acq_rel);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            requests.push_back(std::move(request));
+        }
+        request_condition.notify_one();
+    }
+
+    uint32_t AssetLoader::ProcessUploads(float budget) {
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+
+        uint32_t num_uploaded = 0;
+        while (true) {
+            AssetRequest request;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (uploads.empty()) break;
+
+                request = std::move(uploads.front());
+                uploads.pop_front();
+            }
+            space_condition.notify_one();
+
+            request.upload();
+            pending.fetch_sub(1 , std::memory_order_acq_rel);
+            ++num_uploaded;
+
+            std::chrono::duration<float , std::milli> elapsed = Clock::now() - start;
+            if (elapsed.count() >= budget) break;
+        }
+
+        return num_uploaded;
+    }
+
+    void AssetLoader::Finish() {
+        while (Loading()) {
+            if (ProcessUploads(std::numeric_limits<float>::max()) == 0)
+                std::this_thread::yield();
+        }
+    }
+
+    void AssetLoader::Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running && threads.empty()) return;
+
+            running = false;
+            pending.fetch_sub(static_cast<uint32_t>(requests.size() + uploads.size()) , std::memory_order_acq_rel);
+            requests.clear();
+            uploads.clear();
+        }
+        request_condition.notify_all();
+        space_condition.notify_all();
+
+        for (auto& thread : threads)
+            if (thread.joinable()) thread.join();
+        threads.clear();
+
+        pending.store(0 , std::memory_order_release);
+    }
+
+}
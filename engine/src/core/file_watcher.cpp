@@ -0,0 +1,183 @@
+#include "core/file_watcher.hpp"
+
+#include <algorithm>
+#include <system_error>
+
+#ifdef YE_PLATFORM_LINUX
+    #include <poll.h>
+    #include <unistd.h>
+    #include <sys/inotify.h>
+#endif // !YE_PLATFORM_LINUX
+
+#include "log.hpp"
+
+namespace YE {
+
+    static std::string GenericPath(const std::filesystem::path& path) {
+        std::string str = path.string();
+        std::replace(str.begin() , str.end() , '\\' , '/');
+        return str;
+    }
+
+    FileWatcher::~FileWatcher() {
+        Stop();
+    }
+
+    void FileWatcher::Record(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        changes[path] = Clock::now();
+    }
+
+#ifdef YE_PLATFORM_LINUX
+    void FileWatcher::AddWatch(const std::string& directory) {
+        // close_write covers saves in place , moved_to covers editors that write a temporary and rename it
+        int wd = inotify_add_watch(inotify_fd , directory.c_str() , IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd < 0) {
+            YE_WARN("Failed to watch directory :: [{0}]" , directory);
+            return;
+        }
+        watches[wd] = directory;
+    }
+
+    bool FileWatcher::Start() {
+        if (Running()) return true;
+
+        inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd < 0) {
+            YE_WARN("Failed to start file watcher :: inotify unavailable");
+            return false;
+        }
+
+        for (const auto& directory : directories) {
+            AddWatch(directory);
+
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(directory , ec)) {
+                if (entry.is_directory(ec))
+                    AddWatch(GenericPath(entry.path()));
+            }
+        }
+
+        running.store(true , std::memory_order_release);
+        thread = std::thread(&FileWatcher::WatchLoop , this);
+        return true;
+    }
+
+    void FileWatcher::WatchLoop() {
+        alignas(inotify_event) char buffer[4096];
+
+        pollfd descriptor{ inotify_fd , POLLIN , 0 };
+        while (running.load(std::memory_order_acquire)) {
+            if (poll(&descriptor , 1 , kFileWatchInterval) <= 0) continue;
+
+            ssize_t length = 0;
+            while ((length = read(inotify_fd , buffer , sizeof(buffer))) > 0) {
+                for (char* ptr = buffer; ptr < buffer + length; ) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+                    ptr += sizeof(inotify_event) + event->len;
+
+                    auto itr = watches.find(event->wd);
+                    if (event->len == 0 || itr == watches.end()) continue;
+
+                    const std::string path = itr->second + "/" + event->name;
+                    if (event->mask & IN_ISDIR) {
+                        // new subdirectories are watched from here on , files already in them are missed
+                        if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                            AddWatch(path);
+                        continue;
+                    }
+
+                    // a created file is reported once it has been written and closed
+                    if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                        Record(path);
+                }
+            }
+        }
+    }
+
+    void FileWatcher::Stop() {
+        if (!running.exchange(false , std::memory_order_acq_rel)) return;
+
+        if (thread.joinable())
+            thread.join();
+
+        close(inotify_fd);
+        inotify_fd = -1;
+        watches.clear();
+    }
+#else
+    void FileWatcher::Scan(bool record) {
+        for (const auto& directory : directories) {
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(directory , ec)) {
+                if (!entry.is_regular_file(ec)) continue;
+
+                const std::filesystem::file_time_type time = entry.last_write_time(ec);
+                if (ec) continue;
+
+                const std::string path = GenericPath(entry.path());
+                auto [itr , inserted] = write_times.try_emplace(path , time);
+                if (!inserted && itr->second != time) {
+                    itr->second = time;
+                    if (record) Record(path);
+                } else if (inserted && record) {
+                    Record(path);
+                }
+            }
+        }
+    }
+
+    bool FileWatcher::Start() {
+        if (Running()) return true;
+
+        // the first scan only learns the current write times
+        Scan(false);
+
+        running.store(true , std::memory_order_release);
+        thread = std::thread(&FileWatcher::WatchLoop , this);
+        return true;
+    }
+
+    void FileWatcher::WatchLoop() {
+        while (running.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kFileWatchInterval));
+            Scan(true);
+        }
+    }
+
+    void FileWatcher::Stop() {
+        if (!running.exchange(false , std::memory_order_acq_rel)) return;
+
+        if (thread.joinable())
+            thread.join();
+
+        write_times.clear();
+    }
+#endif // !YE_PLATFORM_LINUX
+
+    void FileWatcher::Watch(const std::string& directory) {
+        if (Running()) return;
+
+        std::error_code ec;
+        if (!std::filesystem::is_directory(directory , ec)) return;
+
+        directories.push_back(GenericPath(directory));
+    }
+
+    void FileWatcher::Poll(std::vector<std::string>& paths) {
+        const Clock::time_point now = Clock::now();
+        const auto settle = std::chrono::milliseconds(kFileWatchSettleTime);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto itr = changes.begin(); itr != changes.end(); ) {
+            if (now - itr->second < settle) {
+                ++itr;
+                continue;
+            }
+
+            paths.push_back(itr->first);
+            itr = changes.erase(itr);
+        }
+    }
+
+}
@@ -0,0 +1,67 @@
+#include "core/frame_arena.hpp"
+
+#include <algorithm>
+
+#include "log.hpp"
+
+namespace YE {
+
+    static inline uintptr_t AlignUp(uintptr_t value , size_t alignment) {
+        return (value + (alignment - 1)) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+
+    void* FrameArena::AllocateOverflow(size_t size , size_t alignment) {
+        uint8_t* block = ynew uint8_t[size + alignment];
+        overflow_blocks.push_back(block);
+        overflow_bytes += size + alignment;
+
+        return reinterpret_cast<void*>(AlignUp(reinterpret_cast<uintptr_t>(block) , alignment));
+    }
+
+    FrameArena::FrameArena(size_t capacity)
+            : capacity(capacity) {
+        memory = ynew uint8_t[capacity];
+    }
+
+    FrameArena::~FrameArena() {
+        for (auto* block : overflow_blocks)
+            ydelete[] block;
+        overflow_blocks.clear();
+
+        ydelete[] memory;
+    }
+
+    void* FrameArena::Allocate(size_t size , size_t alignment) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(memory);
+        uintptr_t aligned = AlignUp(base + offset , alignment);
+        size_t end = static_cast<size_t>(aligned - base) + size;
+
+        if (end > capacity)
+            return AllocateOverflow(size , alignment);
+
+        offset = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void FrameArena::Reset() {
+        high_water = std::max(high_water , Used());
+
+        if (!overflow_blocks.empty()) {
+            for (auto* block : overflow_blocks)
+                ydelete[] block;
+            overflow_blocks.clear();
+
+            // grow once to cover the whole frame instead of overflowing again next time
+            size_t new_capacity = std::max(capacity * 2 , high_water + high_water / 2);
+            YE_WARN("Frame arena overflowed by {0} bytes | Growing from {1} to {2} bytes" , overflow_bytes , capacity , new_capacity);
+
+            ydelete[] memory;
+            memory = ynew uint8_t[new_capacity];
+            capacity = new_capacity;
+        }
+
+        offset = 0;
+        overflow_bytes = 0;
+    }
+
+}
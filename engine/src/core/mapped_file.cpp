@@ -0,0 +1,105 @@
+#include "core/mapped_file.hpp"
+
+#ifdef YE_PLATFORM_WIN
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif // !YE_PLATFORM_WIN
+
+#include "log.hpp"
+
+namespace YE {
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+#ifdef YE_PLATFORM_WIN
+    bool MappedFile::Open(const std::string& path) {
+        Close();
+
+        HANDLE file = CreateFileA(path.c_str() , GENERIC_READ , FILE_SHARE_READ , nullptr , OPEN_EXISTING , 
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN , nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file , &file_size) || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file , nullptr , PAGE_READONLY , 0 , 0 , nullptr);
+        if (mapping == nullptr) {
+            YE_ERROR("Failed to map file :: [{0}] | CreateFileMapping failed" , path);
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping , FILE_MAP_READ , 0 , 0 , 0);
+        if (view == nullptr) {
+            YE_ERROR("Failed to map file :: [{0}] | MapViewOfFile failed" , path);
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        file_handle = file;
+        mapping_handle = mapping;
+        data = static_cast<const uint8_t*>(view);
+        size = static_cast<size_t>(file_size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (data != nullptr) UnmapViewOfFile(data);
+        if (mapping_handle != nullptr) CloseHandle(mapping_handle);
+        if (file_handle != nullptr) CloseHandle(file_handle);
+
+        data = nullptr;
+        size = 0;
+        mapping_handle = nullptr;
+        file_handle = nullptr;
+    }
+#else
+    bool MappedFile::Open(const std::string& path) {
+        Close();
+
+        int fd = open(path.c_str() , O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd , &info) != 0 || info.st_size == 0) {
+            close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr , static_cast<size_t>(info.st_size) , PROT_READ , MAP_PRIVATE , fd , 0);
+        if (view == MAP_FAILED) {
+            YE_ERROR("Failed to map file :: [{0}] | mmap failed" , path);
+            close(fd);
+            return false;
+        }
+
+        // the whole file is about to be streamed into GL buffers front to back
+        madvise(view , static_cast<size_t>(info.st_size) , MADV_WILLNEED);
+
+        file_descriptor = fd;
+        data = static_cast<const uint8_t*>(view);
+        size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (data != nullptr) munmap(const_cast<uint8_t*>(data) , size);
+        if (file_descriptor >= 0) close(file_descriptor);
+
+        data = nullptr;
+        size = 0;
+        file_descriptor = -1;
+    }
+#endif // !YE_PLATFORM_WIN
+
+}
@@ -1,11 +1,15 @@
 #include "core/resource_handler.hpp"
 
+#include <chrono>
+#include <algorithm>
+
 #include <stb_image.h>
 
 #include "log.hpp"
 #include "core/filesystem.hpp"
 #include "core/task_manager.hpp"
 #include "core/primitive_vao_data.hpp"
+#include "rendering/renderer.hpp"
 
 namespace YE {
 
@@ -72,7 +76,7 @@ namespace YE {
             if (entry.path().extension() != ".png" && entry.path().extension() != ".jpg" &&
                 entry.path().extension() != ".jpeg") continue;
 
-            UUID id = Hash::FNV(entry.path().filename().string());
+            UUID id = Hash::FNV(entry.path().stem().string());
             TextureResource texture;
             texture.name = entry.path().stem().string();
             texture.filename = entry.path().filename().string();
@@ -95,11 +99,13 @@ namespace YE {
         VertexArrayResource quad_vao;
         quad_vao.name = "quad";
         quad_vao.vao = ynew VertexArray(primitives::quad_verts , primitives::quad_indices);
+        quad_vao.handle = vao_pool.Insert(quad_vao.vao);
         vaos[Hash::FNV(quad_vao.name)] = quad_vao;
 
         VertexArrayResource cube_vao;
         cube_vao.name = "cube";
         cube_vao.vao = ynew VertexArray(primitives::cube_verts , {});
+        cube_vao.handle = vao_pool.Insert(cube_vao.vao);
         vaos[Hash::FNV(cube_vao.name)] = cube_vao;
     }
 
@@ -113,7 +119,7 @@ namespace YE {
         // for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
         //     if (entry.path().extension() != ".obj") continue;
 
-        //     UUID id = Hash::FNV(entry.path().filename().string());
+        //     UUID id = Hash::FNV(entry.path().stem().string());
         //     ModelResource model;
         //     model.name = entry.path().stem().string();
         //     model.filename = entry.path().filename().string();
@@ -124,6 +130,10 @@ namespace YE {
     }
 
     void ResourceHandler::CompileShaders(ResourceMap<ShaderResource>& shaders) {
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+
+        uint32_t num_cached = 0;
         for (auto& [id , shader] : shaders) {
             Shader* s = nullptr;
             if (shader.has_geom) {
@@ -138,17 +148,29 @@ namespace YE {
                 s = nullptr;
             } else {
                 s->SetName(shader.name);
+                shader.handle = shader_pool.Insert(s);
+                if (s->FromCache())
+                    ++num_cached;
             }
             shader.shader = s;
         }
+
+        std::chrono::duration<float , std::milli> elapsed = Clock::now() - start;
+        YE_DEBUG("Shaders :: {0} programs in {1:.2f} ms | {2} from the program cache" , shaders.size() , elapsed.count() , num_cached);
     }
 
     void ResourceHandler::LoadTextures(ResourceMap<TextureResource>& textures) {
         for (auto& [id , texture] : textures) {
             Texture* t = ynew Texture(texture.path);
-            t->Load(texture.target , texture.channels);
             t->SetName(texture.name);
             texture.texture = t;
+            texture.handle = texture_pool.Insert(t);
+
+            asset_loader->Enqueue(AssetRequest{
+                texture.path ,
+                [t]() { t->Decode(); return true; } ,
+                [this , t , target = texture.target , channels = texture.channels]() { t->Upload(target , channels , &texture_arrays); }
+            });
         }
     }
     
@@ -161,13 +183,20 @@ namespace YE {
     void ResourceHandler::LoadModels(ResourceMap<ModelResource>& models) {
         for (auto& [id , model] : models) {
             Model* m = ynew Model(model.name , model.path);
-            m->Load();
             model.model = m;
+            model.handle = model_pool.Insert(m);
+
+            asset_loader->Enqueue(AssetRequest{
+                model.path ,
+                [m]() { return m->Import(); } ,
+                [m]() { m->Upload(); }
+            });
         }
     }
     
     void ResourceHandler::CleanupShaders(ResourceMap<ShaderResource>& shaders) {
-        for (auto& [id , s] : engine_shaders) {
+        for (auto& [id , s] : shaders) {
+            shader_pool.Remove(s.handle);
             if (s.shader != nullptr) ydelete s.shader;
         }
         shaders.clear();
@@ -175,6 +204,7 @@ namespace YE {
 
     void ResourceHandler::CleanupTextures(ResourceMap<TextureResource>& textures) {
         for (auto& [id , t] : textures) {
+            texture_pool.Remove(t.handle);
             if (t.texture != nullptr) ydelete t.texture; 
         }
         textures.clear();
@@ -182,17 +212,170 @@ namespace YE {
     
     void ResourceHandler::CleanupPrimitiveVAOs(ResourceMap<VertexArrayResource>& vaos) {
         for (auto& [id , vao] : vaos) {
+            vao_pool.Remove(vao.handle);
             if (vao.vao != nullptr) ydelete vao.vao;
         }
         vaos.clear();
     }
 
     void ResourceHandler::CleanupModels(ResourceMap<ModelResource>& models) {
-        for (auto& [id , m] : models)
+        for (auto& [id , m] : models) {
+            model_pool.Remove(m.handle);
             if (m.model != nullptr) ydelete m.model;
+        }
         models.clear();
     }
 
+    void ResourceHandler::WatchResources() {
+        file_watcher = ynew FileWatcher;
+        for (const std::string* dir : { &engine_shader_dir , &engine_texture_dir , &engine_model_dir ,
+                                        &app_shader_dir , &app_texture_dir , &app_model_dir }) {
+            file_watcher->Watch(*dir);
+        }
+
+        if (!file_watcher->Start()) {
+            ydelete file_watcher;
+            file_watcher = nullptr;
+        }
+    }
+
+    void ResourceHandler::ProcessReloads() {
+        if (file_watcher == nullptr || asset_loader == nullptr) return;
+
+        ReleaseRetiredModels();
+
+        changed_files.clear();
+        file_watcher->Poll(changed_files);
+
+        // anything not registered as a resource (caches , bakes , temporaries) matches nothing
+        for (const auto& path : changed_files) {
+            HotReloadShaders(engine_shaders , path);
+            HotReloadShaders(app_shaders , path);
+            HotReloadTextures(engine_textures , path);
+            HotReloadTextures(app_textures , path);
+            HotReloadModels(engine_models , path);
+            HotReloadModels(app_models , path);
+        }
+    }
+
+    void ResourceHandler::HotReloadShaders(ResourceMap<ShaderResource>& shaders , const std::string& path) {
+        for (auto& [id , shader] : shaders) {
+            if (shader.reloading || (path != shader.vert_path && path != shader.frag_path && path != shader.geom_path))
+                continue;
+
+            // a shader that failed to compile on load gets its object here and joins the pool once it compiles
+            if (shader.shader == nullptr) {
+                if (shader.has_geom) {
+                    shader.shader = ynew Shader(shader.vert_path , shader.frag_path , shader.geom_path);
+                } else {
+                    shader.shader = ynew Shader(shader.vert_path , shader.frag_path);
+                }
+                shader.shader->SetName(shader.name);
+            }
+
+            Shader* s = shader.shader;
+            shader.reloading = true;
+
+            // GL only lives on this thread , the loader reads the sources and the compile runs at the upload
+            asset_loader->Enqueue(AssetRequest{
+                path ,
+                [s]() { s->ReadSources(); return true; } ,
+                [this , s , &shader]() {
+                    using Clock = std::chrono::steady_clock;
+                    const auto start = Clock::now();
+
+                    shader.reloading = false;
+                    if (!s->Recompile()) {
+                        YE_WARN("Failed to reload shader :: [{0}] | keeping the previous program" , shader.name);
+                        return;
+                    }
+
+                    if (shader.handle.Null())
+                        shader.handle = shader_pool.Insert(s);
+                    reloaded_shaders.push_back(s);
+
+                    std::chrono::duration<float , std::milli> elapsed = Clock::now() - start;
+                    YE_DEBUG("Reloaded shader [{0}] in {1:.2f} ms" , shader.name , elapsed.count());
+                }
+            });
+        }
+    }
+
+    void ResourceHandler::HotReloadTextures(ResourceMap<TextureResource>& textures , const std::string& path) {
+        for (auto& [id , texture] : textures) {
+            Texture* t = texture.texture;
+            if (texture.reloading || path != texture.path || t == nullptr || !t->Ready())
+                continue;
+
+            t->Invalidate();
+            texture.reloading = true;
+
+            asset_loader->Enqueue(AssetRequest{
+                path ,
+                [t]() { t->Decode(); return true; } ,
+                [this , t , &texture]() {
+                    texture.reloading = false;
+                    t->Reload(&texture_arrays);
+                    reloaded_textures.push_back(t);
+                }
+            });
+        }
+    }
+
+    void ResourceHandler::HotReloadModels(ResourceMap<ModelResource>& models , const std::string& path) {
+        for (auto& [id , model] : models) {
+            if (model.reloading || path != model.path) continue;
+
+            Model* m = ynew Model(model.name , model.path);
+            staged_models.push_back(m);
+            model.reloading = true;
+
+            // a failed import still comes back here so the guard is lifted on this thread
+            asset_loader->Enqueue(AssetRequest{
+                path ,
+                [m]() { m->Import(); return true; } ,
+                [this , m , &model]() {
+                    model.reloading = false;
+                    staged_models.erase(std::find(staged_models.begin() , staged_models.end() , m));
+
+                    m->Upload();
+                    if (!m->Valid()) {
+                        YE_WARN("Failed to reload model :: [{0}] | keeping the previous model" , model.name);
+                        ydelete m;
+                        return;
+                    }
+
+                    // the old handle goes stale so entities find the new model by name
+                    model_pool.Remove(model.handle);
+                    if (model.model != nullptr)
+                        retired_models.push_back(RetiredModel{ model.model , 0 });
+
+                    model.model = m;
+                    model.handle = model_pool.Insert(m);
+                    models_reloaded = true;
+                }
+            });
+        }
+    }
+
+    void ResourceHandler::ReleaseRetiredModels() {
+        // nothing is counted until the scene has acknowledged the reload and moved its entities over
+        if (models_reloaded || retired_models.empty()) 
+            return;
+
+        // after that the draws still holding the old model are recorded once more and then executed ,
+        // this runs after the render thread synced so GL is free to delete its buffers
+        for (auto& retired : retired_models) {
+            if (++retired.frames < kFramesInFlight) continue;
+            ydelete retired.model;
+            retired.model = nullptr;
+        }
+
+        retired_models.erase(std::remove_if(retired_models.begin() , retired_models.end() , [](const RetiredModel& retired) {
+            return retired.model == nullptr;
+        }) , retired_models.end());
+    }
+
     ResourceHandler* ResourceHandler::Instance() {
         if (singleton == nullptr)
             singleton = ynew ResourceHandler;
@@ -202,6 +385,9 @@ namespace YE {
     void ResourceHandler::Load() {
         stbi_set_flip_vertically_on_load(true);
 
+        Texture::CreatePlaceholder();
+        asset_loader = ynew AssetLoader;
+
         engine_resource_dir = Filesystem::GetEngineResPath();
         engine_shader_dir = Filesystem::GetEngineShaderPath();
         engine_texture_dir = Filesystem::GetEngineTexturePath();
@@ -229,9 +415,24 @@ namespace YE {
         StoreModels(app_model_dir , app_models);
         LoadModels(engine_models);
         LoadModels(app_models);
+
+        WatchResources();
     }
 
     void ResourceHandler::Offload() {
+        if (file_watcher != nullptr) {
+            file_watcher->Stop();
+            ydelete file_watcher;
+            file_watcher = nullptr;
+        }
+
+        // loader threads may still be decoding into resources that are about to be deleted
+        if (asset_loader != nullptr) {
+            asset_loader->Stop();
+            ydelete asset_loader;
+            asset_loader = nullptr;
+        }
+
         CleanupShaders(engine_shaders);
         CleanupShaders(app_shaders);
         CleanupTextures(engine_textures);
@@ -239,6 +440,30 @@ namespace YE {
         CleanupPrimitiveVAOs(primitive_vaos);
         CleanupModels(engine_models);
         CleanupModels(app_models);
+
+        for (auto* model : staged_models)
+            ydelete model;
+        for (auto& retired : retired_models)
+            ydelete retired.model;
+        staged_models.clear();
+        retired_models.clear();
+        AcknowledgeHotReload();
+
+        // after the textures , each one hands its layer back on destruction
+        texture_arrays.Cleanup();
+
+        Texture::DestroyPlaceholder();
+    }
+
+    void ResourceHandler::ProcessUploads(float budget) {
+        ProcessReloads();
+        if (asset_loader != nullptr)
+            asset_loader->ProcessUploads(budget);
+    }
+
+    void ResourceHandler::FinishLoading() {
+        if (asset_loader != nullptr)
+            asset_loader->Finish();
     }
 
     void ResourceHandler::AddShader(const std::string& vert_path , const std::string& frag_path ,
@@ -267,49 +492,58 @@ namespace YE {
         // models[id].model->Load();
     }
 
-    Shader* ResourceHandler::GetCoreShader(const std::string& name) {
-        for (auto& [id , shader] : engine_shaders)
-            if (shader.name == name) return shader.shader;
-        return nullptr;
+    Shader* ResourceHandler::GetCoreShader(ResourceName name) {
+        return shader_pool.Get(FindHandle(engine_shaders , name));
     }
 
-    Shader* ResourceHandler::GetShader(const std::string& name) {
-        for (auto& [id , shader] : app_shaders)
-            if (shader.name == name) return shader.shader;
-        return nullptr;
+    Shader* ResourceHandler::GetShader(ResourceName name) {
+        return shader_pool.Get(FindHandle(app_shaders , name));
     }
     
-    Texture* ResourceHandler::GetCoreTexture(const std::string& name) {
-        for (auto& [id , texture] : engine_textures)
-            if (texture.name == name) return texture.texture;
-        return nullptr;
+    Texture* ResourceHandler::GetCoreTexture(ResourceName name) {
+        return texture_pool.Get(FindHandle(engine_textures , name));
+    }
+
+    Texture* ResourceHandler::GetTexture(ResourceName name) {
+        return texture_pool.Get(FindHandle(app_textures , name));
+    }
+
+    VertexArray* ResourceHandler::GetPrimitiveVAO(ResourceName name) {
+        return vao_pool.Get(FindHandle(primitive_vaos , name));
+    }
+
+    Model* ResourceHandler::GetCoreModel(ResourceName name) {
+        return model_pool.Get(FindHandle(engine_models , name));
+    }
+
+    Model* ResourceHandler::GetModel(ResourceName name) {
+        return model_pool.Get(FindHandle(app_models , name));
     }
 
-    Texture* ResourceHandler::GetTexture(const std::string& name) {
-        for (auto& [id , texture] : app_textures)
-            if (texture.name == name) return texture.texture;
-        return nullptr;
+    ShaderHandle ResourceHandler::FindShader(ResourceName name) const {
+        ShaderHandle handle = FindHandle(app_shaders , name);
+        return handle.Null() ? FindHandle(engine_shaders , name) : handle;
     }
 
-    VertexArray* ResourceHandler::GetPrimitiveVAO(const std::string& name) {
-        for (auto& [id , vao] : primitive_vaos)
-            if (vao.name == name) return vao.vao;
-        return nullptr;
+    TextureHandle ResourceHandler::FindTexture(ResourceName name) const {
+        TextureHandle handle = FindHandle(app_textures , name);
+        return handle.Null() ? FindHandle(engine_textures , name) : handle;
     }
 
-    Model* ResourceHandler::GetCoreModel(const std::string& name) {
-        for (auto& [id , model] : engine_models)
-            if (model.name == name) return model.model;
-        return nullptr;
+    ModelHandle ResourceHandler::FindModel(ResourceName name) const {
+        ModelHandle handle = FindHandle(app_models , name);
+        return handle.Null() ? FindHandle(engine_models , name) : handle;
     }
 
-    Model* ResourceHandler::GetModel(const std::string& name) {
-        for (auto& [id , model] : app_models)
-            if (model.name == name) return model.model;
-        return nullptr;
+    VertexArrayHandle ResourceHandler::FindPrimitiveVAO(ResourceName name) const {
+        return FindHandle(primitive_vaos , name);
     }
 
     void ResourceHandler::ReloadShaders() {
+        // hot reloads still in flight point at the shaders about to be deleted
+        FinishLoading();
+        reloaded_shaders.clear();
+
         CleanupShaders(engine_shaders);
         CleanupShaders(app_shaders);
         StoreShaders(engine_shader_dir , engine_shaders);
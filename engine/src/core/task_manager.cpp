@@ -1,9 +1,139 @@
 #include "core/task_manager.hpp"
 
+#include <algorithm>
+
 namespace YE {
 
     TaskManager* TaskManager::singleton = nullptr;
-    
+    thread_local int32_t TaskManager::worker_index = -1;
+
+    TaskManager::TaskManager() {
+        // the main thread helps out while it waits in FlushTasks so leave its core free
+        uint32_t hardware_threads = std::thread::hardware_concurrency();
+        uint32_t num_workers = std::max(1u , hardware_threads > 1 ? hardware_threads - 1 : 1u);
+
+        queues.reserve(num_workers);
+        for (uint32_t i = 0; i < num_workers; ++i)
+            queues.push_back(std::make_unique<WorkQueue>());
+
+        running = true;
+        workers.reserve(num_workers);
+        for (uint32_t i = 0; i < num_workers; ++i)
+            workers.emplace_back([this , i]() { WorkerLoop(i); });
+    }
+
+    void TaskManager::WorkerLoop(uint32_t index) {
+        worker_index = static_cast<int32_t>(index);
+
+        while (running.load(std::memory_order_acquire)) {
+            Job* job = FindJob();
+            if (job != nullptr) {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleeping_workers.fetch_add(1);
+            wake_condition.wait(lock , [this]() {
+                return queued_jobs.load() > 0 || !running.load();
+            });
+            sleeping_workers.fetch_sub(1);
+        }
+    }
+
+    Job* TaskManager::FindJob() {
+        const uint32_t num_queues = static_cast<uint32_t>(queues.size());
+
+        if (worker_index >= 0) {
+            Job* job = queues[worker_index]->Pop();
+            if (job != nullptr) {
+                queued_jobs.fetch_sub(1);
+                return job;
+            }
+        }
+
+        uint32_t start = worker_index >= 0 ?
+            static_cast<uint32_t>(worker_index) + 1 : next_queue.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < num_queues; ++i) {
+            uint32_t victim = (start + i) % num_queues;
+            if (static_cast<int32_t>(victim) == worker_index)
+                continue;
+
+            Job* job = queues[victim]->Steal();
+            if (job != nullptr) {
+                queued_jobs.fetch_sub(1);
+                if (worker_index >= 0)
+                    stats.jobs_stolen.fetch_add(1 , std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void TaskManager::Schedule(Job* job) {
+        queued_jobs.fetch_add(1);
+
+        if (worker_index >= 0) {
+            queues[worker_index]->Push(job);
+        } else {
+            uint32_t target = next_queue.fetch_add(1 , std::memory_order_relaxed) % queues.size();
+            queues[target]->Push(job);
+        }
+
+        if (sleeping_workers.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            wake_condition.notify_one();
+        }
+    }
+
+    void TaskManager::Execute(Job* job) {
+        job->task->Execute();
+        ydelete job->task;
+
+        JobHandle counter = std::move(job->counter);
+        ydelete job;
+
+        if (counter->pending.fetch_sub(1 , std::memory_order_acq_rel) == 1) {
+            std::vector<Job*> ready;
+            {
+                std::lock_guard<std::mutex> lock(counter->continuation_mutex);
+                ready.swap(counter->continuations);
+            }
+
+            for (auto* continuation : ready)
+                Resolve(continuation);
+        }
+
+        stats.jobs_executed.fetch_add(1 , std::memory_order_relaxed);
+        outstanding_jobs.fetch_sub(1 , std::memory_order_acq_rel);
+    }
+
+    void TaskManager::Resolve(Job* job) {
+        if (job->unresolved.fetch_sub(1 , std::memory_order_acq_rel) == 1)
+            Schedule(job);
+    }
+
+    void TaskManager::Submit(Job* job , const std::vector<JobHandle>& dependencies) {
+        outstanding_jobs.fetch_add(1 , std::memory_order_acq_rel);
+        stats.jobs_dispatched.fetch_add(1 , std::memory_order_relaxed);
+
+        for (auto& dependency : dependencies) {
+            if (dependency == nullptr)
+                continue;
+
+            std::lock_guard<std::mutex> lock(dependency->continuation_mutex);
+            if (dependency->Done())
+                continue;
+
+            job->unresolved.fetch_add(1 , std::memory_order_acq_rel);
+            dependency->continuations.push_back(job);
+        }
+
+        // drop the guard, if every dependency already finished this schedules the job right away
+        Resolve(job);
+    }
+
     TaskManager* TaskManager::Instance() {
         if (singleton == nullptr) {
             singleton = ynew TaskManager;
@@ -11,23 +141,88 @@ namespace YE {
         return singleton;
     }
 
-    void TaskManager::DispatchTask(BaseTask* task) {
-        task_queue.push(task);
-        task->Dispatch();
+    JobHandle TaskManager::DispatchTask(BaseTask* task) {
+        return DispatchTaskAfter({} , task);
+    }
+
+    JobHandle TaskManager::DispatchTaskAfter(const std::vector<JobHandle>& dependencies , BaseTask* task) {
+        if (task == nullptr) {
+            YE_WARN("Attempted to dispatch a null task");
+            return nullptr;
+        }
+
+        JobHandle counter = std::make_shared<JobCounter>();
+        counter->pending.store(1 , std::memory_order_release);
+
+        Job* job = ynew Job(task , counter);
+        Submit(job , dependencies);
+
+        return counter;
+    }
+
+    JobHandle TaskManager::DispatchParallel(uint32_t count , uint32_t grain , std::function<void(uint32_t , uint32_t)> fn) {
+        if (count == 0 || fn == nullptr) 
+            return nullptr;
+
+        grain = std::max(1u , grain);
+        const uint32_t num_chunks = (count + grain - 1) / grain;
+
+        JobHandle counter = std::make_shared<JobCounter>();
+        counter->pending.store(num_chunks , std::memory_order_release);
+
+        auto shared_fn = std::make_shared<std::function<void(uint32_t , uint32_t)>>(std::move(fn));
+        for (uint32_t i = 0; i < num_chunks; ++i) {
+            uint32_t begin = i * grain;
+            uint32_t end = std::min(count , begin + grain);
+
+            BaseTask* task = ynew Task([shared_fn , begin , end]() { (*shared_fn)(begin , end); });
+            Job* job = ynew Job(task , counter);
+            Submit(job , {});
+        }
+
+        return counter;
+    }
+
+    void TaskManager::WaitFor(const JobHandle& handle) {
+        if (handle == nullptr) return;
+
+        while (!handle->Done()) {
+            Job* job = FindJob();
+            if (job != nullptr) {
+                Execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
     }
 
     void TaskManager::FlushTasks() {
-        while (!task_queue.empty()) {
-            BaseTask* task = task_queue.front();
-            task_queue.pop();
-            task->WaitFor();
-            ydelete task;
+        while (outstanding_jobs.load(std::memory_order_acquire) > 0) {
+            Job* job = FindJob();
+            if (job != nullptr) {
+                Execute(job);
+            } else {
+                std::this_thread::yield();
+            }
         }
     }
-    
+
     void TaskManager::Cleanup() {
         this->FlushTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            running = false;
+        }
+        wake_condition.notify_all();
+
+        for (auto& worker : workers)
+            if (worker.joinable()) worker.join();
+        workers.clear();
+        queues.clear();
+
         if (singleton != nullptr) ydelete singleton;
+        singleton = nullptr;
     }
 
-}
\ No newline at end of file
+}
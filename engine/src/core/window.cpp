@@ -7,6 +7,7 @@
 #include "core/resource_handler.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/framebuffer.hpp"
+#include "rendering/render_thread.hpp"
 #include "event/event_manager.hpp"
 
 namespace YE {
@@ -81,9 +82,13 @@ namespace YE {
             [window = this , fbs = framebuffers](WindowResized* event) -> bool {
                 window->HandleResize({ event->Width() , event->Height() });
 
-                UUID32 id = Renderer::Instance()->ActiveFramebuffer();
-                if (fbs->find(id) != fbs->end())
-                    (*fbs)[id]->HandleResize({ event->Width() , event->Height() });
+                // the framebuffer is rebuilt through GL , with a render thread that waits for the context
+                glm::ivec2 size{ event->Width() , event->Height() };
+                RenderThread::Instance()->Submit([fbs , size]() {
+                    UUID32 id = Renderer::Instance()->ActiveFramebuffer();
+                    if (fbs->find(id) != fbs->end())
+                        (*fbs)[id]->HandleResize(size);
+                });
 
                 return true;
             } ,
@@ -92,8 +97,12 @@ namespace YE {
     }
 
     void Window::Clear() {
-        glViewport(0 , 0 , static_cast<uint32_t>(size.x) , static_cast<uint32_t>(size.y));
-        glClearColor(clear_color.r , clear_color.g , clear_color.b , clear_color.a);
+        Clear(size , clear_color);
+    }
+
+    void Window::Clear(const glm::ivec2& viewport , const glm::vec4& color) {
+        glViewport(0 , 0 , static_cast<uint32_t>(viewport.x) , static_cast<uint32_t>(viewport.y));
+        glClearColor(color.r , color.g , color.b , color.a);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
     }
 
@@ -10,9 +10,12 @@
 #include "core/task_manager.hpp"
 #include "core/resource_handler.hpp"
 #include "event/event_manager.hpp"
+#include "input/input.hpp"
+#include "input/input_recorder.hpp"
 #include "input/mouse.hpp"
 #include "input/keyboard.hpp"
 #include "rendering/renderer.hpp"
+#include "rendering/render_thread.hpp"
 #include "scene/scene.hpp"
 #include "physics/physics_engine.hpp"
 #include "scripting/script_engine.hpp"
@@ -31,8 +34,10 @@ namespace YE {
         resource_handler = ResourceHandler::Instance();
         event_manager = EventManager::Instance();
         renderer = Renderer::Instance(); 
+        render_thread = RenderThread::Instance();
         script_engine = ScriptEngine::Instance();
         physics_engine = PhysicsEngine::Instance();
+        input_recorder = InputRecorder::Instance();
     }
 
     Engine* Engine::singleton = nullptr;
@@ -73,7 +78,7 @@ namespace YE {
         script_engine->Initialize();
         script_engine->LoadProjectModules();
 
-        renderer->Initialize(app);
+        renderer->Initialize(app , app_config.threaded_rendering);
         renderer->OpenWindow();
 
         Systems::Initialize();
@@ -83,8 +88,21 @@ namespace YE {
     
     void Engine::Update(float dt) {
         event_manager->PollEvents();
-        Keyboard::Update();
-        Mouse::Update();
+        event_manager->DispatchQueued();
+
+        InputSnapshot snapshot;
+        if (input_recorder->Replaying()) {
+            // the recording stands in for the devices , the session is over once it runs out
+            if (!input_recorder->Next(snapshot , dt)) {
+                event_manager->Dispatch<ShutdownEvent>();
+                return;
+            }
+        } else {
+            Input::Capture(snapshot);
+        }
+
+        input_recorder->Record(snapshot , dt);
+        Input::Apply(snapshot);
         app->Update(dt);
     }
     
@@ -148,6 +166,17 @@ namespace YE {
         Mouse::SnapToCenter();
 
         task_manager->FlushTasks();
+
+        if (!app_config.replay_input_path.empty()) {
+            input_recorder->StartReplay(app_config.replay_input_path);
+        } else if (!app_config.record_input_path.empty()) {
+            input_recorder->StartRecording(app_config.record_input_path , frame_rate.TimeStep());
+        }
+
+        // from here on the context only comes back to this thread between Sync and the next Kick
+        if (app_config.threaded_rendering)
+            render_thread->Launch(renderer->ActiveWindow());
+
         while (running) {
             float dt = frame_rate.TimeStep();
             task_manager->DispatchTask([dt = &delta_time , stats = stats](){
@@ -156,14 +185,24 @@ namespace YE {
                 stats->frame_times[kFrameTimeBufferSize - 1] = dt->Get();
             });
 
+            // the render thread is still executing the last frame while this one is simulated
             Update(dt);
             task_manager->FlushTasks();
 
+            render_thread->Sync();
+            resource_handler->ProcessUploads();
             renderer->Render();
             event_manager->FlushEvents();
             
-            frame_rate.Enforce();
+            // replays run flat out so the measured frame times are the frames' own cost
+            if (input_recorder->Replaying()) {
+                input_recorder->MeasureFrame();
+            } else {
+                frame_rate.Enforce();
+            }
         }
+
+        render_thread->WaitFor();
     }
 
     void Engine::Shutdown() {
@@ -184,7 +223,9 @@ namespace YE {
         event_manager->Cleanup();
         task_manager->Cleanup();
         renderer->Cleanup();
+        render_thread->Cleanup();
         script_engine->Cleanup();
+        input_recorder->Cleanup();
         
         YE_INFO("Goodbye");
         logger->CloseLog();
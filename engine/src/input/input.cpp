@@ -0,0 +1,30 @@
+#include "input/input.hpp"
+
+#include "input/input_actions.hpp"
+
+namespace YE {
+
+    InputSnapshot Input::current{};
+    InputSnapshot Input::previous{};
+
+    void Input::Capture(InputSnapshot& snapshot) {
+        Keyboard::Capture(snapshot.keys);
+        Mouse::Capture(snapshot.mouse_position , snapshot.buttons , snapshot.mouse_in_window);
+    }
+
+    void Input::Apply(const InputSnapshot& snapshot) {
+        previous = current;
+        current = snapshot;
+
+        Keyboard::Apply(current.keys);
+        Mouse::Apply(current.mouse_position , current.buttons , current.mouse_in_window);
+        InputActions::Update(current.keys , current.buttons);
+    }
+
+    void Input::Update() {
+        InputSnapshot snapshot;
+        Capture(snapshot);
+        Apply(snapshot);
+    }
+
+}
@@ -0,0 +1,82 @@
+#include "input/input_actions.hpp"
+
+#include "log.hpp"
+#include "core/hash.hpp"
+
+namespace YE {
+
+    std::vector<InputActions::ActionBinding> InputActions::bindings{};
+    std::unordered_map<uint32_t , InputActions::ActionID> InputActions::ids{};
+    uint64_t InputActions::current_down = 0;
+    uint64_t InputActions::previous_down = 0;
+
+    InputActions::ActionID InputActions::Register(const std::string& name) {
+        uint32_t hash = Hash::FNV32(name);
+        auto itr = ids.find(hash);
+        if (itr != ids.end())
+            return itr->second;
+
+        if (bindings.size() >= kMaxActions) {
+            YE_WARN("Failed to register input action :: [{0}] | Too many actions" , name);
+            return kInvalidAction;
+        }
+
+        ActionID id = static_cast<ActionID>(bindings.size());
+        bindings.push_back(ActionBinding{});
+        ids[hash] = id;
+        return id;
+    }
+
+    InputActions::ActionID InputActions::Find(const std::string& name) {
+        auto itr = ids.find(Hash::FNV32(name));
+        return itr != ids.end() ? itr->second : kInvalidAction;
+    }
+
+    void InputActions::BindKey(ActionID action , Keyboard::Key key) {
+        uint32_t k = static_cast<uint32_t>(key);
+        if (!Valid(action) || !Keyboard::Valid(k)) {
+            YE_WARN("Failed to bind key :: [{0}] | Invalid action or key" , k);
+            return;
+        }
+        bindings[action].keys[k / 64] |= 1ull << (k % 64);
+    }
+
+    void InputActions::BindButton(ActionID action , Mouse::Button button) {
+        uint32_t b = static_cast<uint32_t>(button);
+        if (!Valid(action) || !Mouse::Valid(b)) {
+            YE_WARN("Failed to bind mouse button :: [{0}] | Invalid action or button" , b);
+            return;
+        }
+        bindings[action].buttons |= 1u << b;
+    }
+
+    void InputActions::Unbind(ActionID action) {
+        if (!Valid(action))
+            return;
+        bindings[action] = ActionBinding{};
+    }
+
+    void InputActions::Clear() {
+        bindings.clear();
+        ids.clear();
+        current_down = 0;
+        previous_down = 0;
+    }
+
+    void InputActions::Update(const Keyboard::KeyBits& keys , uint32_t buttons) {
+        previous_down = current_down;
+        current_down = 0;
+
+        for (ActionID a = 0; a < bindings.size(); ++a) {
+            const ActionBinding& binding = bindings[a];
+
+            uint64_t hit = binding.buttons & buttons;
+            for (uint32_t w = 0; w < Keyboard::kKeyWords; ++w)
+                hit |= binding.keys[w] & keys[w];
+
+            if (hit != 0)
+                current_down |= 1ull << a;
+        }
+    }
+
+}
@@ -0,0 +1,296 @@
+#include "input/input_recorder.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+#include "log.hpp"
+
+namespace YE {
+
+    // time step , flags , changed key words , buttons , cursor
+    static constexpr size_t kFrameFixedSize = sizeof(float) + 2 * sizeof(uint8_t) + sizeof(uint32_t) + 2 * sizeof(int32_t);
+
+    static constexpr uint8_t kMouseInWindowFlag = 1 << 0;
+
+    template<typename T>
+    static void Append(std::vector<uint8_t>& data , const T& value) {
+        const size_t offset = data.size();
+        data.resize(offset + sizeof(T));
+        std::memcpy(data.data() + offset , &value , sizeof(T));
+    }
+
+    template<typename T>
+    static T Read(const std::vector<uint8_t>& data , size_t& cursor) {
+        T value;
+        std::memcpy(&value , data.data() + cursor , sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    InputRecorder* InputRecorder::singleton = nullptr;
+
+    void InputRecorder::ReportFrameTimes() {
+        if (frame_times.empty())
+            return;
+
+        std::vector<float> sorted = frame_times;
+        std::sort(sorted.begin() , sorted.end());
+
+        auto percentile = [&sorted](float p) -> float {
+            size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+            return sorted[index] * 1000.f;
+        };
+        const float mean = std::accumulate(sorted.begin() , sorted.end() , 0.0f) / sorted.size() * 1000.f;
+
+        // the log is compiled out of release builds , which are the ones being profiled , so the report is
+        //  written next to the recording
+        const std::string report_path = path + ".frametimes";
+        std::ofstream report(report_path);
+        if (!report.is_open()) {
+            YE_WARN("Failed to write frame time report :: [{0}] | could not open file" , report_path);
+            return;
+        }
+
+        char line[256];
+        std::snprintf(line , sizeof(line) , "%zu frames | mean %.3f ms | p50 %.3f ms | p90 %.3f ms | p99 %.3f ms | max %.3f ms\n" ,
+                      sorted.size() , mean , percentile(0.5f) , percentile(0.9f) , percentile(0.99f) , sorted.back() * 1000.f);
+        report << path << " | " << line;
+
+        // histogram in doubling buckets from 1 ms , the last one takes everything from 64 ms up
+        constexpr uint32_t kBuckets = 8;
+        uint32_t counts[kBuckets] = { 0 };
+        for (float t : sorted) {
+            uint32_t ms = static_cast<uint32_t>(t * 1000.f);
+            uint32_t bucket = ms == 0 ? 0 : std::min(static_cast<uint32_t>(std::bit_width(ms)) , kBuckets - 1);
+            ++counts[bucket];
+        }
+
+        for (uint32_t b = 0; b < kBuckets; ++b) {
+            if (counts[b] == 0)
+                continue;
+
+            uint32_t low = b == 0 ? 0 : 1u << (b - 1);
+            if (b == kBuckets - 1) {
+                std::snprintf(line , sizeof(line) , "    >= %u ms : %u\n" , low , counts[b]);
+            } else {
+                std::snprintf(line , sizeof(line) , "    %u - %u ms : %u\n" , low , 1u << b , counts[b]);
+            }
+            report << line;
+        }
+
+        YE_INFO("Replay frame times :: [{0}] | {1} frames | mean {2:.3f} ms | p99 {3:.3f} ms | report in [{4}]" , 
+                path , sorted.size() , mean , percentile(0.99f) , report_path);
+    }
+
+    InputRecorder* InputRecorder::Instance() {
+        if (singleton == nullptr) {
+            singleton = ynew InputRecorder;
+        }
+        return singleton;
+    }
+
+    bool InputRecorder::StartRecording(const std::string& path , float time_step) {
+        if (mode != Mode::NONE) {
+            YE_WARN("Failed to start input recording :: [{0}] | Already recording or replaying" , path);
+            return false;
+        }
+
+        this->path = path;
+        this->time_step = time_step;
+        mode = Mode::RECORDING;
+
+        data.clear();
+        Append(data , InputRecordingHeader{});
+        frame_count = 0;
+        frame = 0;
+        last_keys.fill(0);
+
+        YE_INFO("Recording input :: [{0}]" , path);
+        return true;
+    }
+
+    bool InputRecorder::StopRecording() {
+        if (mode != Mode::RECORDING)
+            return false;
+        mode = Mode::NONE;
+
+        InputRecordingHeader header;
+        header.frame_count = frame_count;
+        header.time_step = time_step;
+        std::memcpy(data.data() , &header , sizeof(InputRecordingHeader));
+
+        std::error_code ec;
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty())
+            std::filesystem::create_directories(parent , ec);
+
+        const std::string temp_path = path + ".tmp";
+        {
+            std::ofstream file(temp_path , std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                YE_WARN("Failed to write input recording :: [{0}] | could not open for writing" , path);
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(data.data()) , data.size());
+            if (!file.good()) {
+                YE_WARN("Failed to write input recording :: [{0}] | write failed" , path);
+                file.close();
+                std::filesystem::remove(temp_path , ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temp_path , path , ec);
+        if (ec) {
+            YE_WARN("Failed to write input recording :: [{0}] | {1}" , path , ec.message());
+            std::filesystem::remove(temp_path , ec);
+            return false;
+        }
+
+        YE_INFO("Input recording written :: [{0}] | {1} frames , {2} bytes" , path , frame_count , data.size());
+        data.clear();
+        return true;
+    }
+
+    void InputRecorder::Record(const InputSnapshot& snapshot , float dt) {
+        if (mode != Mode::RECORDING)
+            return;
+
+        uint8_t changed = 0;
+        for (uint32_t w = 0; w < Keyboard::kKeyWords; ++w) {
+            if (snapshot.keys[w] != last_keys[w])
+                changed |= 1 << w;
+        }
+
+        Append(data , dt);
+        Append(data , static_cast<uint8_t>(snapshot.mouse_in_window ? kMouseInWindowFlag : 0));
+        Append(data , changed);
+        Append(data , snapshot.buttons);
+        Append(data , snapshot.mouse_position.x);
+        Append(data , snapshot.mouse_position.y);
+        for (uint8_t bits = changed; bits != 0; bits &= bits - 1)
+            Append(data , snapshot.keys[std::countr_zero(bits)]);
+
+        last_keys = snapshot.keys;
+        ++frame_count;
+        ++frame;
+    }
+
+    bool InputRecorder::StartReplay(const std::string& path) {
+        if (mode != Mode::NONE) {
+            YE_WARN("Failed to start input replay :: [{0}] | Already recording or replaying" , path);
+            return false;
+        }
+
+        std::ifstream file(path , std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            YE_WARN("Failed to start input replay :: [{0}] | could not open file" , path);
+            return false;
+        }
+
+        std::streamsize size = file.tellg();
+        if (size < static_cast<std::streamsize>(sizeof(InputRecordingHeader))) {
+            YE_WARN("Failed to start input replay :: [{0}] | file too small" , path);
+            return false;
+        }
+
+        data.resize(static_cast<size_t>(size));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()) , size);
+        if (file.gcount() != size) {
+            YE_WARN("Failed to start input replay :: [{0}] | read failed" , path);
+            data.clear();
+            return false;
+        }
+
+        cursor = 0;
+        InputRecordingHeader header = Read<InputRecordingHeader>(data , cursor);
+        if (header.magic != kInputRecordingMagic || header.version != kInputRecordingVersion) {
+            YE_WARN("Failed to start input replay :: [{0}] | not an input recording or wrong version" , path);
+            data.clear();
+            return false;
+        }
+
+        this->path = path;
+        mode = Mode::REPLAYING;
+        frame_count = header.frame_count;
+        time_step = header.time_step;
+        frame = 0;
+        last_keys.fill(0);
+
+        frame_times.clear();
+        frame_times.reserve(frame_count);
+        frame_start = time::Clock::now();
+
+        YE_INFO("Replaying input :: [{0}] | {1} frames" , path , frame_count);
+        return true;
+    }
+
+    void InputRecorder::StopReplay() {
+        if (mode != Mode::REPLAYING)
+            return;
+        mode = Mode::NONE;
+
+        ReportFrameTimes();
+        data.clear();
+        frame_times.clear();
+    }
+
+    bool InputRecorder::Next(InputSnapshot& snapshot , float& dt) {
+        if (mode != Mode::REPLAYING)
+            return false;
+
+        if (frame >= frame_count || cursor + kFrameFixedSize > data.size()) {
+            if (frame < frame_count)
+                YE_WARN("Input recording truncated :: [{0}] | ended after {1} of {2} frames" , path , frame , frame_count);
+            StopReplay();
+            return false;
+        }
+
+        dt = Read<float>(data , cursor);
+        uint8_t flags = Read<uint8_t>(data , cursor);
+        uint8_t changed = Read<uint8_t>(data , cursor);
+        snapshot.buttons = Read<uint32_t>(data , cursor);
+        snapshot.mouse_position.x = Read<int32_t>(data , cursor);
+        snapshot.mouse_position.y = Read<int32_t>(data , cursor);
+        snapshot.mouse_in_window = (flags & kMouseInWindowFlag) != 0;
+
+        if (cursor + std::popcount(changed) * sizeof(uint64_t) > data.size()) {
+            YE_WARN("Input recording truncated :: [{0}] | ended after {1} of {2} frames" , path , frame , frame_count);
+            StopReplay();
+            return false;
+        }
+
+        for (uint8_t bits = changed; bits != 0; bits &= bits - 1)
+            last_keys[std::countr_zero(bits)] = Read<uint64_t>(data , cursor);
+        snapshot.keys = last_keys;
+
+        ++frame;
+        return true;
+    }
+
+    void InputRecorder::MeasureFrame() {
+        if (mode != Mode::REPLAYING)
+            return;
+
+        time::TimePoint now = time::Clock::now();
+        time::Duration elapsed = now - frame_start;
+        frame_start = now;
+        frame_times.push_back(elapsed.count());
+    }
+
+    void InputRecorder::Cleanup() {
+        StopRecording();
+        StopReplay();
+        if (singleton != nullptr) ydelete singleton;
+        singleton = nullptr;
+    }
+
+}
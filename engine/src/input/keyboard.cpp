@@ -1,76 +1,126 @@
 #include "input/keyboard.hpp"
 
-#include <memory>
+#include <bit>
+#include <algorithm>
 
 #include <SDL.h>
 
 #include "log.hpp"
+#include "core/defines.hpp"
 #include "event/events.hpp"
 #include "event/keyboard_events.hpp"
 #include "event/event_manager.hpp"
 
+#ifdef YE_SIMD_SSE
+#include <emmintrin.h>
+#endif // !YE_SIMD_SSE
+
 namespace YE {
 
-    std::map<Keyboard::Key , Keyboard::KeyState> Keyboard::keys{};
+    std::array<Keyboard::KeyState , Keyboard::kKeyCount> Keyboard::keys{};
+    Keyboard::KeyBits Keyboard::current_down{};
+    Keyboard::KeyBits Keyboard::previous_down{};
+    Keyboard::KeyBits Keyboard::pressed_edges{};
+    Keyboard::KeyBits Keyboard::released_edges{};
 
     void Keyboard::Initialize() {
-        for (uint16_t i = 0 ; i < kKeyCount ; ++i)
-            keys[static_cast<Key>(i)] = KeyState{};
+        keys.fill(KeyState{});
+        current_down.fill(0);
+        previous_down.fill(0);
+        pressed_edges.fill(0);
+        released_edges.fill(0);
     }
 
-    void Keyboard::Update() {
+    void Keyboard::Capture(KeyBits& down) {
+        int num_keys = 0;
+        const uint8_t* state = SDL_GetKeyboardState(&num_keys);
+        const uint32_t count = std::min(static_cast<uint32_t>(num_keys) , static_cast<uint32_t>(kKeyCount));
+
+        down.fill(0);
+        uint32_t k = 0;
+#ifdef YE_SIMD_SSE
+        // sixteen keys per compare , the movemask of the keys that are up is inverted into the bitset
+        const __m128i zero = _mm_setzero_si128();
+        for (; k + 16 <= count; k += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + k));
+            uint32_t up = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes , zero)));
+            down[k / 64] |= static_cast<uint64_t>(~up & 0xFFFF) << (k % 64);
+        }
+#endif // !YE_SIMD_SSE
+        for (; k < count; ++k) {
+            if (state[k])
+                down[k / 64] |= 1ull << (k % 64);
+        }
+    }
 
-        const uint8_t* state = SDL_GetKeyboardState(nullptr);
+    void Keyboard::Apply(const KeyBits& down) {
+        previous_down = current_down;
+        current_down = down;
+
+        KeyBits active;
+#ifdef YE_SIMD_SSE
+        for (uint32_t w = 0; w < kKeyWords; w += 2) {
+            __m128i curr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current_down.data() + w));
+            __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous_down.data() + w));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pressed_edges.data() + w) , _mm_andnot_si128(prev , curr));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(released_edges.data() + w) , _mm_andnot_si128(curr , prev));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(active.data() + w) , _mm_or_si128(curr , prev));
+        }
+#else
+        for (uint32_t w = 0; w < kKeyWords; ++w) {
+            pressed_edges[w] = current_down[w] & ~previous_down[w];
+            released_edges[w] = previous_down[w] & ~current_down[w];
+            active[w] = current_down[w] | previous_down[w];
+        }
+#endif // !YE_SIMD_SSE
 
+        // keys that were up and stay up have nothing to advance , the rest go through the state machine
         EventManager* event_manager = EventManager::Instance();
-        for (uint16_t k = 0; k < kKeyCount; ++k) {
-
-            keys[static_cast<Key>(k)].previous_state = keys[static_cast<Key>(k)].current_state;
-
-            if (!state[k]) {
-                keys[static_cast<Key>(k)].current_state = State::RELEASED;
-                keys[static_cast<Key>(k)].frames_held = 0;
-
-                event_manager->DispatchEvent(ynew KeyReleased(static_cast<Key>(k)));
-                continue;
-            }
-
-            if (state[k] && keys[static_cast<Key>(k)].current_state == State::RELEASED) {
-                keys[static_cast<Key>(k)].current_state = State::PRESSED;
-                ++keys[static_cast<Key>(k)].frames_held;
-
-                event_manager->DispatchEvent(ynew KeyPressed(static_cast<Key>(k)));
-                continue;
-            }
-
-            if (state[k] && keys[static_cast<Key>(k)].current_state == State::PRESSED && keys[static_cast<Key>(k)].frames_held <= 22) {
-                keys[static_cast<Key>(k)].current_state = State::BLOCKED;
-                ++keys[static_cast<Key>(k)].frames_held;
-
-                continue;
-            }
-
-            if (state[k] && keys[static_cast<Key>(k)].current_state == State::BLOCKED && keys[static_cast<Key>(k)].frames_held <= 22) {
-                ++keys[static_cast<Key>(k)].frames_held;
-                continue;
-            }
-
-            if (keys[static_cast<Key>(k)].current_state == State::BLOCKED && keys[static_cast<Key>(k)].frames_held > 22) {
-                keys[static_cast<Key>(k)].current_state = State::HELD;
-                ++keys[static_cast<Key>(k)].frames_held;
-
-                event_manager->DispatchEvent(ynew KeyHeld(static_cast<Key>(k) , keys[static_cast<Key>(k)]));
-                continue;
-            }
-
-            if (state[k] && keys[static_cast<Key>(k)].current_state == State::HELD) {
-                ++keys[static_cast<Key>(k)].frames_held;
-
-                event_manager->DispatchEvent(ynew KeyHeld(static_cast<Key>(k) , keys[static_cast<Key>(k)]));
-                continue;
+        for (uint32_t w = 0; w < kKeyWords; ++w) {
+            for (uint64_t bits = active[w]; bits != 0; bits &= bits - 1) {
+                const uint32_t k = w * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+                KeyState& key = keys[k];
+                key.previous_state = key.current_state;
+
+                if (!Test(current_down , k)) {
+                    key.current_state = State::RELEASED;
+                    key.frames_held = 0;
+
+                    event_manager->Dispatch<KeyReleased>(static_cast<Key>(k));
+                    continue;
+                }
+
+                if (key.current_state == State::RELEASED) {
+                    key.current_state = State::PRESSED;
+                    ++key.frames_held;
+
+                    event_manager->Dispatch<KeyPressed>(static_cast<Key>(k));
+                    continue;
+                }
+
+                if (key.current_state == State::PRESSED && key.frames_held <= 22) {
+                    key.current_state = State::BLOCKED;
+                    ++key.frames_held;
+                    continue;
+                }
+
+                if (key.current_state == State::BLOCKED && key.frames_held <= 22) {
+                    ++key.frames_held;
+                    continue;
+                }
+
+                if (key.current_state == State::BLOCKED && key.frames_held > 22) {
+                    key.current_state = State::HELD;
+                    ++key.frames_held;
+
+                    event_manager->Dispatch<KeyHeld>(static_cast<Key>(k) , key);
+                    continue;
+                }
+
+                if (key.current_state == State::HELD)
+                    ++key.frames_held;
             }
-        
         }
     }
 
-}
\ No newline at end of file
+}
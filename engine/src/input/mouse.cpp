@@ -1,5 +1,6 @@
 #include "input/mouse.hpp"
 
+#include <bit>
 #include <memory>
 
 #include "core/window.hpp"
@@ -11,7 +12,9 @@
 namespace YE {
 
     Mouse::MouseState Mouse::state{};
-    std::map<Mouse::Button , Mouse::ButtonState> Mouse::buttons{};
+    std::array<Mouse::ButtonState , Mouse::kButtonCount> Mouse::buttons{};
+    uint32_t Mouse::current_buttons = 0;
+    uint32_t Mouse::previous_buttons = 0;
 
     void Mouse::Initialize() {
         Window* window = Renderer::Instance()->ActiveWindow();
@@ -21,64 +24,75 @@ namespace YE {
             SDL_WarpMouseInWindow(sdl_window , window_size.x / 2 , window_size.y / 2);
         }
 
-        for (uint8_t i = 0; i < kButtonCount; ++i)
-            buttons[static_cast<Button>(i)] = ButtonState{};
+        buttons.fill(ButtonState{});
+        current_buttons = 0;
+        previous_buttons = 0;
     }
 
-    void Mouse::Update() {
-        state.previous_position = state.position;
+    void Mouse::Capture(glm::ivec2& position , uint32_t& down , bool& in_window) {
+        uint32_t sdl_buttons = SDL_GetMouseState(&position.x , &position.y);
+        in_window = SDL_GetMouseFocus() != nullptr;
 
-        uint32_t curr_state = SDL_GetMouseState(&state.position.x , &state.position.y);
+        // SDL numbers its buttons from one
+        down = 0;
+        for (uint32_t b = 0; b < kButtonCount; ++b) {
+            if (sdl_buttons & SDL_BUTTON(b + 1))
+                down |= 1u << b;
+        }
+    }
 
-        SDL_Window* window = SDL_GetMouseFocus();
-        state.in_window = window != nullptr;
+    void Mouse::Apply(const glm::ivec2& position , uint32_t down , bool in_window) {
+        state.previous_position = state.position;
+        state.position = position;
+        state.in_window = in_window;
 
+        previous_buttons = current_buttons;
+        current_buttons = down;
+
+        // like the keyboard , buttons that were up and stay up are skipped
         EventManager* event_manager = EventManager::Instance();
-        for (uint32_t b = 0; b < kButtonCount; ++b) {
-            buttons[static_cast<Button>(b)].previous_state = buttons[static_cast<Button>(b)].current_state;
+        for (uint32_t active = current_buttons | previous_buttons; active != 0; active &= active - 1) {
+            const uint32_t b = static_cast<uint32_t>(std::countr_zero(active));
+            ButtonState& button = buttons[b];
+            button.previous_state = button.current_state;
 
-            if (!(curr_state & SDL_BUTTON(b))) {
-                buttons[static_cast<Button>(b)].current_state = State::RELEASED;
-                buttons[static_cast<Button>(b)].frames_held = 0;
+            if (!(current_buttons & (1u << b))) {
+                button.current_state = State::RELEASED;
+                button.frames_held = 0;
 
-                event_manager->DispatchEvent(new MouseButtonReleased(static_cast<Button>(b)));
+                event_manager->Dispatch<MouseButtonReleased>(static_cast<Button>(b));
                 continue;
             }
             
-            if (curr_state & SDL_BUTTON(b) && buttons[static_cast<Button>(b)].current_state == State::RELEASED) {
-                buttons[static_cast<Button>(b)].current_state = State::PRESSED;
-                ++buttons[static_cast<Button>(b)].frames_held;
+            if (button.current_state == State::RELEASED) {
+                button.current_state = State::PRESSED;
+                ++button.frames_held;
 
-                event_manager->DispatchEvent(new MouseButtonPressed(static_cast<Button>(b)));
+                event_manager->Dispatch<MouseButtonPressed>(static_cast<Button>(b));
                 continue;
             }
             
-            if (curr_state & SDL_BUTTON(b) && buttons[static_cast<Button>(b)].current_state == State::PRESSED &&
-                buttons[static_cast<Button>(b)].frames_held <= 22) {
-                buttons[static_cast<Button>(b)].current_state = State::BLOCKED;
-                ++buttons[static_cast<Button>(b)].frames_held;
-                continue;
-            }
-
-            if (curr_state & SDL_BUTTON(b) && buttons[static_cast<Button>(b)].current_state == State::BLOCKED &&
-                buttons[static_cast<Button>(b)].frames_held <= 22) {
-                ++buttons[static_cast<Button>(b)].frames_held;
+            if (button.current_state == State::PRESSED && button.frames_held <= 22) {
+                button.current_state = State::BLOCKED;
+                ++button.frames_held;
                 continue;
             }
 
-            if (curr_state & SDL_BUTTON(b) && buttons[static_cast<Button>(b)].current_state == State::BLOCKED && 
-                buttons[static_cast<Button>(b)].frames_held > 22) {
-                buttons[static_cast<Button>(b)].current_state = State::HELD;
-                ++buttons[static_cast<Button>(b)].frames_held;
+            if (button.current_state == State::BLOCKED && button.frames_held <= 22) {
+                ++button.frames_held;
                 continue;
             }
 
-            if (curr_state & SDL_BUTTON(b) && buttons[static_cast<Button>(b)].current_state == State::HELD) {
-                ++buttons[static_cast<Button>(b)].frames_held;
+            if (button.current_state == State::BLOCKED && button.frames_held > 22) {
+                button.current_state = State::HELD;
+                ++button.frames_held;
 
-                event_manager->DispatchEvent(new MouseButtonHeld(static_cast<Button>(b)));
+                event_manager->Dispatch<MouseButtonHeld>(static_cast<Button>(b));
                 continue;
             }
+
+            if (button.current_state == State::HELD)
+                ++button.frames_held;
         }
     }
     
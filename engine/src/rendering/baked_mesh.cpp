@@ -0,0 +1,210 @@
+#include "rendering/baked_mesh.hpp"
+
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+#include "log.hpp"
+#include "core/mapped_file.hpp"
+
+namespace YE {
+
+namespace BakedMesh {
+
+    static uint64_t Align(uint64_t offset) {
+        return (offset + kBakedMeshAlignment - 1) & ~static_cast<uint64_t>(kBakedMeshAlignment - 1);
+    }
+
+    static void Pad(std::ofstream& file , uint64_t& written , uint64_t target) {
+        static constexpr char kZeros[kBakedMeshAlignment] = {};
+        if (target > written)
+            file.write(kZeros , static_cast<std::streamsize>(target - written));
+        written = target;
+    }
+
+    template <typename T>
+    static void WriteBlock(std::ofstream& file , uint64_t& written , uint64_t offset , const T* data , uint64_t count) {
+        Pad(file , written , offset);
+        if (count == 0) return;
+        file.write(reinterpret_cast<const char*>(data) , static_cast<std::streamsize>(sizeof(T) * count));
+        written += sizeof(T) * count;
+    }
+
+    static bool InFile(uint64_t offset , uint64_t bytes , size_t file_size) {
+        return offset % kBakedMeshAlignment == 0 && offset <= file_size && bytes <= file_size - offset;
+    }
+
+    bool SourceStamp(const std::string& source_path , uint64_t& size , int64_t& time) {
+        std::error_code ec;
+        size = std::filesystem::file_size(source_path , ec);
+        if (ec) return false;
+
+        auto write_time = std::filesystem::last_write_time(source_path , ec);
+        if (ec) return false;
+
+        time = static_cast<int64_t>(write_time.time_since_epoch().count());
+        return true;
+    }
+
+    bool Write(const std::string& baked_path , const std::string& source_path , const BakedMeshSource& source) {
+        if (source.vertices == nullptr || source.indices == nullptr || source.num_vertices == 0) 
+            return false;
+
+        BakedMeshHeader header;
+        if (!SourceStamp(source_path , header.source_size , header.source_time)) {
+            YE_WARN("Failed to bake mesh :: [{0}] | source missing" , source_path);
+            return false;
+        }
+
+        std::string strings;
+        std::vector<BakedTextureRef> textures;
+        for (auto& [type , path] : source.textures) {
+            BakedTextureRef ref;
+            ref.type = type;
+            ref.path_offset = static_cast<uint32_t>(strings.size());
+            ref.path_length = static_cast<uint32_t>(path.size());
+            textures.push_back(ref);
+            strings += path;
+        }
+
+        header.vertex_stride = source.format.Stride();
+        header.attribute_types = source.format.Types();
+        header.num_vertices = source.num_vertices;
+        header.num_indices = static_cast<uint32_t>(source.indices->size());
+        header.num_faces = source.num_faces;
+        header.num_submeshes = static_cast<uint32_t>(source.submeshes.size());
+        header.num_textures = static_cast<uint32_t>(textures.size());
+        header.string_bytes = static_cast<uint32_t>(strings.size());
+        header.num_lods = source.num_lods;
+        header.lod_ratios = source.lod_ratios;
+        header.lod_max_error = source.lod_max_error;
+
+        if (source.num_lods == 0 || source.num_lods > kMaxMeshLods || source.lods.size() != source.submeshes.size() * source.num_lods) {
+            YE_WARN("Failed to bake mesh :: [{0}] | lod table does not match submeshes" , source_path);
+            return false;
+        }
+
+        header.vertex_offset = Align(sizeof(BakedMeshHeader));
+        header.index_offset = Align(header.vertex_offset + uint64_t{ header.vertex_stride } * header.num_vertices);
+        header.submesh_offset = Align(header.index_offset + sizeof(uint32_t) * header.num_indices);
+        header.lod_offset = Align(header.submesh_offset + sizeof(BakedSubmesh) * header.num_submeshes);
+        header.texture_offset = Align(header.lod_offset + sizeof(BakedLod) * source.lods.size());
+        header.string_offset = Align(header.texture_offset + sizeof(BakedTextureRef) * header.num_textures);
+
+        header.bounds_min = source.bounds.min;
+        header.bounds_max = source.bounds.max;
+        header.diffuse = source.diffuse;
+        header.ambient = source.ambient;
+        header.shininess = source.shininess;
+
+        const std::string temp_path = baked_path + ".tmp";
+        {
+            std::ofstream file(temp_path , std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                YE_WARN("Failed to bake mesh :: [{0}] | could not open for writing" , baked_path);
+                return false;
+            }
+
+            uint64_t written = 0;
+            WriteBlock(file , written , 0 , &header , 1);
+            WriteBlock(file , written , header.vertex_offset , source.vertices , uint64_t{ header.vertex_stride } * header.num_vertices);
+            WriteBlock(file , written , header.index_offset , source.indices->data() , header.num_indices);
+            WriteBlock(file , written , header.submesh_offset , source.submeshes.data() , header.num_submeshes);
+            WriteBlock(file , written , header.lod_offset , source.lods.data() , source.lods.size());
+            WriteBlock(file , written , header.texture_offset , textures.data() , header.num_textures);
+            WriteBlock(file , written , header.string_offset , strings.data() , header.string_bytes);
+
+            if (!file.good()) {
+                YE_WARN("Failed to bake mesh :: [{0}] | write failed" , baked_path);
+                file.close();
+                std::error_code ec;
+                std::filesystem::remove(temp_path , ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path , baked_path , ec);
+        if (ec) {
+            YE_WARN("Failed to bake mesh :: [{0}] | {1}" , baked_path , ec.message());
+            std::filesystem::remove(temp_path , ec);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Read(const MappedFile& file , const std::string& source_path , BakedMeshView& view) {
+        const size_t size = file.Size();
+        if (!file.IsOpen() || size < sizeof(BakedMeshHeader)) return false;
+
+        const uint8_t* data = file.Data();
+        const BakedMeshHeader* header = reinterpret_cast<const BakedMeshHeader*>(data);
+
+        if (header->magic != kBakedMeshMagic || header->version != kBakedMeshVersion) 
+            return false;
+
+        for (auto& type : header->attribute_types) {
+            if (type > AttributeType::SNORM_10_10_10_2) return false;
+        }
+
+        if (header->num_lods == 0 || header->num_lods > kMaxMeshLods)
+            return false;
+
+        if (header->vertex_stride == 0 || header->vertex_stride != VertexFormat(header->attribute_types).Stride())
+            return false;
+
+        uint64_t source_size = 0;
+        int64_t source_time = 0;
+        if (SourceStamp(source_path , source_size , source_time) && 
+            (source_size != header->source_size || source_time != header->source_time))
+            return false;
+
+        if (!InFile(header->vertex_offset , uint64_t{ header->vertex_stride } * header->num_vertices , size) ||
+            !InFile(header->index_offset , sizeof(uint32_t) * uint64_t{ header->num_indices } , size) ||
+            !InFile(header->submesh_offset , sizeof(BakedSubmesh) * uint64_t{ header->num_submeshes } , size) ||
+            !InFile(header->lod_offset , sizeof(BakedLod) * uint64_t{ header->num_submeshes } * header->num_lods , size) ||
+            !InFile(header->texture_offset , sizeof(BakedTextureRef) * uint64_t{ header->num_textures } , size) ||
+            !InFile(header->string_offset , header->string_bytes , size)) {
+            YE_WARN("Failed to read baked mesh :: [{0}] | truncated" , source_path);
+            return false;
+        }
+
+        view.header = header;
+        view.vertices = data + header->vertex_offset;
+        view.indices = reinterpret_cast<const uint32_t*>(data + header->index_offset);
+        view.submeshes = reinterpret_cast<const BakedSubmesh*>(data + header->submesh_offset);
+        view.lods = reinterpret_cast<const BakedLod*>(data + header->lod_offset);
+        view.textures = reinterpret_cast<const BakedTextureRef*>(data + header->texture_offset);
+        view.strings = reinterpret_cast<const char*>(data + header->string_offset);
+
+        for (uint32_t i = 0; i < header->num_submeshes; ++i) {
+            const BakedSubmesh& submesh = view.submeshes[i];
+            if (uint64_t{ submesh.first_vertex } + submesh.num_vertices > header->num_vertices ||
+                uint64_t{ submesh.first_index } + submesh.num_indices > header->num_indices) {
+                YE_WARN("Failed to read baked mesh :: [{0}] | submesh {1} out of range" , source_path , i);
+                return false;
+            }
+
+            for (uint32_t l = 0; l < header->num_lods; ++l) {
+                const BakedLod& lod = view.Lod(i , l);
+                if (uint64_t{ lod.first_index } + lod.num_indices > submesh.num_indices) {
+                    YE_WARN("Failed to read baked mesh :: [{0}] | lod {1} of submesh {2} out of range" , source_path , l , i);
+                    return false;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < header->num_textures; ++i) {
+            if (uint64_t{ view.textures[i].path_offset } + view.textures[i].path_length > header->string_bytes) {
+                YE_WARN("Failed to read baked mesh :: [{0}] | texture {1} out of range" , source_path , i);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}
+
+}
@@ -0,0 +1,211 @@
+#include "rendering/bounds.hpp"
+
+#include <cmath>
+#include <utility>
+
+#include "core/defines.hpp"
+#include "rendering/vertex.hpp"
+
+#ifdef YE_SIMD_SSE
+#include <emmintrin.h>
+#endif // !YE_SIMD_SSE
+
+namespace YE {
+
+    AABB AABB::Transform(const glm::mat4& transform) const {
+        if (!Valid()) return *this;
+
+        glm::vec3 center = glm::vec3(transform * glm::vec4(Center() , 1.f));
+        glm::vec3 extents = Extents();
+
+        glm::mat3 abs_basis = glm::mat3(
+            glm::abs(glm::vec3(transform[0])) ,
+            glm::abs(glm::vec3(transform[1])) ,
+            glm::abs(glm::vec3(transform[2]))
+        );
+        glm::vec3 world_extents = abs_basis * extents;
+
+        return AABB(center - world_extents , center + world_extents);
+    }
+
+    Frustum::Frustum(const glm::mat4& view_projection) {
+        glm::vec4 row0 = glm::vec4(view_projection[0][0] , view_projection[1][0] , view_projection[2][0] , view_projection[3][0]);
+        glm::vec4 row1 = glm::vec4(view_projection[0][1] , view_projection[1][1] , view_projection[2][1] , view_projection[3][1]);
+        glm::vec4 row2 = glm::vec4(view_projection[0][2] , view_projection[1][2] , view_projection[2][2] , view_projection[3][2]);
+        glm::vec4 row3 = glm::vec4(view_projection[0][3] , view_projection[1][3] , view_projection[2][3] , view_projection[3][3]);
+
+        planes[0] = row3 + row0;
+        planes[1] = row3 - row0;
+        planes[2] = row3 + row1;
+        planes[3] = row3 - row1;
+        planes[4] = row3 + row2;
+        planes[5] = row3 - row2;
+
+        for (uint32_t i = 0; i < 6; ++i) {
+            float length = glm::length(glm::vec3(planes[i]));
+            if (length > 0.f)
+                planes[i] /= length;
+
+            px[i] = planes[i].x;
+            py[i] = planes[i].y;
+            pz[i] = planes[i].z;
+            pw[i] = planes[i].w;
+        }
+
+        // the two padding lanes hold a plane every point is in front of
+        for (uint32_t i = 6; i < 8; ++i) {
+            px[i] = 0.f;
+            py[i] = 0.f;
+            pz[i] = 0.f;
+            pw[i] = 1.f;
+        }
+    }
+
+    bool Frustum::Intersects(const AABB& aabb) const {
+        if (!aabb.Valid()) return true;
+
+        glm::vec3 center = aabb.Center();
+        glm::vec3 extents = aabb.Extents();
+
+        for (const auto& plane : planes) {
+            glm::vec3 normal = glm::vec3(plane);
+            float distance = glm::dot(normal , center) + plane.w;
+            float radius = glm::dot(glm::abs(normal) , extents);
+            if (distance + radius < 0.f)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool Frustum::Intersects(const BoundingSphere& sphere) const {
+        for (const auto& plane : planes) {
+            if (glm::dot(glm::vec3(plane) , sphere.center) + plane.w < -sphere.radius)
+                return false;
+        }
+
+        return true;
+    }
+
+    uint32_t Frustum::Cull(const AABB* boxes , uint32_t count , uint8_t* visible) const {
+        uint32_t num_visible = 0;
+
+#ifdef YE_SIMD_SSE
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        const __m128 nx[2] = { _mm_load_ps(px) , _mm_load_ps(px + 4) };
+        const __m128 ny[2] = { _mm_load_ps(py) , _mm_load_ps(py + 4) };
+        const __m128 nz[2] = { _mm_load_ps(pz) , _mm_load_ps(pz + 4) };
+        const __m128 nw[2] = { _mm_load_ps(pw) , _mm_load_ps(pw + 4) };
+
+        const __m128 ax[2] = { _mm_and_ps(nx[0] , abs_mask) , _mm_and_ps(nx[1] , abs_mask) };
+        const __m128 ay[2] = { _mm_and_ps(ny[0] , abs_mask) , _mm_and_ps(ny[1] , abs_mask) };
+        const __m128 az[2] = { _mm_and_ps(nz[0] , abs_mask) , _mm_and_ps(nz[1] , abs_mask) };
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const AABB& aabb = boxes[i];
+            if (!aabb.Valid()) {
+                visible[i] = 1;
+                ++num_visible;
+                continue;
+            }
+
+            glm::vec3 center = aabb.Center();
+            glm::vec3 extents = aabb.Extents();
+
+            const __m128 cx = _mm_set1_ps(center.x);
+            const __m128 cy = _mm_set1_ps(center.y);
+            const __m128 cz = _mm_set1_ps(center.z);
+            const __m128 ex = _mm_set1_ps(extents.x);
+            const __m128 ey = _mm_set1_ps(extents.y);
+            const __m128 ez = _mm_set1_ps(extents.z);
+
+            int outside = 0;
+            for (uint32_t g = 0; g < 2; ++g) {
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(nx[g] , cx) , _mm_mul_ps(ny[g] , cy)) ,
+                    _mm_add_ps(_mm_mul_ps(nz[g] , cz) , nw[g])
+                );
+                __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(ax[g] , ex) , _mm_mul_ps(ay[g] , ey)) ,
+                    _mm_mul_ps(az[g] , ez)
+                );
+                outside |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance , radius) , zero));
+            }
+
+            visible[i] = outside == 0 ? 1 : 0;
+            num_visible += visible[i];
+        }
+#else
+        for (uint32_t i = 0; i < count; ++i) {
+            visible[i] = Intersects(boxes[i]) ? 1 : 0;
+            num_visible += visible[i];
+        }
+#endif // !YE_SIMD_SSE
+
+        return num_visible;
+    }
+
+    AABB CalculateBounds(const Vertex* vertices , uint32_t count) {
+        AABB aabb;
+        for (uint32_t i = 0; i < count; ++i)
+            aabb.Expand(vertices[i].position);
+        return aabb;
+    }
+
+    AABB CalculateBounds(const float* vertices , uint32_t count , uint32_t stride , uint32_t position_size) {
+        AABB aabb;
+        if (position_size == 0 || stride < position_size) return aabb;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const float* position = vertices + i * stride;
+            aabb.Expand(glm::vec3(
+                position[0] , 
+                position_size > 1 ? position[1] : 0.f , 
+                position_size > 2 ? position[2] : 0.f
+            ));
+        }
+        return aabb;
+    }
+
+    BoundingSphere CalculateSphere(const AABB& aabb) {
+        if (!aabb.Valid()) return BoundingSphere{};
+        return BoundingSphere{ aabb.Center() , glm::length(aabb.Extents()) };
+    }
+
+    bool Intersects(const BoundingSphere& sphere , const AABB& aabb) {
+        glm::vec3 closest = glm::clamp(sphere.center , aabb.min , aabb.max);
+        glm::vec3 delta = sphere.center - closest;
+        return glm::dot(delta , delta) <= sphere.radius * sphere.radius;
+    }
+
+    bool RayIntersects(const glm::vec3& origin , const glm::vec3& inv_direction , float max_distance , 
+                       const AABB& aabb , float& distance) {
+        float enter = 0.f;
+        float exit = max_distance;
+
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            // a ray parallel to the slab never crosses it , it either starts between the planes or misses.
+            // the product below would be 0 * inf = NaN for an origin sitting on a plane
+            if (std::isinf(inv_direction[axis])) {
+                if (origin[axis] < aabb.min[axis] || origin[axis] > aabb.max[axis])
+                    return false;
+                continue;
+            }
+
+            float t0 = (aabb.min[axis] - origin[axis]) * inv_direction[axis];
+            float t1 = (aabb.max[axis] - origin[axis]) * inv_direction[axis];
+            if (t0 > t1) std::swap(t0 , t1);
+
+            enter = glm::max(enter , t0);
+            exit = glm::min(exit , t1);
+            if (enter > exit)
+                return false;
+        }
+
+        distance = enter;
+        return true;
+    }
+
+}
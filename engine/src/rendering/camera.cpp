@@ -41,11 +41,34 @@ namespace YE {
     }
 
     void Camera::Recalculate() {
+        if (snapshot) return;
+
         CalculateViewMatrix();
         CalculateProjectionMatrix();
         view_projection = projection * view;
     }
 
+    void Camera::CopyFrameState(Camera& other) {
+        other.Recalculate();
+
+        type = other.type;
+        view = other.view;
+        projection = other.projection;
+        view_projection = other.view_projection;
+        position = other.position;
+        front = other.front;
+        up = other.up;
+        right = other.right;
+        world_up = other.world_up;
+        euler_angles = other.euler_angles;
+        viewport = other.viewport;
+        clip = other.clip;
+        fov = other.fov;
+        zoom = other.zoom;
+        is_primary = other.is_primary;
+        snapshot = true;
+    }
+
     // Copilot Rotation
     void Camera::Rotate(const glm::vec3& rotation) {
         euler_angles.x += rotation.x;
@@ -9,6 +9,9 @@
 #include "engine.hpp"
 #include "core/filesystem.hpp"
 #include "event/event_manager.hpp"
+#include "core/resource_handler.hpp"
+#include "rendering/renderer.hpp"
+#include "rendering/render_thread.hpp"
 
 namespace YE {
 
@@ -23,7 +26,7 @@ namespace YE {
         if (ImGui::BeginMainMenuBar()) {
             if (ImGui::BeginMenu("Options")) {
                 if (ImGui::MenuItem("Close"))
-                    event_manager->DispatchEvent(ynew ShutdownEvent);
+                    event_manager->Dispatch<ShutdownEvent>();
                 if (ImGui::MenuItem("Stats" , nullptr , &gui_state->show_stats)) {}
                 
                 ImGui::EndMenu();
@@ -59,12 +62,33 @@ namespace YE {
                     engine->GetStats()->frame_times , 
                     IM_ARRAYSIZE(engine->GetStats()->frame_times)    
                 );
+
+                const RenderStats& render_stats = Renderer::Instance()->FrameStats();
+                ImGui::Separator();
+                ImGui::Text("Commands: %u | Draw Calls: %u" , render_stats.commands , render_stats.draw_calls);
+                ImGui::Text("Triangles: %u" , render_stats.triangles);
+                ImGui::Text("Program Binds: %u (skipped %u)" , render_stats.program_binds , render_stats.program_binds_skipped);
+                ImGui::Text("VAO Binds: %u (skipped %u)" , render_stats.vao_binds , render_stats.vao_binds_skipped);
+                ImGui::Text("Texture Binds: %u (skipped %u)" , render_stats.texture_binds , render_stats.texture_binds_skipped);
+                ImGui::Text("Frame Arena: %u bytes" , render_stats.frame_arena_bytes);
+                ImGui::Text("Persistent Draws: %u (changed %u)" , render_stats.persistent_commands , render_stats.persistent_updates);
+                ImGui::Text("Instanced Batches: %u (%u instances)" , render_stats.instanced_batches , render_stats.instanced_draws);
+                ImGui::Text("Culling: %u visible / %u tested" , render_stats.cull_visible , render_stats.cull_tested);
+                if (RenderThread::Instance()->Running())
+                    ImGui::Text("Render Thread Wait: %.3f ms" , RenderThread::Instance()->WaitTime());
+
+                // flipping this compares binds and batches with and without the shared arrays
+                bool texture_arrays = RenderState::TextureArraysEnabled();
+                if (ImGui::Checkbox("Texture Arrays" , &texture_arrays))
+                    RenderState::EnableTextureArrays(texture_arrays);
+                ImGui::SameLine();
+                ImGui::Text("(%u arrays)" , ResourceHandler::Instance()->TextureArrays().NumArrays());
             }
             ImGui::End();
         }
     }
 
-    void Gui::Initialize(Window* window) {
+    void Gui::Initialize(Window* window , bool platform_windows) {
         IMGUI_CHECKVERSION();
         ImGui::CreateContext();
         ImGuiIO& io = ImGui::GetIO();
@@ -72,14 +96,18 @@ namespace YE {
 
         io.ConfigWindowsResizeFromEdges = true;
         io.ConfigWindowsMoveFromTitleBarOnly = true;
-        io.ConfigFlags |= ImGuiConfigFlags_DockingEnable | ImGuiConfigFlags_ViewportsEnable | 
-                          ImGuiConfigFlags_NavEnableKeyboard;
+        io.ConfigFlags |= ImGuiConfigFlags_DockingEnable | ImGuiConfigFlags_NavEnableKeyboard;
+        if (platform_windows)
+            io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
 
         SDL_Window* win = window->GetSDLWindow();
         SDL_GLContext gl_context = window->GetGLContext();
         ImGui_ImplSDL2_InitForOpenGL(win , gl_context);
         ImGui_ImplOpenGL3_Init("#version 460");
 
+        // otherwise the first NewFrame creates them , wherever the context happens to be by then
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
+
         io.IniFilename = YE::Filesystem::GetGuiIniPathCStr();        
 
         gui_state = ynew GuiState;
@@ -102,13 +130,19 @@ namespace YE {
         RenderMainWindow(window);
     }
 
-    void Gui::EndRender(SDL_Window* window , void* gl_context) {
+    void Gui::EndRender() {
         ImGui::Render();
+
+        ImGuiIO& io = ImGui::GetIO();
+        if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+            ImGui::UpdatePlatformWindows();
+    }
+
+    void Gui::Draw(SDL_Window* window , void* gl_context) {
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
         ImGuiIO& io = ImGui::GetIO();
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
-            ImGui::UpdatePlatformWindows();
             ImGui::RenderPlatformWindowsDefault();
             SDL_GL_MakeCurrent(window , gl_context);
         }
@@ -0,0 +1,242 @@
+#include "rendering/mesh_simplifier.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <glm/glm.hpp>
+
+namespace YE {
+
+namespace MeshSimplifier {
+
+    // symmetric 4x4 error matrix of a set of planes , error(p) = sum of squared distances to the planes
+    struct Quadric {
+        double a00 = 0 , a01 = 0 , a02 = 0 , a03 = 0;
+        double a11 = 0 , a12 = 0 , a13 = 0;
+        double a22 = 0 , a23 = 0;
+        double a33 = 0;
+
+        void AddPlane(const glm::dvec3& n , double d , double weight) {
+            a00 += weight * n.x * n.x; a01 += weight * n.x * n.y; a02 += weight * n.x * n.z; a03 += weight * n.x * d;
+            a11 += weight * n.y * n.y; a12 += weight * n.y * n.z; a13 += weight * n.y * d;
+            a22 += weight * n.z * n.z; a23 += weight * n.z * d;
+            a33 += weight * d * d;
+        }
+
+        void Add(const Quadric& q) {
+            a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+            a11 += q.a11; a12 += q.a12; a13 += q.a13;
+            a22 += q.a22; a23 += q.a23;
+            a33 += q.a33;
+        }
+
+        double Error(const glm::dvec3& p) const {
+            double e = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z + a33 +
+                       2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z) + 
+                       2.0 * (a03 * p.x + a13 * p.y + a23 * p.z);
+            return e < 0.0 ? 0.0 : e;
+        }
+    };
+
+    struct Collapse {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+    };
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint32_t bits[3];
+            std::memcpy(bits , &p , sizeof(bits));
+            return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        }
+    };
+
+    static uint64_t EdgeKey(uint32_t a , uint32_t b) {
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    uint32_t Simplify(const Vertex* vertices , uint32_t num_vertices , const uint32_t* indices , uint32_t num_indices , 
+                      uint32_t target_indices , float max_error , std::vector<uint32_t>& result) {
+        result.assign(indices , indices + num_indices);
+        if (num_indices % 3 != 0 || num_indices <= target_indices) 
+            return num_indices;
+
+        // vertices sharing a position form one group , quadrics and borders live on groups
+        std::vector<uint32_t> group(num_vertices);
+        std::vector<uint32_t> wedges(num_vertices , 0);
+        {
+            std::unordered_map<glm::vec3 , uint32_t , PositionHash> first;
+            first.reserve(num_vertices);
+            for (uint32_t v = 0; v < num_vertices; ++v)
+                group[v] = first.emplace(vertices[v].position , v).first->second;
+            for (uint32_t v = 0; v < num_vertices; ++v)
+                ++wedges[group[v]];
+        }
+
+        // a seam vertex would tear its chart away from the others , an open edge would shrink the outline
+        std::vector<uint8_t> locked(num_vertices , 0);
+        {
+            std::unordered_set<uint64_t> edges;
+            edges.reserve(num_indices);
+            for (uint32_t i = 0; i < num_indices; i += 3) {
+                for (uint32_t e = 0; e < 3; ++e)
+                    edges.insert(EdgeKey(group[result[i + e]] , group[result[i + (e + 1) % 3]]));
+            }
+            for (uint32_t i = 0; i < num_indices; i += 3) {
+                for (uint32_t e = 0; e < 3; ++e) {
+                    uint32_t a = group[result[i + e]];
+                    uint32_t b = group[result[i + (e + 1) % 3]];
+                    if (edges.find(EdgeKey(b , a)) == edges.end()) {
+                        locked[a] = 1;
+                        locked[b] = 1;
+                    }
+                }
+            }
+            for (uint32_t v = 0; v < num_vertices; ++v) {
+                if (wedges[group[v]] > 1 || locked[group[v]]) 
+                    locked[v] = 1;
+            }
+        }
+
+        std::vector<Quadric> quadrics(num_vertices);
+        for (uint32_t i = 0; i < num_indices; i += 3) {
+            glm::dvec3 p0 = vertices[result[i]].position;
+            glm::dvec3 p1 = vertices[result[i + 1]].position;
+            glm::dvec3 p2 = vertices[result[i + 2]].position;
+
+            glm::dvec3 n = glm::cross(p1 - p0 , p2 - p0);
+            double area = glm::length(n);
+            if (area <= 0.0) continue;
+            n /= area;
+
+            Quadric q;
+            q.AddPlane(n , -glm::dot(n , p0) , area);
+            for (uint32_t e = 0; e < 3; ++e)
+                quadrics[group[result[i + e]]].Add(q);
+        }
+
+        const double max_cost = static_cast<double>(max_error) * max_error;
+
+        std::vector<uint32_t> offsets(num_vertices + 1);
+        std::vector<uint32_t> adjacency;
+        std::vector<Collapse> candidates;
+        std::vector<uint32_t> collapse(num_vertices);
+        std::vector<uint8_t> pass_locked(num_vertices);
+
+        while (result.size() > target_indices) {
+            const uint32_t num_triangles = static_cast<uint32_t>(result.size()) / 3;
+
+            // triangles around each vertex
+            std::fill(offsets.begin() , offsets.end() , 0);
+            for (auto index : result) 
+                ++offsets[index + 1];
+            for (uint32_t v = 0; v < num_vertices; ++v) 
+                offsets[v + 1] += offsets[v];
+            adjacency.resize(result.size());
+            {
+                std::vector<uint32_t> fill(offsets.begin() , offsets.end() - 1);
+                for (uint32_t t = 0; t < num_triangles; ++t) {
+                    for (uint32_t e = 0; e < 3; ++e)
+                        adjacency[fill[result[t * 3 + e]]++] = t;
+                }
+            }
+
+            candidates.clear();
+            for (uint32_t t = 0; t < num_triangles; ++t) {
+                for (uint32_t e = 0; e < 3; ++e) {
+                    uint32_t a = result[t * 3 + e];
+                    uint32_t b = result[t * 3 + (e + 1) % 3];
+
+                    // an edge with a movable end is never open , so it shows up once from each side
+                    if (a > b || group[a] == group[b]) continue;
+
+                    Quadric q = quadrics[group[a]];
+                    q.Add(quadrics[group[b]]);
+
+                    if (!locked[a]) candidates.push_back({ a , b , q.Error(vertices[b].position) });
+                    if (!locked[b]) candidates.push_back({ b , a , q.Error(vertices[a].position) });
+                }
+            }
+
+            if (candidates.empty()) break;
+            std::sort(candidates.begin() , candidates.end() , [](const Collapse& lhs , const Collapse& rhs) {
+                return lhs.cost < rhs.cost;
+            });
+
+            for (uint32_t v = 0; v < num_vertices; ++v) 
+                collapse[v] = v;
+            std::fill(pass_locked.begin() , pass_locked.end() , 0);
+
+            // each collapse removes the two triangles on its edge , stop once the target is in reach
+            const uint32_t triangles_to_remove = num_triangles - static_cast<uint32_t>(target_indices / 3);
+            uint32_t removed = 0;
+            uint32_t collapsed = 0;
+
+            for (auto& candidate : candidates) {
+                if (removed >= triangles_to_remove || candidate.cost > max_cost) break;
+
+                const uint32_t u = candidate.from;
+                const uint32_t v = candidate.to;
+                if (pass_locked[u] || pass_locked[v]) continue;
+
+                const glm::vec3 target = vertices[v].position;
+                bool flips = false;
+                uint32_t shared = 0;
+
+                for (uint32_t i = offsets[u]; i < offsets[u + 1] && !flips; ++i) {
+                    const uint32_t* tri = &result[adjacency[i] * 3];
+                    if (tri[0] == v || tri[1] == v || tri[2] == v) {
+                        ++shared;
+                        continue;
+                    }
+
+                    glm::vec3 p[3] = { vertices[tri[0]].position , vertices[tri[1]].position , vertices[tri[2]].position };
+                    glm::vec3 before = glm::cross(p[1] - p[0] , p[2] - p[0]);
+                    for (uint32_t e = 0; e < 3; ++e) {
+                        if (tri[e] == u) p[e] = target;
+                    }
+                    glm::vec3 after = glm::cross(p[1] - p[0] , p[2] - p[0]);
+
+                    // the triangle would turn over or fold to nothing
+                    flips = glm::dot(before , after) <= 0.f;
+                }
+                if (flips) continue;
+
+                collapse[u] = v;
+                quadrics[group[v]].Add(quadrics[group[u]]);
+                removed += shared;
+                ++collapsed;
+
+                // everything touching u moved , its neighbours wait for the next pass
+                for (uint32_t i = offsets[u]; i < offsets[u + 1]; ++i) {
+                    const uint32_t* tri = &result[adjacency[i] * 3];
+                    pass_locked[tri[0]] = pass_locked[tri[1]] = pass_locked[tri[2]] = 1;
+                }
+                pass_locked[v] = 1;
+            }
+
+            if (collapsed == 0) break;
+
+            uint32_t write = 0;
+            for (uint32_t t = 0; t < num_triangles; ++t) {
+                uint32_t a = collapse[result[t * 3]];
+                uint32_t b = collapse[result[t * 3 + 1]];
+                uint32_t c = collapse[result[t * 3 + 2]];
+                if (a == b || b == c || c == a) continue;
+
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+        }
+
+        return static_cast<uint32_t>(result.size());
+    }
+
+}
+
+}
@@ -1,13 +1,21 @@
 #include "rendering/model.hpp"
 
+#include <array>
 #include <filesystem>
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 
 #include "log.hpp"
+#include "core/mapped_file.hpp"
+#include "rendering/mesh_simplifier.hpp"
 
 namespace YE {
+
+    // indexed by TextureType , "material.<type>_tex"
+    static constexpr std::array<UniformId , 4> kMaterialTextureUniforms = {
+        "material.diffuse_tex" , "material.specular_tex" , "material.normal_tex" , "material.height_tex"
+    };
     
     void Model::ProcessNode(aiNode* node , const aiScene* scene) {
         YE_CRITICAL_ASSERTION(node != nullptr , "Error: Invalid mesh");
@@ -27,6 +35,10 @@ namespace YE {
         std::vector<Vertex> yvertices{};
         std::vector<uint32_t> indices{};
 
+        BakedSubmesh submesh;
+        submesh.first_vertex = static_cast<uint32_t>(this->yvertices.size());
+        submesh.first_index = static_cast<uint32_t>(this->indices.size());
+
         num_vertices += mesh->mNumVertices;
 
         for (uint32_t i = 0; i < mesh->mNumVertices; i++) {
@@ -74,8 +86,12 @@ namespace YE {
         }
 
 
-        VertexArray* vertex_array = ynew VertexArray(yvertices , indices);
-        vaos.push_back(vertex_array);
+        AABB submesh_bounds = CalculateBounds(yvertices.data() , static_cast<uint32_t>(yvertices.size()));
+        submesh.num_vertices = static_cast<uint32_t>(yvertices.size());
+        submesh.num_indices = static_cast<uint32_t>(indices.size());
+        submesh.bounds_min = submesh_bounds.min;
+        submesh.bounds_max = submesh_bounds.max;
+        submeshes.push_back(submesh);
 
         this->yvertices.insert(this->yvertices.end() , yvertices.begin() , yvertices.end()); // = yvertices;
         this->indices.insert(this->indices.end() , indices.begin() , indices.end()); // = indices;
@@ -97,67 +113,246 @@ namespace YE {
                 this->shininess = shininess.r;
         } 
 
-        for (uint32_t i = 0; i < mat->GetTextureCount(aiTextureType_DIFFUSE); i++) {
+        ProcessTextures(mat , aiTextureType_DIFFUSE , TextureType::diffuse);
+        ProcessTextures(mat , aiTextureType_SPECULAR , TextureType::specular);
+        ProcessTextures(mat , aiTextureType_HEIGHT , TextureType::height);
+        ProcessTextures(mat , aiTextureType_NORMALS , TextureType::normal);
+
+        if (textures.size() > 0) 
+            textured = true;
+    }
+    
+    void Model::ProcessTextures(aiMaterial* material , aiTextureType ai_type , TextureType type) {
+        for (uint32_t i = 0; i < material->GetTextureCount(ai_type); i++) {
             aiString str;
-            mat->GetTexture(aiTextureType_DIFFUSE , i , &str);
+            material->GetTexture(ai_type , i , &str);
 
-            if (std::find(texture_paths.begin() , texture_paths.end() , directory + "/" + str.C_Str()) == texture_paths.end()) {
-                texture_paths.push_back(directory + "/" + str.C_Str());
-                Texture* texture = ynew Texture(directory + "/" + str.C_Str());
-                texture->SetTextureType(TextureType::diffuse);
-                textures.push_back(texture);
-            } else {
+            const std::string texture_path = directory + "/" + str.C_Str();
+            if (std::find(texture_paths.begin() , texture_paths.end() , texture_path) != texture_paths.end())
                 continue;
-            }
+
+            texture_paths.push_back(texture_path);
+            texture_refs.push_back({ type , str.C_Str() });
+
+            Texture* texture = ynew Texture(texture_path);
+            texture->SetTextureType(type);
+            textures.push_back(texture);
         }
+    }
 
-        for (uint32_t i = 0; i < mat->GetTextureCount(aiTextureType_SPECULAR); i++) {
-            aiString str;
-            mat->GetTexture(aiTextureType_SPECULAR , i , &str);
+    bool Model::LoadBaked() {
+        MappedFile* file = ynew MappedFile;
+        if (!file->Open(BakedMesh::BakedPath(path)) || !BakedMesh::Read(*file , path , baked)) {
+            ydelete file;
+            baked = BakedMeshView{};
+            return false;
+        }
 
-            if (std::find(texture_paths.begin() , texture_paths.end() , directory + "/" + str.C_Str()) == texture_paths.end()) {
-                texture_paths.push_back(directory + "/" + str.C_Str());
-                Texture* texture = ynew Texture(directory + "/" + str.C_Str());
-                texture->SetTextureType(TextureType::specular);
-                textures.push_back(texture);
-            } else {
-                continue;
-            }
+        const BakedMeshHeader& header = *baked.header;
+
+        // generated with other lod settings , import again so the levels match what was asked for
+        if (header.num_lods != std::clamp(lod_settings.num_lods , 1u , kMaxMeshLods) || 
+            header.lod_ratios != lod_settings.ratios || header.lod_max_error != lod_settings.max_error) {
+            ydelete file;
+            baked = BakedMeshView{};
+            return false;
         }
 
-        for (uint32_t i = 0; i < mat->GetTextureCount(aiTextureType_HEIGHT); i++) {
-            aiString str;
-            mat->GetTexture(aiTextureType_HEIGHT , i , &str);
+        mapping = file;
+        format = baked.Format();
+        num_lods = header.num_lods;
+        lods.assign(baked.lods , baked.lods + header.num_submeshes * header.num_lods);
+
+        // the vertex arrays point into the mapping , nothing is copied until GL reads it on upload
+        for (uint32_t i = 0; i < header.num_submeshes; ++i) {
+            const BakedSubmesh& submesh = baked.submeshes[i];
+            VertexArray* vertex_array = ynew VertexArray(
+                baked.SubmeshVertices(i) , submesh.num_vertices , 
+                baked.indices + submesh.first_index , submesh.num_indices , 
+                format , AABB(submesh.bounds_min , submesh.bounds_max)
+            );
+            vaos.push_back(vertex_array);
+        }
 
-            if (std::find(texture_paths.begin() , texture_paths.end() , directory + "/" + str.C_Str()) == texture_paths.end()) {
-                texture_paths.push_back(directory + "/" + str.C_Str());
-                Texture* texture = ynew Texture(directory + "/" + str.C_Str());
-                texture->SetTextureType(TextureType::height);
-                textures.push_back(texture);
-            } else {
-                continue;
-            }
+        for (uint32_t i = 0; i < header.num_textures; ++i) {
+            const std::string texture_path = directory + "/" + baked.TexturePath(i);
+            texture_paths.push_back(texture_path);
+
+            Texture* texture = ynew Texture(texture_path);
+            texture->SetTextureType(static_cast<TextureType>(baked.textures[i].type));
+            textures.push_back(texture);
         }
+        textured = textures.size() > 0;
 
-        for (uint32_t i = 0; i < mat->GetTextureCount(aiTextureType_NORMALS); i++) {
-            aiString str;
-            mat->GetTexture(aiTextureType_NORMALS , i , &str);
+        diffuse = header.diffuse;
+        ambient = header.ambient;
+        shininess = header.shininess;
 
-            if (std::find(texture_paths.begin() , texture_paths.end() , directory + "/" + str.C_Str()) == texture_paths.end()) {
-                texture_paths.push_back(directory + "/" + str.C_Str());
-                Texture* texture = ynew Texture(directory + "/" + str.C_Str());
-                texture->SetTextureType(TextureType::normal);
-                textures.push_back(texture);
-            } else {
-                continue;
+        bounds = AABB(header.bounds_min , header.bounds_max);
+        sphere = CalculateSphere(bounds);
+
+        num_vertices = header.num_vertices;
+        num_faces = header.num_faces;
+        num_meshes = header.num_submeshes;
+
+        return true;
+    }
+
+    void Model::Bake() {
+        BakedMeshSource source;
+        source.vertices = packed.data();
+        source.num_vertices = static_cast<uint32_t>(yvertices.size());
+        source.format = format;
+        source.indices = &lod_indices;
+        source.lods = lods;
+        source.num_lods = num_lods;
+        source.lod_ratios = lod_settings.ratios;
+        source.lod_max_error = lod_settings.max_error;
+        source.submeshes = submeshes;
+        source.textures = texture_refs;
+        source.num_faces = num_faces;
+        source.bounds = bounds;
+        source.diffuse = diffuse;
+        source.ambient = ambient;
+        source.shininess = shininess;
+
+        if (!BakedMesh::Write(BakedMesh::BakedPath(path) , path , source))
+            YE_WARN("Failed to bake model :: [{0}] | loading from source next time" , name);
+    }
+
+    void Model::LoadCollisionData() {
+        if (mapping == nullptr || !yvertices.empty()) return;
+
+        const BakedMeshHeader& header = *baked.header;
+        yvertices.resize(header.num_vertices);
+        format.Unpack(baked.vertices , header.num_vertices , yvertices.data());
+
+        // collision only wants the full detail level of each submesh
+        indices.clear();
+        for (uint32_t i = 0; i < header.num_submeshes; ++i) {
+            const uint32_t* first = baked.indices + baked.submeshes[i].first_index + baked.Lod(i , 0).first_index;
+            indices.insert(indices.end() , first , first + baked.Lod(i , 0).num_indices);
+        }
+
+        vertices.reserve(header.num_vertices * 3);
+        for (auto& v : yvertices) {
+            vertices.push_back(v.position.x);
+            vertices.push_back(v.position.y);
+            vertices.push_back(v.position.z);
+        }
+    }
+
+    void Model::BuildLods() {
+        num_lods = std::clamp(lod_settings.num_lods , 1u , kMaxMeshLods);
+
+        AABB extent;
+        for (auto& submesh : submeshes)
+            extent.Merge(AABB(submesh.bounds_min , submesh.bounds_max));
+        const float max_error = extent.Valid() ? lod_settings.max_error * glm::length(extent.max - extent.min) : 0.f;
+
+        lods.clear();
+        lod_indices.clear();
+
+        std::vector<uint32_t> current;
+        std::vector<uint32_t> simplified;
+        for (auto& submesh : submeshes) {
+            const uint32_t* source = indices.data() + submesh.first_index;
+            const uint32_t first = static_cast<uint32_t>(lod_indices.size());
+
+            lod_indices.insert(lod_indices.end() , source , source + submesh.num_indices);
+            lods.push_back({ 0 , submesh.num_indices });
+            current.assign(source , source + submesh.num_indices);
+
+            // each level starts from the one before it , far cheaper than starting over from the full mesh
+            for (uint32_t l = 1; l < num_lods; ++l) {
+                const uint32_t target = static_cast<uint32_t>(submesh.num_indices * lod_settings.ratios[l]) / 3 * 3;
+                const BakedLod previous = lods.back();
+
+                MeshSimplifier::Simplify(
+                    yvertices.data() + submesh.first_vertex , submesh.num_vertices , 
+                    current.data() , static_cast<uint32_t>(current.size()) , target , max_error , simplified
+                );
+
+                if (simplified.empty() || simplified.size() >= previous.num_indices) {
+                    lods.push_back(previous);
+                    continue;
+                }
+
+                lods.push_back({ static_cast<uint32_t>(lod_indices.size()) - first , static_cast<uint32_t>(simplified.size()) });
+                lod_indices.insert(lod_indices.end() , simplified.begin() , simplified.end());
+                current.swap(simplified);
             }
+
+            submesh.first_index = first;
+            submesh.num_indices = static_cast<uint32_t>(lod_indices.size()) - first;
+        }
+    }
+
+    void Model::PackVertices() {
+        format = VertexFormat::Select(yvertices.data() , static_cast<uint32_t>(yvertices.size()));
+
+        packed.resize(static_cast<size_t>(format.Stride()) * yvertices.size());
+        format.Pack(yvertices.data() , static_cast<uint32_t>(yvertices.size()) , packed.data());
+
+        bounds = AABB();
+        for (auto& submesh : submeshes) {
+            AABB submesh_bounds(submesh.bounds_min , submesh.bounds_max);
+            VertexArray* vertex_array = ynew VertexArray(
+                packed.data() + static_cast<size_t>(format.Stride()) * submesh.first_vertex , submesh.num_vertices , 
+                lod_indices.data() + submesh.first_index , submesh.num_indices , 
+                format , submesh_bounds
+            );
+            vaos.push_back(vertex_array);
+            bounds.Merge(submesh_bounds);
         }
+        sphere = CalculateSphere(bounds);
+    }
 
-        if (textures.size() > 0) 
-            textured = true;
+    void Model::CalculateMemory() {
+        memory = ModelMemory{};
+        for (auto& vao : vaos) {
+            memory.vertex_bytes += vao->VertexBytes();
+            memory.index_bytes += vao->IndexBytes();
+            memory.full_vertex_bytes += vao->NumVertices() * static_cast<uint32_t>(sizeof(Vertex));
+        }
+
+        std::string lod_triangles;
+        for (uint32_t l = 0; l < num_lods; ++l) {
+            uint32_t triangles = 0;
+            for (size_t i = 0; i < vaos.size(); ++i)
+                triangles += lods[i * num_lods + l].num_indices / 3;
+            lod_triangles += (l == 0 ? "" : " / ") + std::to_string(triangles);
+        }
+
+        YE_DEBUG("Model [{0}] :: {1} vertices | {2} | {3} KB vertices ({4} KB unpacked) | {5} KB indices | lod triangles {6}" , 
+                 name , num_vertices , format.Describe() , memory.vertex_bytes / 1024 , 
+                 memory.full_vertex_bytes / 1024 , memory.index_bytes / 1024 , lod_triangles);
+    }
+
+    Model::~Model() {
+        if (mapping != nullptr)
+            ydelete mapping;
     }
-    
-    void Model::Load(){
+
+    void Model::Load() {
+        if (Import())
+            Upload();
+    }
+
+    bool Model::Import() {
+        if (imported) return true;
+
+        directory = path.substr(0 , path.find_last_of('/'));
+
+        if (LoadBaked()) {
+            CalculateMemory();
+
+            for (auto& texture : textures)
+                texture->Decode();
+
+            imported = true;
+            return true;
+        }
 
         Assimp::Importer importer;
         const aiScene* scene = importer.ReadFile(path , aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace |
@@ -165,38 +360,95 @@ namespace YE {
 
         if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode){
             YE_ERROR("Unable to Load File -> {} | Assimp Error -> {}" , path , importer.GetErrorString());
-            return;
+            return false;
         }
 
-        directory = path.substr(0 , path.find_last_of('/'));
         ProcessNode(scene->mRootNode , scene);
+        num_meshes = static_cast<uint32_t>(submeshes.size());
+
+        BuildLods();
+        PackVertices();
+        CalculateMemory();
+        Bake();
+
+        for (auto& texture : textures)
+            texture->Decode();
+
+        imported = true;
+        return true;
+    }
+
+    void Model::Upload() {
+        if (!imported || valid) return;
 
         for (auto& vao : vaos)
             vao->Upload();
 
         for (auto& texture : textures)
-            texture->Load();
+            texture->Upload();
+
+        // GL has its own copy now , the source vertices stay around for collision meshes
+        std::vector<uint8_t>().swap(packed);
+        std::vector<uint32_t>().swap(lod_indices);
         
         valid = true;
     }
 
-    void Model::Draw(Shader* shader , DrawMode draw_mode) {
+    void Model::SetLodSettings(const LodSettings& settings) {
+        if (imported) {
+            YE_WARN("Failed to set lod settings :: [{0}] | model already imported" , name);
+            return;
+        }
+        lod_settings = settings;
+    }
+
+    uint32_t Model::SelectLod(float screen_size , uint32_t current) const {
+        uint32_t lod = std::min(current , num_lods - 1);
+
+        while (lod + 1 < num_lods && screen_size < lod_settings.screen_sizes[lod + 1] * (1.f - lod_settings.hysteresis))
+            ++lod;
+        while (lod > 0 && screen_size > lod_settings.screen_sizes[lod] * (1.f + lod_settings.hysteresis))
+            --lod;
+
+        return lod;
+    }
+
+    void Model::Draw(Shader* shader , DrawMode draw_mode , uint32_t lod) {
+        if (!valid) return;
+
+        uint32_t used = 0;
         if (textured) {
             for (uint32_t i = 0; i < textures.size(); i++) {
-                std::string name = textures[i]->GetTypeName();
-                shader->SetUniformInt("material." + name + "_tex" , i);
+                shader->SetUniformInt(kMaterialTextureUniforms[textures[i]->Type()] , i);
                 textures[i]->Bind(i);
+                used |= RenderState::UnitBit(i);
             }
         }
+        RenderState::ReleaseTextureUnits(used);
 
         shader->SetUniformVec3("material.ambient" , ambient);
         shader->SetUniformFloat("material.shininess" , shininess);
 
-        for (auto& vao : vaos)
-            vao->Draw(draw_mode);
+        const uint32_t level = std::min(lod , num_lods - 1);
+        for (size_t i = 0; i < vaos.size(); ++i) {
+            const BakedLod& range = lods[i * num_lods + level];
+            vaos[i]->Draw(draw_mode , range.first_index , range.num_indices);
+        }
+    }
+
+    const std::vector<Vertex>& Model::YVertices() {
+        LoadCollisionData();
+        return yvertices;
+    }
+
+    const std::vector<float>& Model::Vertices() {
+        LoadCollisionData();
+        return vertices;
+    }
 
-        for (uint32_t i = 0; i < textures.size(); i++)
-            textures[i]->Unbind(i);
+    const std::vector<uint32_t>& Model::Indices() {
+        LoadCollisionData();
+        return indices;
     }
 
     void Model::Cleanup() {
@@ -0,0 +1,129 @@
+#include "rendering/program_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "log.hpp"
+#include "core/hash.hpp"
+#include "core/filesystem.hpp"
+
+namespace YE {
+
+namespace ProgramCache {
+
+    static uint64_t Combine(uint64_t hash , std::string_view str) {
+        return (hash ^ Hash::FNV(str)) * Hash::kFnvPrime;
+    }
+
+    static std::string_view DriverString(GLenum name) {
+        const char* str = reinterpret_cast<const char*>(glGetString(name));
+        return str == nullptr ? std::string_view{} : std::string_view{ str };
+    }
+
+    bool Supported() {
+        int32_t num_formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS , &num_formats);
+        return num_formats > 0;
+    }
+
+    std::string CachePath(const std::string& vertex_path , const std::string& fragment_path , const std::string& geometry_path) {
+        uint64_t hash = Hash::kFnvOffsetBasis;
+        hash = Combine(hash , vertex_path);
+        hash = Combine(hash , fragment_path);
+        hash = Combine(hash , geometry_path);
+
+        char name[17];
+        std::snprintf(name , sizeof(name) , "%016llx" , static_cast<unsigned long long>(hash));
+        return Filesystem::GetProjectBinPath() + "/" + kProgramCacheDir + "/" + name + kProgramCacheExtension;
+    }
+
+    uint64_t Key(std::string_view vertex_src , std::string_view fragment_src , std::string_view geometry_src) {
+        uint64_t key = Hash::kFnvOffsetBasis;
+        key = Combine(key , vertex_src);
+        key = Combine(key , fragment_src);
+        key = Combine(key , geometry_src);
+
+        // a driver update invalidates every binary , most drivers reject them anyway but not all do it cleanly
+        key = Combine(key , DriverString(GL_VENDOR));
+        key = Combine(key , DriverString(GL_RENDERER));
+        key = Combine(key , DriverString(GL_VERSION));
+        return key;
+    }
+
+    bool Load(const std::string& cache_path , uint64_t key , uint32_t program) {
+        std::ifstream file(cache_path , std::ios::binary);
+        if (!file.is_open()) return false;
+
+        ProgramCacheHeader header;
+        file.read(reinterpret_cast<char*>(&header) , sizeof(ProgramCacheHeader));
+        if (!file.good() || header.magic != kProgramCacheMagic || header.version != kProgramCacheVersion ||
+            header.key != key || header.binary_size == 0)
+            return false;
+
+        std::vector<char> binary(header.binary_size);
+        file.read(binary.data() , header.binary_size);
+        if (file.gcount() != static_cast<std::streamsize>(header.binary_size))
+            return false;
+
+        glProgramBinary(program , header.binary_format , binary.data() , header.binary_size);
+
+        int32_t link_check = 0;
+        glGetProgramiv(program , GL_LINK_STATUS , &link_check);
+        return link_check == GL_TRUE;
+    }
+
+    bool Store(const std::string& cache_path , uint64_t key , uint32_t program) {
+        int32_t length = 0;
+        glGetProgramiv(program , GL_PROGRAM_BINARY_LENGTH , &length);
+        if (length <= 0) return false;
+
+        std::vector<char> binary(length);
+        GLenum binary_format = GL_NONE;
+        glGetProgramBinary(program , length , &length , &binary_format , binary.data());
+        if (length <= 0) return false;
+
+        ProgramCacheHeader header;
+        header.key = key;
+        header.binary_format = binary_format;
+        header.binary_size = static_cast<uint32_t>(length);
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(cache_path).parent_path() , ec);
+
+        const std::string temp_path = cache_path + ".tmp";
+        {
+            std::ofstream file(temp_path , std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                YE_WARN("Failed to write program cache :: [{0}] | could not open for writing" , cache_path);
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(&header) , sizeof(ProgramCacheHeader));
+            file.write(binary.data() , length);
+            if (!file.good()) {
+                YE_WARN("Failed to write program cache :: [{0}] | write failed" , cache_path);
+                file.close();
+                std::filesystem::remove(temp_path , ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temp_path , cache_path , ec);
+        if (ec) {
+            YE_WARN("Failed to write program cache :: [{0}] | {1}" , cache_path , ec.message());
+            std::filesystem::remove(temp_path , ec);
+            return false;
+        }
+
+        return true;
+    }
+
+}
+
+}
@@ -1,12 +1,90 @@
 #include "rendering/render_commands.hpp"
 
+#include <algorithm>
+
 #include "log.hpp"
 #include "core/resource_handler.hpp"
 #include "scene/components.hpp"
 
 namespace YE {
+
+    static inline UniformId TextureUniform(uint32_t unit) {
+        if (unit < kTextureUniforms.size())
+            return kTextureUniforms[unit];
+        return UniformId("tex" + std::to_string(unit));
+    }
+
+    static bool ArraysUsable(Shader* shader , Texture* const* textures , uint32_t num_textures) {
+        if (!RenderState::TextureArraysEnabled() || shader == nullptr || !shader->SupportsTextureArrays())
+            return false;
+
+        if (num_textures == 0 || num_textures > kMaxArrayTextures)
+            return false;
+
+        for (uint32_t i = 0; i < num_textures; ++i)
+            if (textures[i] == nullptr || textures[i]->Array() == nullptr) return false;
+
+        return true;
+    }
+
+    static glm::vec4 Layers(Texture* const* textures , uint32_t num_textures) {
+        glm::vec4 layers{ 0.f };
+        for (uint32_t i = 0; i < num_textures && i < kMaxArrayTextures; ++i)
+            layers[i] = static_cast<float>(textures[i]->Layer());
+        return layers;
+    }
+
+    // one texture per unit , or the arrays holding them on the array units so only the layers change between draws
+    static void BindTextures(Shader* shader , Texture* const* textures , uint32_t num_textures , bool arrays) {
+        if (shader->SupportsTextureArrays())
+            shader->SetUniformInt("texture_arrays" , arrays ? 1 : 0);
+
+        uint32_t used = 0;
+        for (uint32_t i = 0; i < num_textures; ++i) {
+            if (arrays) {
+                textures[i]->Array()->Bind(kTextureArrayUnit + i);
+                used |= RenderState::UnitBit(kTextureArrayUnit + i);
+            } else {
+                shader->SetUniformInt(TextureUniform(i) , i);
+                textures[i]->Bind(i);
+                used |= RenderState::UnitBit(i);
+            }
+        }
+
+        // units are no longer cleared after every draw , whatever the last draw bound above ours goes here
+        RenderState::ReleaseTextureUnits(used);
+    }
+
+namespace SortKey {
+
+    uint32_t TextureSet(const std::vector<Texture*>& textures) {
+        uint32_t set = 0;
+        for (auto* texture : textures) {
+            if (texture == nullptr) continue;
+            set = (set * 31) ^ texture->ID();
+        }
+        return set;
+    }
+
+    uint32_t Depth(Camera* camera , const glm::mat4& model) {
+        if (camera == nullptr) return 0;
+
+        float far_clip = camera->Clip().y;
+        if (far_clip <= 0.f) return 0;
+
+        float distance = glm::length(glm::vec3(model[3]) - camera->Position());
+        float normalized = std::clamp(distance / far_clip , 0.f , 1.f);
+
+        return static_cast<uint32_t>(normalized * static_cast<float>((1u << kDepthBits) - 1));
+    }
+
+}
     
     void RenderCommand::SetCameraUniforms(Shader* shader , Camera* camera) {
+        // the renderer uploads the camera block once per frame
+        if (shader->UsesCameraBlock())
+            return;
+
         if (camera != nullptr) {
             shader->SetUniformInt("camera_active" , 1);
             shader->SetUniformMat4("view" , camera->View());
@@ -17,6 +95,121 @@ namespace YE {
         }
     }
     
+    uint64_t DrawCommandKey(const DrawCommand& cmnd , Camera* camera , uint32_t pass) {
+        uint32_t program = cmnd.shader != nullptr ? cmnd.shader->ID() : 0;
+        uint32_t depth = SortKey::Depth(camera , cmnd.transform);
+
+        if (cmnd.type == DrawCommandType::MODEL) {
+            if (cmnd.model == nullptr)
+                return SortKey::Build(pass , program , 0 , 0 , depth);
+
+            const auto& vaos = cmnd.model->VertexArrays();
+            return SortKey::Build(
+                pass , program , SortKey::TextureSet(cmnd.model->Textures()) , 
+                vaos.empty() ? 0 : vaos.front()->ID() , depth
+            );
+        }
+
+        const bool arrays = UsesTextureArrays(cmnd);
+
+        uint32_t texture_set = 0;
+        for (uint32_t i = 0; i < cmnd.num_textures; ++i)
+            texture_set = (texture_set * 31) ^ (arrays ? cmnd.textures[i]->BatchID() : cmnd.textures[i]->ID());
+
+        return SortKey::Build(pass , program , texture_set , cmnd.vao != nullptr ? cmnd.vao->ID() : 0 , depth);
+    }
+
+    void ExecuteDrawCommand(const DrawCommand& cmnd , Camera* camera) {
+        if (cmnd.shader == nullptr) {
+            YE_WARN("Failed to execute DrawCommand :: Shader is null");
+            return;
+        }
+
+        if (cmnd.type == DrawCommandType::MODEL) {
+            if (cmnd.model == nullptr || !cmnd.model->Valid()) return;
+
+            cmnd.shader->Bind();
+            RenderCommand::SetCameraUniforms(cmnd.shader , camera);
+            cmnd.shader->SetUniformMat4("model" , cmnd.transform);
+            cmnd.model->Draw(cmnd.shader , cmnd.mode , cmnd.lod);
+            return;
+        }
+
+        if (cmnd.vao == nullptr || !cmnd.vao->Valid()) return;
+
+        const bool arrays = UsesTextureArrays(cmnd);
+
+        cmnd.shader->Bind();
+        BindTextures(cmnd.shader , cmnd.textures , cmnd.num_textures , arrays);
+        if (arrays)
+            cmnd.shader->SetUniformVec4("texture_layers" , TextureLayers(cmnd));
+        RenderCommand::SetCameraUniforms(cmnd.shader , camera);
+        cmnd.shader->SetUniformMat4("model" , cmnd.transform);
+        if (cmnd.has_light_color)
+            cmnd.shader->SetUniformVec3("light_color" , cmnd.light_color);
+        if (cmnd.has_material)
+            cmnd.shader->SetUniformFloat("material.shininess" , cmnd.shininess);
+        cmnd.vao->Draw(cmnd.mode);
+    }
+    
+    bool UsesTextureArrays(const DrawCommand& cmnd) {
+        return cmnd.type == DrawCommandType::VERTEX_ARRAY && ArraysUsable(cmnd.shader , cmnd.textures , cmnd.num_textures);
+    }
+
+    glm::vec4 TextureLayers(const DrawCommand& cmnd) {
+        return Layers(cmnd.textures , cmnd.num_textures);
+    }
+
+    bool CanInstance(const DrawCommand& lhs , const DrawCommand& rhs) {
+        if (lhs.type != DrawCommandType::VERTEX_ARRAY || rhs.type != DrawCommandType::VERTEX_ARRAY)
+            return false;
+
+        // light colors are per draw uniforms so those records keep their own draw calls
+        if (lhs.has_light_color || rhs.has_light_color)
+            return false;
+
+        if (lhs.vao != rhs.vao || lhs.shader != rhs.shader || lhs.mode != rhs.mode)
+            return false;
+
+        // the material is set once for the whole batch
+        if (lhs.has_material != rhs.has_material || lhs.shininess != rhs.shininess)
+            return false;
+
+        if (lhs.vao == nullptr || lhs.shader == nullptr || !lhs.shader->SupportsInstancing())
+            return false;
+
+        if (lhs.num_textures != rhs.num_textures)
+            return false;
+
+        // textures sharing an array only differ by layer , which every instance carries itself
+        const bool arrays = UsesTextureArrays(lhs);
+        if (arrays != UsesTextureArrays(rhs))
+            return false;
+
+        for (uint32_t i = 0; i < lhs.num_textures; ++i) {
+            if (arrays ? lhs.textures[i]->Array() != rhs.textures[i]->Array() : lhs.textures[i] != rhs.textures[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    void ExecuteInstancedDrawCommand(const DrawCommand& cmnd , const InstanceData* instances , uint32_t count , Camera* camera) {
+        if (cmnd.vao == nullptr || !cmnd.vao->Valid()) return;
+
+        cmnd.vao->UploadInstances(instances , count);
+
+        cmnd.shader->Bind();
+        BindTextures(cmnd.shader , cmnd.textures , cmnd.num_textures , UsesTextureArrays(cmnd));
+        RenderCommand::SetCameraUniforms(cmnd.shader , camera);
+        if (cmnd.has_material)
+            cmnd.shader->SetUniformFloat("material.shininess" , cmnd.shininess);
+
+        cmnd.shader->SetUniformInt("instanced" , 1);
+        cmnd.vao->DrawInstanced(cmnd.mode , count);
+        cmnd.shader->SetUniformInt("instanced" , 0);
+    }
+    
     void DrawVao::Execute(Camera* camera , const ShaderUniforms& uniforms) {
         if (vao == nullptr) {
             YE_WARN("Failed to execute DrawVao :: VAO is null");
@@ -28,93 +221,143 @@ namespace YE {
             SetCameraUniforms(shader , camera);
             shader->SetUniformMat4("model" , model);
             vao->Draw(mode);
-            shader->Unbind();
         }
 
         ydelete vao;
     }
 
+    uint64_t DrawVao::Key(Camera* camera , uint32_t pass) const {
+        return SortKey::Build(
+            pass , shader != nullptr ? shader->ID() : 0 , 0 , 
+            vao != nullptr ? vao->ID() : 0 , SortKey::Depth(camera , model)
+        );
+    }
+
+    DrawRenderable::DrawRenderable(const components::Renderable& renderable , const glm::mat4& model , DrawMode mode) 
+            : vao(renderable.vao) , shader(renderable.shader) , model(model) , mode(mode) {}
+
     void DrawRenderable::Execute(Camera* camera , const ShaderUniforms& uniforms) {
-        if (renderable.vao == nullptr) {
-            YE_WARN("Failed to execute DrawTexturedVao :: VAO is null");
-            renderable.corrupted = true;
+        if (vao == nullptr) {
+            YE_WARN("Failed to execute DrawRenderable :: VAO is null");
             return;
         }
         
-        if (renderable.vao->Valid()) {
-            renderable.shader->Bind();
-            SetCameraUniforms(renderable.shader , camera);
-            renderable.shader->SetUniformMat4("model" , model);
-            renderable.vao->Draw(mode);
-            renderable.shader->Unbind();
+        if (vao->Valid()) {
+            shader->Bind();
+            SetCameraUniforms(shader , camera);
+            shader->SetUniformMat4("model" , model);
+            vao->Draw(mode);
         }
     }
 
+    uint64_t DrawRenderable::Key(Camera* camera , uint32_t pass) const {
+        return SortKey::Build(
+            pass , shader != nullptr ? shader->ID() : 0 , 0 , 
+            vao != nullptr ? vao->ID() : 0 , SortKey::Depth(camera , model)
+        );
+    }
+
+    DrawTexturedRenderable::DrawTexturedRenderable(const components::TexturedRenderable& renderable , const glm::mat4& model , 
+                                                   DrawMode mode) 
+            : vao(renderable.vao) , shader(renderable.shader) , textures(renderable.textures) , model(model) , mode(mode) {}
+
     void DrawTexturedRenderable::Execute(Camera* camera , const ShaderUniforms& uniforms) {
-        if (renderable.vao == nullptr) {
-            YE_WARN("Failed to execute DrawTexturedVao :: VAO is null");
-            renderable.corrupted = true;
+        if (vao == nullptr) {
+            YE_WARN("Failed to execute DrawTexturedRenderable :: VAO is null");
             return;
         }
 
-        for (uint32_t i = 0; i < renderable.textures.size(); ++i)
-            if (renderable.textures[i] == nullptr) {
-                YE_WARN("Failed to execute DrawTexturedVao :: Texture [{0}] is null" , i);
-                renderable.corrupted = true;
+        for (uint32_t i = 0; i < textures.size(); ++i)
+            if (textures[i] == nullptr) {
+                YE_WARN("Failed to execute DrawTexturedRenderable :: Texture [{0}] is null" , i);
                 return;
             }
 
-        if (renderable.vao->Valid()) {
-            renderable.shader->Bind();
-            for (uint32_t i = 0; i < renderable.textures.size(); ++i) {
-                renderable.shader->SetUniformInt("tex" + std::to_string(i) , i);
-                if (renderable.textures[i] != nullptr) renderable.textures[i]->Bind(i);
-            }
-            SetCameraUniforms(renderable.shader , camera);
-            renderable.shader->SetUniformMat4("model" , model);
-            renderable.vao->Draw(mode);
-            renderable.shader->Unbind();
-            for (uint32_t i = 0; i < renderable.textures.size(); ++i)
-                if (renderable.textures[i] != nullptr) renderable.textures[i]->Unbind(i);
+        if (vao->Valid()) {
+            const uint32_t num_textures = static_cast<uint32_t>(textures.size());
+            const bool arrays = ArraysUsable(shader , textures.data() , num_textures);
+
+            shader->Bind();
+            BindTextures(shader , textures.data() , num_textures , arrays);
+            if (arrays)
+                shader->SetUniformVec4("texture_layers" , Layers(textures.data() , num_textures));
+            SetCameraUniforms(shader , camera);
+            shader->SetUniformMat4("model" , model);
+            vao->Draw(mode);
         }
     }
+
+    uint64_t DrawTexturedRenderable::Key(Camera* camera , uint32_t pass) const {
+        return SortKey::Build(
+            pass , shader != nullptr ? shader->ID() : 0 , SortKey::TextureSet(textures) ,
+            vao != nullptr ? vao->ID() : 0 , SortKey::Depth(camera , model)
+        );
+    }
+
+    DrawRenderableModel::DrawRenderableModel(const components::RenderableModel& renderable , const glm::mat4& model_matrix , 
+                                             DrawMode mode) 
+            : model(renderable.model) , shader(renderable.shader) , lod(renderable.lod) , model_matrix(model_matrix) , mode(mode) {}
     
     void DrawRenderableModel::Execute(Camera* camera , const ShaderUniforms& uniforms) {
-        if (renderable.model == nullptr) {
-            YE_WARN("Failed to execute DrawTexturedVao :: VAO is null");
-            renderable.corrupted = true;
+        if (model == nullptr) {
+            YE_WARN("Failed to execute DrawRenderableModel :: Model is null");
             return;
         }
 
-        if (renderable.model->Valid()) {
-            renderable.shader->Bind();
-            SetCameraUniforms(renderable.shader , camera);
-            renderable.shader->SetUniformMat4("model" , model_matrix);
-            renderable.model->Draw(renderable.shader , mode);
-            renderable.shader->Unbind();
+        if (model->Valid()) {
+            shader->Bind();
+            SetCameraUniforms(shader , camera);
+            shader->SetUniformMat4("model" , model_matrix);
+            model->Draw(shader , mode , lod);
+        }
+    }
+
+    uint64_t DrawRenderableModel::Key(Camera* camera , uint32_t pass) const {
+        if (model == nullptr)
+            return SortKey::Build(pass , 0 , 0 , 0 , 0);
+
+        const auto& vaos = model->VertexArrays();
+        return SortKey::Build(
+            pass , shader != nullptr ? shader->ID() : 0 , 
+            SortKey::TextureSet(model->Textures()) , 
+            vaos.empty() ? 0 : vaos.front()->ID() , SortKey::Depth(camera , model_matrix)
+        );
+    }
+
+    DrawPointLight::DrawPointLight(const components::Renderable& renderable , const components::PointLight* light , 
+                                   const glm::mat4& model_matrix , DrawMode mode) 
+            : vao(renderable.vao) , shader(renderable.shader) , model_matrix(model_matrix) , mode(mode) {
+        if (light != nullptr) {
+            light_color = light->diffuse;
+            has_light = true;
         }
     }
     
     void DrawPointLight::Execute(Camera* camera , const ShaderUniforms& uniforms) {
-        if (renderable.vao == nullptr) {
-            YE_WARN("Failed to execute DrawTexturedVao :: VAO is null");
-            renderable.corrupted = true;
+        if (vao == nullptr) {
+            YE_WARN("Failed to execute DrawPointLight :: VAO is null");
             return;
         }
 
-        if (light == nullptr) {
+        if (!has_light) {
             YE_WARN("Failed to execute DrawPointLight :: Light is null");
             return;
         }
 
-        if (renderable.vao->Valid()) {
-            renderable.shader->Bind();
-            SetCameraUniforms(renderable.shader , camera);
-            renderable.shader->SetUniformMat4("model" , model_matrix);
-            renderable.shader->SetUniformVec3("light_color" , light->diffuse);
-            renderable.vao->Draw(mode);
-            renderable.shader->Unbind();
+        if (vao->Valid()) {
+            shader->Bind();
+            SetCameraUniforms(shader , camera);
+            shader->SetUniformMat4("model" , model_matrix);
+            shader->SetUniformVec3("light_color" , light_color);
+            vao->Draw(mode);
         }
     }
 
+    uint64_t DrawPointLight::Key(Camera* camera , uint32_t pass) const {
+        return SortKey::Build(
+            pass , shader != nullptr ? shader->ID() : 0 , 0 , 
+            vao != nullptr ? vao->ID() : 0 , SortKey::Depth(camera , model_matrix)
+        );
+    }
+
 }
\ No newline at end of file
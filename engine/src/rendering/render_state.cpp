@@ -0,0 +1,134 @@
+#include "rendering/render_state.hpp"
+
+#include <bit>
+
+#include <glad/glad.h>
+
+namespace YE {
+
+    uint32_t RenderState::program = RenderState::kUnknown;
+    uint32_t RenderState::vertex_array = RenderState::kUnknown;
+    uint32_t RenderState::active_unit = RenderState::kUnknown;
+    std::array<uint32_t , RenderState::kMaxTextureUnits> RenderState::textures{};
+    std::array<uint32_t , RenderState::kMaxTextureUnits> RenderState::targets{};
+    uint32_t RenderState::bound_units = 0;
+
+    RenderStats RenderState::stats{};
+
+    bool RenderState::tracking = false;
+    bool RenderState::texture_arrays = true;
+
+    void RenderState::Begin() {
+        Invalidate();
+        tracking = true;
+    }
+
+    void RenderState::End() {
+        // hand a clean slate to whatever draws after the queues (framebuffer blit , gui)
+        ReleaseTextureUnits(0);
+        glUseProgram(0);
+        glBindVertexArray(0);
+
+        tracking = false;
+        Invalidate();
+    }
+
+    void RenderState::Invalidate() {
+        program = kUnknown;
+        vertex_array = kUnknown;
+        active_unit = kUnknown;
+        textures.fill(kUnknown);
+        bound_units = 0;
+    }
+
+    void RenderState::ResetStats() {
+        stats = RenderStats{};
+    }
+
+    void RenderState::UseProgram(uint32_t id) {
+        if (!tracking) {
+            glUseProgram(id);
+            return;
+        }
+
+        if (program == id) {
+            ++stats.program_binds_skipped;
+            return;
+        }
+
+        glUseProgram(id);
+        program = id;
+        ++stats.program_binds;
+    }
+
+    void RenderState::BindVertexArray(uint32_t id) {
+        if (!tracking) {
+            glBindVertexArray(id);
+            return;
+        }
+
+        if (vertex_array == id) {
+            ++stats.vao_binds_skipped;
+            return;
+        }
+
+        glBindVertexArray(id);
+        vertex_array = id;
+        ++stats.vao_binds;
+    }
+
+    void RenderState::BindTexture(uint32_t unit , uint32_t target , uint32_t id) {
+        if (!tracking || unit >= kMaxTextureUnits) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(target , id);
+            active_unit = kUnknown;
+            return;
+        }
+
+        if (textures[unit] == id) {
+            ++stats.texture_binds_skipped;
+            return;
+        }
+
+        if (active_unit != unit) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            active_unit = unit;
+        }
+
+        glBindTexture(target , id);
+        textures[unit] = id;
+        targets[unit] = target;
+        if (id != 0) {
+            bound_units |= UnitBit(unit);
+        } else {
+            bound_units &= ~UnitBit(unit);
+        }
+        ++stats.texture_binds;
+    }
+
+    void RenderState::ReleaseTextureUnits(uint32_t used) {
+        if (!tracking)
+            return;
+
+        for (uint32_t stale = bound_units & ~used; stale != 0; stale &= stale - 1) {
+            const uint32_t unit = static_cast<uint32_t>(std::countr_zero(stale));
+            BindTexture(unit , targets[unit] , 0);
+        }
+    }
+
+    void RenderState::ProgramDeleted(uint32_t id) {
+        if (program == id)
+            program = kUnknown;
+    }
+
+    void RenderState::VertexArrayDeleted(uint32_t id) {
+        if (vertex_array == id)
+            vertex_array = kUnknown;
+    }
+
+    void RenderState::TextureDeleted(uint32_t id) {
+        for (auto& texture : textures)
+            if (texture == id) texture = kUnknown;
+    }
+
+}
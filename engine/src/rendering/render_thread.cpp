@@ -1,11 +1,39 @@
 #include "rendering/render_thread.hpp"
 
+#include <chrono>
+
+#include <SDL.h>
+
 #include "log.hpp"
+#include "core/window.hpp"
 
 namespace YE {
 
     RenderThread* RenderThread::singleton = nullptr;
-    
+
+    void RenderThread::RenderLoop() {
+        while (true) {
+            FrameData* frame = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(frame_mutex);
+                frame_condition.wait(lock , [this]() { return pending != nullptr || !running; });
+                if (pending == nullptr)
+                    break;
+                frame = pending;
+            }
+
+            SDL_GL_MakeCurrent(window->GetSDLWindow() , window->GetGLContext());
+            Renderer::Instance()->ExecuteFrame(*frame);
+            SDL_GL_MakeCurrent(window->GetSDLWindow() , nullptr);
+
+            {
+                std::unique_lock<std::mutex> lock(frame_mutex);
+                pending = nullptr;
+            }
+            done_condition.notify_all();
+        }
+    }
+
     RenderThread* RenderThread::Instance() {
         if (singleton == nullptr) {
             singleton = ynew RenderThread;
@@ -13,25 +41,100 @@ namespace YE {
         return singleton;
     }
 
-    void RenderThread::Launch() {
-        // render_queue = std::make_unique<RenderQueue>();
-        // renderer = std::make_unique<Renderer>(render_queue->GetQueue());
+    void RenderThread::Launch(Window* window) {
+        if (running) {
+            YE_WARN("Failed to launch render thread | Already running");
+            return;
+        }
+
+        if (window == nullptr) {
+            YE_WARN("Failed to launch render thread | Window is nullptr");
+            return;
+        }
+
+        this->window = window;
+        main_thread = std::this_thread::get_id();
+        running = true;
+        context_released = false;
+
+        thread = std::make_unique<std::thread>([this]() { RenderLoop(); });
+        YE_INFO("Render thread launched");
+    }
+
+    void RenderThread::Sync() {
+        if (!running || std::this_thread::get_id() != main_thread)
+            return;
+
+        if (context_released) {
+            using Clock = std::chrono::steady_clock;
+            Clock::time_point start = Clock::now();
+            {
+                std::unique_lock<std::mutex> lock(frame_mutex);
+                done_condition.wait(lock , [this]() { return pending == nullptr; });
+            }
+            std::chrono::duration<float , std::milli> elapsed = Clock::now() - start;
+            wait_time = elapsed.count();
+
+            SDL_GL_MakeCurrent(window->GetSDLWindow() , window->GetGLContext());
+            context_released = false;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(job_mutex);
+            running_jobs.swap(jobs);
+        }
+        for (auto& job : running_jobs)
+            job();
+        running_jobs.clear();
+    }
+
+    void RenderThread::Kick(FrameData* frame) {
+        if (!running || frame == nullptr)
+            return;
+
+        // the frame before has to be done , it owns the context until then
+        Sync();
+
+        SDL_GL_MakeCurrent(window->GetSDLWindow() , nullptr);
+        context_released = true;
+        {
+            std::unique_lock<std::mutex> lock(frame_mutex);
+            pending = frame;
+        }
+        frame_condition.notify_one();
+    }
+
+    void RenderThread::Submit(RenderJob job) {
+        if (!running || (std::this_thread::get_id() == main_thread && !context_released)) {
+            job();
+            return;
+        }
 
-        // renderer->Start();
-        // thread = std::make_unique<std::thread>([this](std::unique_ptr<Renderer>& renderer) {
-        //     renderer->Render();
-        // } , std::ref(renderer));
+        std::unique_lock<std::mutex> lock(job_mutex);
+        jobs.push_back(std::move(job));
     }
 
     void RenderThread::WaitFor() {
-        // render_queue->CloseQueue();
-        // renderer->Stop();
+        if (!running)
+            return;
 
-        // thread->join();
+        Sync();
+        {
+            std::unique_lock<std::mutex> lock(frame_mutex);
+            running = false;
+        }
+        frame_condition.notify_one();
+
+        if (thread != nullptr && thread->joinable())
+            thread->join();
+        thread = nullptr;
+
+        YE_INFO("Render thread stopped");
     }
-    
+
     void RenderThread::Cleanup() {
+        WaitFor();
         if (singleton != nullptr) ydelete singleton;
     }
 
-}
\ No newline at end of file
+}
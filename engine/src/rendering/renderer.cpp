@@ -1,6 +1,10 @@
 #include "rendering/renderer.hpp"
 
 #include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <array>
+#include <algorithm>
 
 #include <SDL.h>
 #include <glad/glad.h>
@@ -17,67 +21,256 @@
 #include "rendering/vertex_array.hpp"
 #include "rendering/camera.hpp"
 #include "rendering/framebuffer.hpp"
+#include "rendering/render_thread.hpp"
 
 namespace YE {
 
     Renderer* Renderer::singleton = nullptr;
 
-    bool Renderer::CheckID(UUID32 id , const std::string& name , const RenderCallbackMap& map) {
+    struct PointLightUniformId {
+        UniformId position;
+        UniformId diffuse;
+        UniformId ambient;
+        UniformId specular;
+        UniformId constant;
+        UniformId linear;
+        UniformId quadratic;
+    };
+
+    static constexpr UniformId kPointLightCountId = "point_light_count";
+
+    // "plights[i].member" names are built once instead of every time the lights are set
+    static const std::array<PointLightUniformId , kMaxPointLights>& PointLightUniformIds() {
+        static const auto ids = []() {
+            std::array<PointLightUniformId , kMaxPointLights> ids;
+            for (uint32_t i = 0; i < kMaxPointLights; ++i) {
+                std::string base = "plights[" + std::to_string(i) + "].";
+                ids[i].position = UniformId(base + "position");
+                ids[i].diffuse = UniformId(base + "diffuse");
+                ids[i].ambient = UniformId(base + "ambient");
+                ids[i].specular = UniformId(base + "specular");
+                ids[i].constant = UniformId(base + "constant");
+                ids[i].linear = UniformId(base + "linear");
+                ids[i].quadratic = UniformId(base + "quadratic");
+            }
+            return ids;
+        }();
+        return ids;
+    }
+
+    bool Renderer::CheckID(UUID32 id , [[maybe_unused]] const std::string& name , const RenderCallbackMap& map) {
         if (map.find(id) != map.end()) {
             YE_WARN("Failed to register pre-execute callback :: [{0}] | Name already exists" , name);
             return false;
         }
         return true;
     }
-    
-    void Renderer::BeginRender() {
-        window->Clear();
-        gui->BeginRender(window->GetSDLWindow());
 
-        glPolygonMode(GL_FRONT_AND_BACK , scene_render_mode);
+    PersistentDrawList& Renderer::PersistentDraws(DrawGroup group) {
+        return group == DrawGroup::DEBUG ? debug_persistent_draws : persistent_draws;
+    }
 
-        if (framebuffer_active)
-            framebuffers[active_framebuffer]->BindFrame();
-        
-        app_handle->Draw();
+    PersistentDrawList::iterator Renderer::FindPersistentDraw(PersistentDrawList& draws , UUID id) {
+        return std::lower_bound(draws.begin() , draws.end() , id , [](const PersistentDraw& draw , UUID id) {
+            return draw.id < id;
+        });
+    }
+
+    void Renderer::AssignPersistentDraw(PersistentDraw& draw , const DrawCommand& cmnd) {
+        // an update built from PersistentRenderable already points at this draw's own texture list
+        if (cmnd.textures != draw.textures.data())
+            draw.textures.assign(cmnd.textures , cmnd.textures + cmnd.num_textures);
+
+        draw.cmnd = cmnd;
+        draw.cmnd.textures = draw.textures.data();
     }
-    
-    void Renderer::Execute() {
-        for (auto& [id , renderable] : persistent_renderables)
-            renderable->Execute(render_camera , ShaderUniforms{});
 
-        while (!commands.empty()) {
-            commands.front()->Execute(render_camera , ShaderUniforms{});
-            commands.pop();
+    DrawCommand* Renderer::RecordDraw(const DrawCommand& cmnd) {
+        FrameArena& arena = frame_arenas[frame_index];
+        DrawCommand* record = arena.New<DrawCommand>(cmnd);
+
+        // the texture list belongs to a component that can change before the frame executes
+        if (cmnd.num_textures > 0) {
+            Texture** textures = arena.NewArray<Texture*>(cmnd.num_textures);
+            for (uint32_t i = 0; i < cmnd.num_textures; ++i)
+                textures[i] = cmnd.textures[i];
+            record->textures = textures;
         }
 
-        glPolygonMode(GL_FRONT_AND_BACK , RenderMode::LINE);
+        return record;
+    }
 
-        for (auto& [id , renderable] : debug_renderables)
-            renderable->Execute(render_camera , ShaderUniforms{});
-        
-        while (!debug_commands.empty()) {
-            debug_commands.front()->Execute(render_camera , ShaderUniforms{});
-            debug_commands.pop();
+    void Renderer::RecordPersistentDraws(PersistentDrawList& draws , DrawList& records) {
+        // persistent draws join the frame's records so everything goes through one sort , the texture
+        // pointer is refreshed because inserting or erasing neighbours moves the draws around. a frame
+        // executed on the render thread gets copies since the list can change while it runs
+        for (auto& draw : draws) {
+            if (!draw.visible) continue;
+            draw.cmnd.textures = draw.textures.data();
+            records.push_back(threaded ? RecordDraw(draw.cmnd) : &draw.cmnd);
         }
+    }
 
-        render_camera = nullptr;
+    /// \note least significant digit radix sort over 8 bit digits , digits every key agrees on are skipped
+    ///     so a queue that only differs in depth and vertex array costs a couple of passes instead of eight
+    void Renderer::ApplyPointLights(Shader* shader , const LightUniforms& lights) {
+        if (shader == nullptr || shader->UsesLightBlock() || shader->UniformLocation(kPointLightCountId) < 0)
+            return;
 
-        glPolygonMode(GL_FRONT_AND_BACK , RenderMode::FILL);
+        if (std::find(lit_shaders.begin() , lit_shaders.end() , shader) != lit_shaders.end())
+            return;
+        lit_shaders.push_back(shader);
+
+        shader->Bind();
+        shader->SetUniformInt(kPointLightCountId , lights.point_light_count);
+
+        const auto& ids = PointLightUniformIds();
+        for (int32_t i = 0; i < lights.point_light_count; ++i) {
+            const PointLightUniforms& plight = lights.plights[i];
+            shader->SetUniformVec3(ids[i].position , plight.position);
+            shader->SetUniformVec3(ids[i].diffuse , plight.diffuse);
+            shader->SetUniformVec3(ids[i].ambient , plight.ambient);
+            shader->SetUniformVec3(ids[i].specular , plight.specular);
+            shader->SetUniformFloat(ids[i].constant , plight.constant);
+            shader->SetUniformFloat(ids[i].linear , plight.linear);
+            shader->SetUniformFloat(ids[i].quadratic , plight.quadratic);
+        }
+    }
+
+    void Renderer::SortQueue(const DrawList& records , const RenderQueue& queue , DrawGroup group , Camera* camera) {
+        const uint32_t num_records = static_cast<uint32_t>(records.size());
+        const uint32_t count = num_records + static_cast<uint32_t>(queue.size());
+        const uint32_t pass = static_cast<uint32_t>(group);
 
-        if (framebuffer_active)
-            framebuffers[active_framebuffer]->UnbindFrame();
+        sort_entries.resize(count);
+        sort_scratch.resize(count);
+
+        // indices below num_records refer to draw records , the rest to heap allocated commands
+        for (uint32_t i = 0; i < num_records; ++i)
+            sort_entries[i] = { DrawCommandKey(*records[i] , camera , pass) , i };
+        for (uint32_t i = num_records; i < count; ++i)
+            sort_entries[i] = { queue[i - num_records]->Key(camera , pass) , i };
+
+        if (count < 2) return;
+
+        for (uint32_t shift = 0; shift < 64; shift += 8) {
+            uint32_t histogram[256] = { 0 };
+            for (const auto& entry : sort_entries)
+                ++histogram[(entry.key >> shift) & 0xFF];
+
+            if (histogram[(sort_entries[0].key >> shift) & 0xFF] == count)
+                continue;
+
+            uint32_t offset = 0;
+            for (uint32_t& bucket : histogram) {
+                uint32_t bucket_size = bucket;
+                bucket = offset;
+                offset += bucket_size;
+            }
+
+            for (const auto& entry : sort_entries)
+                sort_scratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+
+            sort_entries.swap(sort_scratch);
+        }
+    }
+
+    void Renderer::ExecuteQueue(DrawList& records , RenderQueue& queue , DrawGroup group , Camera* camera , 
+                                const LightUniforms& lights) {
+        SortQueue(records , queue , group , camera);
+
+        const uint32_t num_records = static_cast<uint32_t>(records.size());
+        const uint32_t count = static_cast<uint32_t>(sort_entries.size());
+
+        uint32_t i = 0;
+        while (i < count) {
+            const SortEntry& entry = sort_entries[i];
+            if (entry.index >= num_records) {
+                queue[entry.index - num_records]->Execute(camera , ShaderUniforms{});
+                RenderState::CountCommand();
+                ++i;
+                continue;
+            }
+
+            // the sort already put records sharing shader , textures and vertex array next to each other
+            const DrawCommand& cmnd = *records[entry.index];
+            uint32_t end = i + 1;
+            while (end < count && sort_entries[end].index < num_records && 
+                   CanInstance(cmnd , *records[sort_entries[end].index]))
+                ++end;
+
+            const uint32_t run = end - i;
+            ApplyPointLights(cmnd.shader , lights);
+            if (run >= kMinInstanceBatch) {
+                instance_data.clear();
+                for (uint32_t j = i; j < end; ++j) {
+                    const DrawCommand& instance = *records[sort_entries[j].index];
+                    instance_data.push_back({ instance.transform , TextureLayers(instance) });
+                }
+
+                ExecuteInstancedDrawCommand(cmnd , instance_data.data() , run , camera);
+                RenderState::CountInstancedBatch(run);
+                RenderState::CountCommand(run);
+            } else {
+                for (uint32_t j = i; j < end; ++j) {
+                    ApplyPointLights(records[sort_entries[j].index]->shader , lights);
+                    ExecuteDrawCommand(*records[sort_entries[j].index] , camera);
+                    RenderState::CountCommand();
+                }
+            }
+
+            i = end;
+        }
+
+        // clear keeps the capacity , the records themselves go away when their arena resets
+        records.clear();
+        queue.clear();
     }
     
-    void Renderer::EndRender() {
-        if (framebuffer_active)
-            framebuffers[active_framebuffer]->Draw();
+    void Renderer::Record() {
+        FrameData& frame = frames[frame_index];
+
+        // the frame before this one has been synced , its stats are final
+        frame_stats = frames[(frame_index + kFramesInFlight - 1) % kFramesInFlight].stats;
+
+        gui->BeginRender(window->GetSDLWindow());
+        app_handle->Draw();
 
         gui->Render(window);
         app_handle->DrawGui();
-        gui->EndRender(window->GetSDLWindow() , window->GetGLContext());
+        gui->EndRender();
 
-        window->SwapBuffers();
+        RecordPersistentDraws(persistent_draws , frame.draw_commands);
+        RecordPersistentDraws(debug_persistent_draws , frame.debug_draw_commands);
+
+        frame.has_camera = render_camera != nullptr;
+        if (render_camera != nullptr)
+            frame.camera.CopyFrameState(*render_camera);
+        render_camera = nullptr;
+
+        // only the lights in use are copied , the upload never reads past light_upload_size. the block only
+        //  goes up when it changed , shaders without it read the copy as plain uniforms every frame
+        std::memcpy(&frame.light_uniforms , &light_uniforms , light_upload_size);
+        frame.light_upload_size = light_upload_size;
+        frame.lights_dirty = lights_dirty;
+        lights_dirty = false;
+
+        frame.framebuffer = nullptr;
+        if (framebuffer_active && framebuffers.find(active_framebuffer) != framebuffers.end())
+            frame.framebuffer = framebuffers[active_framebuffer];
+
+        frame.viewport = window->GetSize();
+        frame.clear_color = window->ClearColor();
+        frame.render_mode = scene_render_mode;
+
+        frame.arena_bytes = static_cast<uint32_t>(frame_arenas[frame_index].Used());
+        frame.persistent_commands = static_cast<uint32_t>(persistent_draws.size() + debug_persistent_draws.size());
+        frame.persistent_updates = persistent_updates;
+        frame.cull_tested = cull_tested;
+        frame.cull_visible = cull_visible;
+        persistent_updates = 0;
+        cull_tested = 0;
+        cull_visible = 0;
     }
 
     Renderer* Renderer::Instance() {
@@ -99,15 +292,29 @@ namespace YE {
         PostRenderCallbacks[id] = callback;
     }
 
-    void Renderer::Initialize(App* app) {
+    void Renderer::Initialize(App* app , bool threaded) {
         app_handle = app;
+        this->threaded = threaded;
         window = ynew Window(app->GetWindowConfig());
         gui = ynew Gui;
+
+        for (auto& frame : frames) {
+            frame.draw_commands.reserve(kInitialDrawListSize);
+            frame.debug_draw_commands.reserve(kInitialDrawListSize);
+        }
+        sort_entries.reserve(kInitialDrawListSize);
+        sort_scratch.reserve(kInitialDrawListSize);
+        instance_data.reserve(kInitialDrawListSize);
+        lit_shaders.reserve(kInitialLitShaders);
     }
     
     void Renderer::OpenWindow() {
         window->Open();
-        gui->Initialize(window);
+        gui->Initialize(window , !threaded);
+
+        camera_buffer = ynew UniformBuffer(sizeof(CameraUniforms) , UniformBinding::CAMERA);
+        light_buffer = ynew UniformBuffer(sizeof(LightUniforms) , UniformBinding::LIGHTS);
+        lights_dirty = true;
 
         window->Clear();
         window->SwapBuffers();
@@ -129,11 +336,105 @@ namespace YE {
     }
 
     void Renderer::SubmitRenderCmnd(std::unique_ptr<RenderCommand>& cmnd) {
-        commands.push(std::move(cmnd));
+        frames[frame_index].commands.push_back(std::move(cmnd));
     }
 
     void Renderer::SubmitDebugRenderCmnd(std::unique_ptr<RenderCommand>& cmnd) {
-        debug_commands.push(std::move(cmnd));
+        frames[frame_index].debug_commands.push_back(std::move(cmnd));
+    }
+
+    void Renderer::SubmitDraw(const DrawCommand& cmnd , DrawGroup group) {
+        DrawCommand* record = RecordDraw(cmnd);
+        if (group == DrawGroup::DEBUG) {
+            frames[frame_index].debug_draw_commands.push_back(record);
+        } else {
+            frames[frame_index].draw_commands.push_back(record);
+        }
+    }
+
+    void Renderer::PushRenderable(UUID id , const DrawCommand& cmnd , DrawGroup group) {
+        PersistentDrawList& draws = PersistentDraws(group);
+
+        auto itr = FindPersistentDraw(draws , id);
+        if (itr != draws.end() && itr->id == id) {
+            YE_WARN("Failed to push renderable :: [{0}] | ID already exists" , id.uuid);
+            return;
+        }
+
+        itr = draws.insert(itr , PersistentDraw{ id , DrawCommand{} , {} });
+        AssignPersistentDraw(*itr , cmnd);
+        ++persistent_updates;
+    }
+
+    void Renderer::PushRenderable(const std::string& name , const DrawCommand& cmnd , DrawGroup group) {
+        PushRenderable(Hash::FNV32(name) , cmnd , group);
+    }
+
+    void Renderer::UpdateRenderCmnd(UUID id , const DrawCommand& new_cmnd , DrawGroup group) {
+        PersistentDrawList& draws = PersistentDraws(group);
+
+        auto itr = FindPersistentDraw(draws , id);
+        if (itr == draws.end() || itr->id != id) {
+            YE_WARN("Failed to update renderable :: [{0}] | Did you push it to the renderer?" , id.uuid);
+            return;
+        }
+
+        AssignPersistentDraw(*itr , new_cmnd);
+        ++persistent_updates;
+    }
+
+    void Renderer::UpdateRenderCmnd(const std::string& name , const DrawCommand& new_cmnd , DrawGroup group) {
+        UpdateRenderCmnd(Hash::FNV32(name) , new_cmnd , group);
+    }
+
+    void Renderer::UpdateRenderTransform(UUID id , const glm::mat4& transform , DrawGroup group) {
+        PersistentDrawList& draws = PersistentDraws(group);
+
+        auto itr = FindPersistentDraw(draws , id);
+        if (itr == draws.end() || itr->id != id) {
+            YE_WARN("Failed to update renderable transform :: [{0}] | Did you push it to the renderer?" , id.uuid);
+            return;
+        }
+
+        itr->cmnd.transform = transform;
+        ++persistent_updates;
+    }
+
+    void Renderer::SetRenderableVisible(UUID id , bool visible , DrawGroup group) {
+        PersistentDrawList& draws = PersistentDraws(group);
+
+        auto itr = FindPersistentDraw(draws , id);
+        if (itr == draws.end() || itr->id != id) {
+            YE_WARN("Failed to set renderable visibility :: [{0}] | Did you push it to the renderer?" , id.uuid);
+            return;
+        }
+
+        itr->visible = visible;
+    }
+
+    void Renderer::RemoveRenderCmnd(UUID id , DrawGroup group) {
+        PersistentDrawList& draws = PersistentDraws(group);
+
+        auto itr = FindPersistentDraw(draws , id);
+        if (itr == draws.end() || itr->id != id) 
+            return;
+
+        draws.erase(itr);
+        ++persistent_updates;
+    }
+
+    void Renderer::RemoveRenderCmnd(const std::string& name , DrawGroup group) {
+        RemoveRenderCmnd(Hash::FNV32(name) , group);
+    }
+
+    const DrawCommand* Renderer::PersistentRenderable(UUID id , DrawGroup group) {
+        PersistentDrawList& draws = PersistentDraws(group);
+
+        auto itr = FindPersistentDraw(draws , id);
+        if (itr == draws.end() || itr->id != id)
+            return nullptr;
+
+        return &itr->cmnd;
     }
 
     void Renderer::PopFramebuffer(const std::string& name) {
@@ -210,18 +511,128 @@ namespace YE {
         render_camera = camera;
     }
 
+    void Renderer::UploadCameraUniforms(Camera* camera) {
+        if (camera_buffer == nullptr)
+            return;
+
+        if (camera != nullptr) {
+            camera_uniforms.view = camera->View();
+            camera_uniforms.proj = camera->Projection();
+            camera_uniforms.view_proj = camera_uniforms.proj * camera_uniforms.view;
+            camera_uniforms.view_pos = camera->Position();
+            camera_uniforms.camera_active = 1;
+        } else {
+            camera_uniforms.camera_active = 0;
+        }
+
+        camera_buffer->Upload(camera_uniforms);
+    }
+
+    void Renderer::SetCullingStats(uint32_t tested , uint32_t visible) {
+        cull_tested = tested;
+        cull_visible = visible;
+    }
+
+    void Renderer::UpdatePointLights(const std::vector<components::PointLight>& lights) {
+        uint32_t count = static_cast<uint32_t>(lights.size());
+        if (count > kMaxPointLights) {
+            YE_WARN("Failed to upload all point lights :: [{0}] | Only the first {1} are used" , count , kMaxPointLights);
+            count = kMaxPointLights;
+        }
+
+        LightUniforms* block = &light_uniforms;
+        bool changed = block->point_light_count != static_cast<int32_t>(count);
+        block->point_light_count = static_cast<int32_t>(count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            PointLightUniforms plight;
+            plight.position = lights[i].position;
+            plight.diffuse = lights[i].diffuse;
+            plight.ambient = lights[i].ambient;
+            plight.specular = lights[i].specular;
+            plight.constant = lights[i].constant_attenuation;
+            plight.linear = lights[i].linear_attenuation;
+            plight.quadratic = lights[i].quadratic_attenuation;
+
+            if (std::memcmp(&plight , &block->plights[i] , sizeof(PointLightUniforms)) != 0) {
+                block->plights[i] = plight;
+                changed = true;
+            }
+        }
+
+        // only the lights in use go over the bus , the shader never reads past point_light_count
+        light_upload_size = static_cast<uint32_t>(offsetof(LightUniforms , plights) + count * sizeof(PointLightUniforms));
+        lights_dirty = lights_dirty || changed;
+    }
+
     void Renderer::SetSceneRenderMode(RenderMode mode) {
         scene_render_mode = mode;
     }
 
     void Renderer::Render() {
+        RenderThread* render_thread = RenderThread::Instance();
+        render_thread->Sync();
+
         for (auto& [id , cb] : PreRenderCallbacks)
             cb();
-        BeginRender();
-        Execute();
-        EndRender();
+
+        Record();
+        if (render_thread->Running()) {
+            render_thread->Kick(&frames[frame_index]);
+        } else {
+            ExecuteFrame(frames[frame_index]);
+        }
+
+        // with a render thread these run while the frame executes , they must not touch GL
         for (auto& [id , cb] : PostRenderCallbacks)
             cb();
+
+        frame_index = (frame_index + 1) % kFramesInFlight;
+        frame_arenas[frame_index].Reset();
+    }
+
+    void Renderer::ExecuteFrame(FrameData& frame) {
+        window->Clear(frame.viewport , frame.clear_color);
+        glPolygonMode(GL_FRONT_AND_BACK , frame.render_mode);
+
+        if (frame.framebuffer != nullptr)
+            frame.framebuffer->BindFrame();
+
+        RenderState::ResetStats();
+        RenderState::Begin();
+
+        Camera* camera = frame.has_camera ? &frame.camera : nullptr;
+        UploadCameraUniforms(camera);
+        if (frame.lights_dirty && light_buffer != nullptr) {
+            light_buffer->Upload(frame.light_uniforms , frame.light_upload_size);
+            frame.lights_dirty = false;
+        }
+
+        lit_shaders.clear();
+        ExecuteQueue(frame.draw_commands , frame.commands , DrawGroup::DEFAULT , camera , frame.light_uniforms);
+
+        glPolygonMode(GL_FRONT_AND_BACK , RenderMode::LINE);
+
+        ExecuteQueue(frame.debug_draw_commands , frame.debug_commands , DrawGroup::DEBUG , camera , frame.light_uniforms);
+
+        RenderState::End();
+        frame.stats = RenderState::Stats();
+        frame.stats.frame_arena_bytes = frame.arena_bytes;
+        frame.stats.persistent_commands = frame.persistent_commands;
+        frame.stats.persistent_updates = frame.persistent_updates;
+        frame.stats.cull_tested = frame.cull_tested;
+        frame.stats.cull_visible = frame.cull_visible;
+
+        glPolygonMode(GL_FRONT_AND_BACK , RenderMode::FILL);
+
+        if (frame.framebuffer != nullptr) {
+            frame.framebuffer->UnbindFrame();
+            frame.framebuffer->Draw();
+        }
+
+        gui->Draw(window->GetSDLWindow() , window->GetGLContext());
+
+        window->SwapBuffers();
     }
     
     void Renderer::CloseWindow() {
@@ -230,13 +641,13 @@ namespace YE {
     }
     
     void Renderer::Cleanup() {
-        for (auto& [id , renderable] : persistent_renderables)
-            ydelete renderable;
-        persistent_renderables.clear();
+        persistent_draws.clear();
+        debug_persistent_draws.clear();
 
-        for (auto& [id , renderable] : debug_renderables)
-            ydelete renderable;
-        debug_renderables.clear();
+        if (camera_buffer != nullptr) ydelete camera_buffer;
+        if (light_buffer != nullptr) ydelete light_buffer;
+        camera_buffer = nullptr;
+        light_buffer = nullptr;
 
         for (auto& [id , fb] : framebuffers)
             ydelete fb;
@@ -8,21 +8,86 @@
 #include "core/hash.hpp"
 #include "core/filesystem.hpp"
 #include "rendering/gl_error_helper.hpp"
+#include "rendering/vertex.hpp"
+#include "rendering/program_cache.hpp"
+#include "rendering/texture_array.hpp"
 
 namespace YE {
 
-    uint32_t Shader::GetUniformLocation(const std::string& name) {
-        UUID32 id = Hash::FNV32(name);
-        
-        if (uniform_locations.find(id) != uniform_locations.end())
-            return uniform_locations[id];
+    void Shader::InsertUniform(std::string_view name , int32_t location) {
+        uint32_t hash = Hash::FNV32(name);
 
-        int32_t location = glGetUniformLocation(program , name.c_str());
-        uniform_locations[id] = location;
+        for (uint32_t i = hash & uniform_mask; ; i = (i + 1) & uniform_mask) {
+            UniformSlot& slot = uniform_table[i];
+            if (slot.location == -1) {
+                slot.hash = hash;
+                slot.location = location;
+                return;
+            }
 
-        return location;
+            if (slot.hash == hash) {
+                if (slot.location != location)
+                    YE_WARN("Failed to register uniform :: [{0}] | Name hash collides with another uniform in [{1}]" , name , this->name);
+                return;
+            }
+        }
+    }
+
+    void Shader::BuildUniformTable() {
+        int32_t num_uniforms = 0;
+        int32_t max_length = 0;
+        glGetProgramiv(program , GL_ACTIVE_UNIFORMS , &num_uniforms);
+        glGetProgramiv(program , GL_ACTIVE_UNIFORM_MAX_LENGTH , &max_length);
+
+        std::vector<std::pair<std::string , int32_t>> active;
+        std::vector<char> buffer(max_length + 1 , '\0');
+
+        for (int32_t i = 0; i < num_uniforms; ++i) {
+            int32_t length = 0;
+            int32_t size = 0;
+            uint32_t type = 0;
+            glGetActiveUniform(program , i , max_length + 1 , &length , &size , &type , buffer.data());
+
+            // block members and built-ins have no location
+            int32_t location = glGetUniformLocation(program , buffer.data());
+            if (location == -1)
+                continue;
+
+            std::string name(buffer.data() , length);
+            active.emplace_back(name , location);
+
+            // arrays are reported as "name[0]" , GL also accepts the bare name and every element
+            if (name.size() > 3 && name.compare(name.size() - 3 , 3 , "[0]") == 0) {
+                std::string base = name.substr(0 , name.size() - 3);
+                active.emplace_back(base , location);
+
+                for (int32_t e = 1; e < size; ++e) {
+                    std::string element = base + "[" + std::to_string(e) + "]";
+                    active.emplace_back(element , glGetUniformLocation(program , element.c_str()));
+                }
+            }
+        }
+
+        uint32_t capacity = 16;
+        while (capacity < active.size() * 2)
+            capacity <<= 1;
+
+        uniform_table.assign(capacity , UniformSlot{});
+        uniform_mask = capacity - 1;
+
+        for (const auto& [name , location] : active)
+            InsertUniform(name , location);
     }
     
+    bool Shader::BindUniformBlock(const char* block , UniformBinding binding) {
+        uint32_t index = glGetUniformBlockIndex(program , block);
+        if (index == GL_INVALID_INDEX)
+            return false;
+
+        glUniformBlockBinding(program , index , static_cast<uint32_t>(binding));
+        return true;
+    }
+
     void Shader::ShaderError(ShaderType type , uint32_t shader) {
         char info_log[512];
         glGetShaderInfoLog(shader , 512 , nullptr , info_log);
@@ -58,6 +123,7 @@ namespace YE {
         int32_t compile_check = 0;
 
         program = glCreateProgram();
+        glProgramParameteri(program , GL_PROGRAM_BINARY_RETRIEVABLE_HINT , GL_TRUE);
         glAttachShader(program , vertex_shader);
         glAttachShader(program , fragment_shader);
         if (has_geometry)
@@ -72,6 +138,8 @@ namespace YE {
             YE_WARN("Failed to link shader program");
             YE_ERROR("Error: {0}" , info_log);
             valid = false;
+        } else {
+            QueryProgram();
         }
         
         glDeleteShader(vertex_shader);
@@ -80,24 +148,76 @@ namespace YE {
             glDeleteShader(geometry_shader);
     }
 
+    // everything here is program state a binary does not carry , so it runs after either kind of link
+    void Shader::QueryProgram() {
+        // instanced batches feed the model matrix through this attribute instead of the "model" uniform
+        instancing = glGetAttribLocation(program , "in_instance_model") == static_cast<int32_t>(kInstanceAttributeLocation);
+
+        // shaders declaring the shared blocks read camera and light data from the renderer's uniform buffers
+        camera_block = BindUniformBlock("Camera" , UniformBinding::CAMERA);
+        light_block = BindUniformBlock("Lights" , UniformBinding::LIGHTS);
+
+        BuildUniformTable();
+
+        // array samplers are pinned to their own units once , draws only bind the arrays there
+        texture_arrays = UniformLocation(kTextureArrayUniforms[0]) != -1;
+        for (uint32_t i = 0; texture_arrays && i < kTextureArrayUniforms.size(); ++i) {
+            int32_t location = UniformLocation(kTextureArrayUniforms[i]);
+            if (location != -1)
+                glProgramUniform1i(program , location , kTextureArrayUnit + i);
+        }
+    }
+
     Shader::~Shader() {
         glUseProgram(0);
         glDeleteProgram(program);
+        RenderState::ProgramDeleted(program);
+    }
+    
+    void Shader::ReadSources() {
+        vertex_src = YE::Filesystem::ReadFileAsStr(vertex_path);
+        fragment_src = YE::Filesystem::ReadFileAsStr(fragment_path);
+        geometry_src = has_geometry ? YE::Filesystem::ReadFileAsStr(geometry_path) : "";
+        sources_read = true;
     }
     
     bool Shader::Compile() {
         valid = true;
 
-        std::string vert_str = YE::Filesystem::ReadFileAsStr(vertex_path);
-        std::string frag_str = YE::Filesystem::ReadFileAsStr(fragment_path);
-        std::string geom_str = has_geometry ? YE::Filesystem::ReadFileAsStr(geometry_path) : "";
+        if (!sources_read)
+            ReadSources();
+
+        const std::string vert_str = std::move(vertex_src);
+        const std::string frag_str = std::move(fragment_src);
+        const std::string geom_str = std::move(geometry_src);
+        vertex_src.clear();
+        fragment_src.clear();
+        geometry_src.clear();
+        sources_read = false;
+
+        // the sources are hashed as they are handed to GL , a stale or rejected binary falls through to them
+        const bool use_cache = ProgramCache::Supported();
+        std::string cache_path = "";
+        uint64_t cache_key = 0;
+        if (use_cache) {
+            cache_path = ProgramCache::CachePath(vertex_path , fragment_path , geometry_path);
+            cache_key = ProgramCache::Key(vert_str , frag_str , geom_str);
+
+            program = glCreateProgram();
+            if (ProgramCache::Load(cache_path , cache_key , program)) {
+                from_cache = true;
+                QueryProgram();
+                return valid;
+            }
+
+            glDeleteProgram(program);
+            program = 0;
+        }
 
         const char* vert_src = vert_str.c_str();
         const char* frag_src = frag_str.c_str();
         const char* geom_src = geom_str.c_str();
 
-        int32_t compile_check = 0;
-
         CompileShader(ShaderType::VERTEX , vertex_shader , vert_src);
         CompileShader(ShaderType::FRAGMENT , fragment_shader , frag_src);
         if (has_geometry)
@@ -105,12 +225,37 @@ namespace YE {
 
         Link();
 
+        if (valid && use_cache)
+            ProgramCache::Store(cache_path , cache_key , program);
+
         return valid;
     }
+
+    bool Shader::Recompile() {
+        const uint32_t previous = program;
+        program = 0;
+
+        if (!Compile()) {
+            if (program != 0)
+                glDeleteProgram(program);
+
+            program = previous;
+            valid = previous != 0;
+            return false;
+        }
+
+        if (previous != 0) {
+            glDeleteProgram(previous);
+            RenderState::ProgramDeleted(previous);
+        }
+        return true;
+    }
     
     void Shader::SetUniform(const Uniform& uniform) {
         YE_CRITICAL_ASSERTION(uniform.data.data_handle != nullptr , "Attempting to set uniform with no data");
 
+        const UniformId id = uniform.id;
+
         uint32_t ival;
         float fval;
         glm::vec2 vec2;
@@ -121,63 +266,63 @@ namespace YE {
         switch (uniform.data.type) {
             case UniformType::INT: 
                 ival = *static_cast<uint32_t*>(uniform.data.data_handle);
-                SetUniformInt(uniform.name , ival);
+                SetUniformInt(id , ival);
             break;
             case UniformType::FLOAT: 
                 fval = *static_cast<float*>(uniform.data.data_handle);
-                SetUniformFloat(uniform.name , fval);
+                SetUniformFloat(id , fval);
             break;
             case UniformType::VEC2: 
                 vec2 = *static_cast<glm::vec2*>(uniform.data.data_handle);
-                SetUniformVec2(uniform.name , vec2);
+                SetUniformVec2(id , vec2);
             break;
             case UniformType::VEC3: 
                 vec3 = *static_cast<glm::vec3*>(uniform.data.data_handle);
-                SetUniformVec3(uniform.name , vec3);
+                SetUniformVec3(id , vec3);
             break;
             case UniformType::VEC4: 
                 vec4 = *static_cast<glm::vec4*>(uniform.data.data_handle);
-                SetUniformVec4(uniform.name , vec4);
+                SetUniformVec4(id , vec4);
             break;
             case UniformType::MAT3: 
                 mat3 = *static_cast<glm::mat3*>(uniform.data.data_handle);
-                SetUniformMat3(uniform.name , mat3);
+                SetUniformMat3(id , mat3);
             break;
             case UniformType::MAT4: 
                 mat4 = *static_cast<glm::mat4*>(uniform.data.data_handle);
-                SetUniformMat4(uniform.name , mat4);
+                SetUniformMat4(id , mat4);
             break;
             default:
                 YE_CRITICAL_ASSERTION(false , "Invalid uniform type");
         }
     }
 
-    void Shader::SetUniformInt(const std::string& name , uint32_t val) {
-        glUniform1i(GetUniformLocation(name) , val);
+    void Shader::SetUniformInt(UniformId id , uint32_t val) {
+        glUniform1i(UniformLocation(id) , val);
     }
 
-    void Shader::SetUniformFloat(const std::string& name , float val) {
-        glUniform1f(GetUniformLocation(name) , val);
+    void Shader::SetUniformFloat(UniformId id , float val) {
+        glUniform1f(UniformLocation(id) , val);
     }
 
-    void Shader::SetUniformVec2(const std::string& name , const glm::vec2& val) {
-        glUniform2f(GetUniformLocation(name) , val.x , val.y);
+    void Shader::SetUniformVec2(UniformId id , const glm::vec2& val) {
+        glUniform2f(UniformLocation(id) , val.x , val.y);
     }
 
-    void Shader::SetUniformVec3(const std::string& name , const glm::vec3& val) {
-        glUniform3f(GetUniformLocation(name) , val.x , val.y , val.z);
+    void Shader::SetUniformVec3(UniformId id , const glm::vec3& val) {
+        glUniform3f(UniformLocation(id) , val.x , val.y , val.z);
     }
 
-    void Shader::SetUniformVec4(const std::string& name , const glm::vec4& val) {
-        glUniform4f(GetUniformLocation(name) , val.x , val.y , val.z , val.w);
+    void Shader::SetUniformVec4(UniformId id , const glm::vec4& val) {
+        glUniform4f(UniformLocation(id) , val.x , val.y , val.z , val.w);
     }
 
-    void Shader::SetUniformMat3(const std::string& name , const glm::mat3& mat) {
-        glUniformMatrix3fv(GetUniformLocation(name) , 1 , GL_FALSE , glm::value_ptr(mat));
+    void Shader::SetUniformMat3(UniformId id , const glm::mat3& mat) {
+        glUniformMatrix3fv(UniformLocation(id) , 1 , GL_FALSE , glm::value_ptr(mat));
     }
     
-    void Shader::SetUniformMat4(const std::string& name , const glm::mat4& mat) {
-        glUniformMatrix4fv(GetUniformLocation(name) , 1 , GL_FALSE , glm::value_ptr(mat));
+    void Shader::SetUniformMat4(UniformId id , const glm::mat4& mat) {
+        glUniformMatrix4fv(UniformLocation(id) , 1 , GL_FALSE , glm::value_ptr(mat));
     }
     
 }
\ No newline at end of file
@@ -4,19 +4,114 @@
 #include <stb_image.h>
 
 #include "log.hpp"
+#include "core/hash.hpp"
+#include "core/mapped_file.hpp"
+#include "rendering/render_state.hpp"
 
 namespace YE {
 
+    uint32_t Texture::placeholder = 0;
+    bool Texture::block_compression = false;
+
     Texture::~Texture() {
-        stbi_image_free(pixels);
-        pixels = nullptr;
+        if (cache != nullptr)
+            ydelete cache;
+
+        if (texture != 0) {
+            glDeleteTextures(1 , &texture);
+            RenderState::TextureDeleted(texture);
+        }
+
+        if (array != nullptr)
+            array->ReleaseLayer(layer);
+    }
+
+    void Texture::CreatePlaceholder() {
+        if (placeholder != 0) return;
+
+        block_compression = GLAD_GL_EXT_texture_compression_s3tc != 0;
+
+        const uint8_t checker[] = {
+            255 , 0 , 255 , 255 ,   0 , 0 , 0 , 255 ,
+            0 , 0 , 0 , 255 ,       255 , 0 , 255 , 255
+        };
+
+        glGenTextures(1 , &placeholder);
+        glBindTexture(GL_TEXTURE_2D , placeholder);
+        glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_WRAP_S , GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_WRAP_T , GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_MIN_FILTER , GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_MAG_FILTER , GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D , 0 , GL_RGBA , 2 , 2 , 0 , GL_RGBA , GL_UNSIGNED_BYTE , checker);
+    }
+
+    void Texture::DestroyPlaceholder() {
+        if (placeholder == 0) return;
 
-        glDeleteTextures(1 , &texture);
+        glDeleteTextures(1 , &placeholder);
+        RenderState::TextureDeleted(placeholder);
+        placeholder = 0;
     }
 
     void Texture::Load(TargetType target , ChannelType channels) {
+        Decode();
+        Upload(target , channels);
+    }
+
+    void Texture::Decode() {
+        if (decoded) return;
+        decoded = true;
+
+        const std::string cache_path = TextureCache::CachePath(path);
+        const bool compressed = compress && block_compression && type != TextureType::normal;
+
+        cache = ynew MappedFile;
+        if (cache->Open(cache_path) && TextureCache::Read(cache->Data() , cache->Size() , path , view) &&
+            TextureCache::IsCompressed(view.header->format) == compressed) {
+            size = glm::ivec2(view.header->width , view.header->height);
+            num_channels = view.header->source_channels;
+            return;
+        }
+
+        ydelete cache;
+        cache = nullptr;
+        view = TextureCacheView{};
+
+        // the source is read once , the same bytes are hashed for the cache key and decoded
+        MappedFile source;
+        if (!source.Open(path)) return;
+
+        const uint8_t* source_data = source.Data();
+        const int source_size = static_cast<int>(source.Size());
+
+        uint8_t* pixels = stbi_load_from_memory(source_data , source_size , &size.x , &size.y , &num_channels , 0);
+        if (pixels != nullptr && num_channels == 2) {
+            stbi_image_free(pixels);
+            pixels = stbi_load_from_memory(source_data , source_size , &size.x , &size.y , &num_channels , 4);
+            num_channels = 4;
+        }
+        if (pixels == nullptr) return;
+
+        const uint32_t source_hash = Hash::CRC32(source_data , source.Size());
+        const bool built_ok = TextureCache::Build(path , source_hash , pixels , size.x , size.y , num_channels , compressed , built);
+        stbi_image_free(pixels);
+
+        if (!built_ok || !TextureCache::View(built.data() , built.size() , view)) {
+            built.clear();
+            view = TextureCacheView{};
+            return;
+        }
+
+        TextureCache::Write(cache_path , built);
+    }
+
+    void Texture::Upload(TargetType target , ChannelType channels , TextureArrayManager* arrays) {
+        if (ready) return;
+
         this->target = target;
         this->channels = channels;
+
+        Decode();
         
         glGenTextures(1 , &texture);
 
@@ -25,10 +120,7 @@ namespace YE {
         glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_WRAP_S , GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_WRAP_T , GL_REPEAT);
 
-        int num_channels = 0;
-        pixels = stbi_load(path.c_str() , &size.x , &size.y , &num_channels , 0);
-
-        if (pixels == nullptr) {
+        if (view.header == nullptr) {
             YE_ERROR("Failed to load texture :: {0}" , path);
             YE_WARN("Using default texture");
 
@@ -57,13 +149,87 @@ namespace YE {
                 YE_CRITICAL_ASSERTION(false , "Invalid number of channels");
             }
 
-            glTexImage2D(GL_TEXTURE_2D , 0 , channels , size.x , size.y , 0 , channels , GL_UNSIGNED_BYTE , pixels);
+            const TextureCacheHeader& header = *view.header;
+            const GLenum internal_format = TextureCache::InternalFormat(header.format);
+            const GLenum pixel_format = TextureCache::PixelFormat(header.format);
+            const bool compressed = TextureCache::IsCompressed(header.format);
+
+            if (arrays != nullptr && target == TEX_2D)
+                array = arrays->Place(view , layer);
+
+            uint64_t gpu_bytes = 0;
+            uint64_t raw_bytes = 0;
+            for (uint32_t i = 0; i < header.num_mips; ++i) {
+                gpu_bytes += view.mips[i].size;
+                raw_bytes += uint64_t{ view.mips[i].width } * view.mips[i].height * header.source_channels;
+            }
+
+            if (array != nullptr) {
+                // the layer already holds the mips , a view of it shares that storage instead of copying it
+                glBindTexture(GL_TEXTURE_2D , 0);
+                glDeleteTextures(1 , &texture);
+                glGenTextures(1 , &texture);
+                glTextureView(texture , GL_TEXTURE_2D , array->ID() , internal_format , 0 , header.num_mips , layer , 1);
+
+                glBindTexture(GL_TEXTURE_2D , texture);
+                glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_WRAP_S , GL_REPEAT);
+                glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_WRAP_T , GL_REPEAT);
+            } else {
+                // mips go straight from the cache into immutable storage , nothing is generated on the GPU
+                glTexStorage2D(GL_TEXTURE_2D , header.num_mips , internal_format , header.width , header.height);
+                glPixelStorei(GL_UNPACK_ALIGNMENT , 1);
+
+                for (uint32_t i = 0; i < header.num_mips; ++i) {
+                    const TextureCacheMip& mip = view.mips[i];
+                    if (compressed) {
+                        glCompressedTexSubImage2D(GL_TEXTURE_2D , i , 0 , 0 , mip.width , mip.height , internal_format , 
+                                                  static_cast<GLsizei>(mip.size) , view.MipData(i));
+                    } else {
+                        glTexSubImage2D(GL_TEXTURE_2D , i , 0 , 0 , mip.width , mip.height , pixel_format , GL_UNSIGNED_BYTE , view.MipData(i));
+                    }
+                }
+
+                glPixelStorei(GL_UNPACK_ALIGNMENT , 4);
+            }
 
-            glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_MIN_FILTER , GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_MIN_FILTER , header.num_mips > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D , GL_TEXTURE_MAG_FILTER , GL_LINEAR);
-            
-            glGenerateMipmap(GL_TEXTURE_2D);
+
+            YE_DEBUG("Texture [{0}] :: {1}x{2} | {3} | {4} mips | {5} KB ({6} KB uncompressed) | {7}" , path , header.width , header.height ,
+                     TextureCache::FormatName(header.format) , header.num_mips , gpu_bytes / 1024 , raw_bytes / 1024 , 
+                     array != nullptr ? "array layer " + std::to_string(layer) : std::string("standalone"));
+        }
+
+        // the GL texture owns the data now
+        if (cache != nullptr)
+            ydelete cache;
+        cache = nullptr;
+        std::vector<uint8_t>().swap(built);
+        view = TextureCacheView{};
+
+        ready = true;
+    }
+
+    void Texture::Reload(TextureArrayManager* arrays) {
+        if (view.header == nullptr) {
+            YE_WARN("Failed to reload texture :: [{0}] | keeping the previous image" , path);
+            return;
+        }
+
+        if (texture != 0) {
+            glDeleteTextures(1 , &texture);
+            RenderState::TextureDeleted(texture);
+            texture = 0;
         }
+
+        if (array != nullptr) {
+            array->ReleaseLayer(layer);
+            array = nullptr;
+            layer = 0;
+        }
+
+        ready = false;
+        Upload(target , channels , arrays);
     }
             
     void Texture::SetFilterType(FilterType filter) {
@@ -95,13 +261,11 @@ namespace YE {
     }
 
     void Texture::Bind(uint32_t pos) const {
-        glActiveTexture(GL_TEXTURE0 + pos);
-        glBindTexture(target , texture);
+        RenderState::BindTexture(pos , target , ID());
     }
 
     void Texture::Unbind(uint32_t pos) const {
-        glActiveTexture(GL_TEXTURE0 + pos);
-        glBindTexture(target , 0);
+        RenderState::BindTexture(pos , target , 0);
     }
 
     std::string Texture::GetTypeName() const {
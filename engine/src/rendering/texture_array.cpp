@@ -0,0 +1,117 @@
+#include "rendering/texture_array.hpp"
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "log.hpp"
+#include "rendering/render_state.hpp"
+
+namespace YE {
+
+    TextureArray::TextureArray(TextureFormat format , uint32_t width , uint32_t height , uint32_t num_mips , uint32_t capacity)
+            : format(format) , width(width) , height(height) , num_mips(num_mips) , capacity(capacity) {
+        glGenTextures(1 , &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY , texture);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY , num_mips , TextureCache::InternalFormat(format) , width , height , capacity);
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY , GL_TEXTURE_WRAP_S , GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY , GL_TEXTURE_WRAP_T , GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY , GL_TEXTURE_MIN_FILTER , num_mips > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY , GL_TEXTURE_MAG_FILTER , GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D_ARRAY , 0);
+    }
+
+    TextureArray::~TextureArray() {
+        if (texture != 0) {
+            glDeleteTextures(1 , &texture);
+            RenderState::TextureDeleted(texture);
+        }
+    }
+
+    bool TextureArray::Matches(const TextureCacheHeader& header) const {
+        return header.format == format && header.width == width && header.height == height && header.num_mips == num_mips;
+    }
+
+    uint32_t TextureArray::AddLayer(const TextureCacheView& view) {
+        uint32_t layer = num_layers;
+        if (!free_layers.empty()) {
+            layer = free_layers.back();
+            free_layers.pop_back();
+        } else {
+            ++num_layers;
+        }
+
+        const GLenum internal_format = TextureCache::InternalFormat(format);
+        const GLenum pixel_format = TextureCache::PixelFormat(format);
+        const bool compressed = TextureCache::IsCompressed(format);
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY , texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT , 1);
+        for (uint32_t i = 0; i < num_mips; ++i) {
+            const TextureCacheMip& mip = view.mips[i];
+            if (compressed) {
+                glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY , i , 0 , 0 , layer , mip.width , mip.height , 1 , internal_format ,
+                                          static_cast<GLsizei>(mip.size) , view.MipData(i));
+            } else {
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY , i , 0 , 0 , layer , mip.width , mip.height , 1 , pixel_format ,
+                                GL_UNSIGNED_BYTE , view.MipData(i));
+            }
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT , 4);
+        glBindTexture(GL_TEXTURE_2D_ARRAY , 0);
+
+        return layer;
+    }
+
+    void TextureArray::ReleaseLayer(uint32_t layer) {
+        if (layer < num_layers)
+            free_layers.push_back(layer);
+    }
+
+    void TextureArray::Bind(uint32_t unit) const {
+        RenderState::BindTexture(unit , GL_TEXTURE_2D_ARRAY , texture);
+    }
+
+    TextureArrayManager::~TextureArrayManager() {
+        Cleanup();
+    }
+
+    TextureArray* TextureArrayManager::Place(const TextureCacheView& view , uint32_t& layer) {
+        if (view.header == nullptr) return nullptr;
+
+        const TextureCacheHeader& header = *view.header;
+        for (auto* array : arrays) {
+            if (array->Matches(header) && !array->Full()) {
+                layer = array->AddLayer(view);
+                return array;
+            }
+        }
+
+        uint64_t layer_bytes = 0;
+        for (uint32_t i = 0; i < header.num_mips; ++i)
+            layer_bytes += view.mips[i].size;
+
+        const uint64_t capacity = std::min<uint64_t>(kTextureArrayBudget / layer_bytes , kTextureArrayLayers);
+        if (capacity < 2) return nullptr;
+
+        TextureArray* array = ynew TextureArray(header.format , header.width , header.height , header.num_mips , 
+                                                static_cast<uint32_t>(capacity));
+        if (array->ID() == 0) {
+            YE_WARN("Failed to create texture array :: {0}x{1} {2}" , header.width , header.height , TextureCache::FormatName(header.format));
+            ydelete array;
+            return nullptr;
+        }
+
+        arrays.push_back(array);
+        layer = array->AddLayer(view);
+        return array;
+    }
+
+    void TextureArrayManager::Cleanup() {
+        for (auto* array : arrays)
+            ydelete array;
+        arrays.clear();
+    }
+
+}
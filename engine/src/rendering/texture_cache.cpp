@@ -0,0 +1,309 @@
+#include "rendering/texture_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+#include "log.hpp"
+#include "core/hash.hpp"
+#include "core/mapped_file.hpp"
+#include "rendering/baked_mesh.hpp"
+
+namespace YE {
+
+namespace TextureCache {
+
+    static uint64_t Align(uint64_t offset) {
+        return (offset + kTextureCacheAlignment - 1) & ~static_cast<uint64_t>(kTextureCacheAlignment - 1);
+    }
+
+    static bool InFile(uint64_t offset , uint64_t bytes , size_t file_size) {
+        return offset % kTextureCacheAlignment == 0 && offset <= file_size && bytes <= file_size - offset;
+    }
+
+    static uint32_t BlockBytes(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::BC1: return 8;
+            case TextureFormat::BC3: return 16;
+            case TextureFormat::BC4: return 8;
+            default: return 0;
+        }
+    }
+
+    static uint32_t FormatChannels(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::R8: return 1;
+            case TextureFormat::RGB8: return 3;
+            case TextureFormat::RGBA8: return 4;
+            default: return 0;
+        }
+    }
+
+    // 2x2 box filter , odd edges reuse the last row/column like glGenerateMipmap does
+    static void Downsample(const uint8_t* src , uint32_t width , uint32_t height , uint32_t channels ,
+                           uint8_t* dst , uint32_t dst_width , uint32_t dst_height) {
+        for (uint32_t y = 0; y < dst_height; ++y) {
+            const uint8_t* row0 = src + static_cast<size_t>(std::min(2 * y , height - 1)) * width * channels;
+            const uint8_t* row1 = src + static_cast<size_t>(std::min(2 * y + 1 , height - 1)) * width * channels;
+
+            for (uint32_t x = 0; x < dst_width; ++x) {
+                const uint32_t x0 = std::min(2 * x , width - 1) * channels;
+                const uint32_t x1 = std::min(2 * x + 1 , width - 1) * channels;
+
+                for (uint32_t c = 0; c < channels; ++c) {
+                    const uint32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                    *dst++ = static_cast<uint8_t>((sum + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    // blocks hanging over the edge of the level repeat the edge pixels
+    static void CompressLevel(const uint8_t* src , uint32_t width , uint32_t height , uint32_t channels ,
+                              TextureFormat format , uint8_t* dst) {
+        const uint32_t block_bytes = BlockBytes(format);
+
+        uint8_t block[16 * 4];
+        for (uint32_t by = 0; by < height; by += 4) {
+            for (uint32_t bx = 0; bx < width; bx += 4) {
+                for (uint32_t i = 0; i < 16; ++i) {
+                    const uint32_t x = std::min(bx + (i & 3) , width - 1);
+                    const uint32_t y = std::min(by + (i >> 2) , height - 1);
+                    const uint8_t* pixel = src + (static_cast<size_t>(y) * width + x) * channels;
+
+                    if (format == TextureFormat::BC4) {
+                        block[i] = pixel[0];
+                    } else {
+                        block[i * 4 + 0] = pixel[0];
+                        block[i * 4 + 1] = channels > 1 ? pixel[1] : pixel[0];
+                        block[i * 4 + 2] = channels > 2 ? pixel[2] : pixel[0];
+                        block[i * 4 + 3] = channels > 3 ? pixel[3] : 255;
+                    }
+                }
+
+                if (format == TextureFormat::BC4) {
+                    stb_compress_bc4_block(dst , block);
+                } else {
+                    stb_compress_dxt_block(dst , block , format == TextureFormat::BC3 ? 1 : 0 , STB_DXT_HIGHQUAL);
+                }
+                dst += block_bytes;
+            }
+        }
+    }
+
+    bool IsCompressed(TextureFormat format) {
+        return BlockBytes(format) != 0;
+    }
+
+    uint64_t MipBytes(TextureFormat format , uint32_t width , uint32_t height) {
+        if (IsCompressed(format)) {
+            const uint64_t blocks_x = (uint64_t{ width } + 3) / 4;
+            const uint64_t blocks_y = (uint64_t{ height } + 3) / 4;
+            return blocks_x * blocks_y * BlockBytes(format);
+        }
+        return uint64_t{ width } * height * FormatChannels(format);
+    }
+
+    uint32_t NumMips(uint32_t width , uint32_t height) {
+        uint32_t num_mips = 1;
+        for (uint32_t extent = std::max(width , height); extent > 1; extent >>= 1)
+            ++num_mips;
+        return std::min(num_mips , kMaxTextureMips);
+    }
+
+    GLenum InternalFormat(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::R8: return GL_R8;
+            case TextureFormat::RGB8: return GL_RGB8;
+            case TextureFormat::RGBA8: return GL_RGBA8;
+            case TextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TextureFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+            default: return GL_NONE;
+        }
+    }
+
+    GLenum PixelFormat(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::R8: return GL_RED;
+            case TextureFormat::RGB8: return GL_RGB;
+            case TextureFormat::RGBA8: return GL_RGBA;
+            default: return GL_NONE;
+        }
+    }
+
+    const char* FormatName(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::R8: return "R8";
+            case TextureFormat::RGB8: return "RGB8";
+            case TextureFormat::RGBA8: return "RGBA8";
+            case TextureFormat::BC1: return "BC1";
+            case TextureFormat::BC3: return "BC3";
+            case TextureFormat::BC4: return "BC4";
+            default: return "unknown";
+        }
+    }
+
+    TextureFormat ChooseFormat(const uint8_t* pixels , uint32_t width , uint32_t height , uint32_t channels , bool compress) {
+        if (channels == 1)
+            return compress ? TextureFormat::BC4 : TextureFormat::R8;
+        if (channels == 3)
+            return compress ? TextureFormat::BC1 : TextureFormat::RGB8;
+        if (!compress)
+            return TextureFormat::RGBA8;
+
+        const size_t num_pixels = static_cast<size_t>(width) * height;
+        for (size_t i = 0; i < num_pixels; ++i) {
+            if (pixels[i * 4 + 3] != 255)
+                return TextureFormat::BC3;
+        }
+        return TextureFormat::BC1;
+    }
+
+    bool Build(const std::string& source_path , uint32_t source_hash , const uint8_t* pixels ,
+               uint32_t width , uint32_t height , uint32_t channels , bool compress , std::vector<uint8_t>& result) {
+        if (pixels == nullptr || width == 0 || height == 0 || channels == 0 || channels > 4 || channels == 2)
+            return false;
+
+        TextureCacheHeader header;
+        if (!BakedMesh::SourceStamp(source_path , header.source_size , header.source_time)) {
+            YE_WARN("Failed to build texture cache :: [{0}] | source missing" , source_path);
+            return false;
+        }
+
+        header.source_hash = source_hash;
+        header.source_channels = channels;
+        header.format = ChooseFormat(pixels , width , height , channels , compress);
+        header.width = width;
+        header.height = height;
+        header.num_mips = NumMips(width , height);
+        header.mip_offset = Align(sizeof(TextureCacheHeader));
+
+        std::vector<TextureCacheMip> mips(header.num_mips);
+        uint64_t offset = Align(header.mip_offset + sizeof(TextureCacheMip) * header.num_mips);
+        for (uint32_t i = 0; i < header.num_mips; ++i) {
+            mips[i].width = std::max(width >> i , 1u);
+            mips[i].height = std::max(height >> i , 1u);
+            mips[i].offset = offset;
+            mips[i].size = MipBytes(header.format , mips[i].width , mips[i].height);
+            offset = Align(offset + mips[i].size);
+        }
+
+        result.assign(offset , 0);
+        std::memcpy(result.data() , &header , sizeof(TextureCacheHeader));
+        std::memcpy(result.data() + header.mip_offset , mips.data() , sizeof(TextureCacheMip) * mips.size());
+
+        // level 0 is the source itself , every other level is filtered from the one above it
+        std::vector<uint8_t> level , next;
+        const uint8_t* current = pixels;
+        for (uint32_t i = 0; i < header.num_mips; ++i) {
+            if (i > 0) {
+                next.resize(static_cast<size_t>(mips[i].width) * mips[i].height * channels);
+                Downsample(current , mips[i - 1].width , mips[i - 1].height , channels , next.data() , mips[i].width , mips[i].height);
+                level.swap(next);
+                current = level.data();
+            }
+
+            uint8_t* dst = result.data() + mips[i].offset;
+            if (IsCompressed(header.format)) {
+                CompressLevel(current , mips[i].width , mips[i].height , channels , header.format , dst);
+            } else {
+                std::memcpy(dst , current , mips[i].size);
+            }
+        }
+
+        return true;
+    }
+
+    bool Write(const std::string& cache_path , const std::vector<uint8_t>& image) {
+        const std::string temp_path = cache_path + ".tmp";
+        {
+            std::ofstream file(temp_path , std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                YE_WARN("Failed to write texture cache :: [{0}] | could not open for writing" , cache_path);
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(image.data()) , static_cast<std::streamsize>(image.size()));
+            if (!file.good()) {
+                YE_WARN("Failed to write texture cache :: [{0}] | write failed" , cache_path);
+                file.close();
+                std::error_code ec;
+                std::filesystem::remove(temp_path , ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path , cache_path , ec);
+        if (ec) {
+            YE_WARN("Failed to write texture cache :: [{0}] | {1}" , cache_path , ec.message());
+            std::filesystem::remove(temp_path , ec);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool View(const uint8_t* data , size_t size , TextureCacheView& view) {
+        if (data == nullptr || size < sizeof(TextureCacheHeader)) return false;
+
+        const TextureCacheHeader* header = reinterpret_cast<const TextureCacheHeader*>(data);
+        if (header->magic != kTextureCacheMagic || header->version != kTextureCacheVersion)
+            return false;
+
+        if (header->format > TextureFormat::BC4 || header->width == 0 || header->height == 0 ||
+            header->num_mips == 0 || header->num_mips > NumMips(header->width , header->height))
+            return false;
+
+        if (!InFile(header->mip_offset , sizeof(TextureCacheMip) * uint64_t{ header->num_mips } , size))
+            return false;
+
+        const TextureCacheMip* mips = reinterpret_cast<const TextureCacheMip*>(data + header->mip_offset);
+        for (uint32_t i = 0; i < header->num_mips; ++i) {
+            if (mips[i].width != std::max(header->width >> i , 1u) || mips[i].height != std::max(header->height >> i , 1u) ||
+                mips[i].size != MipBytes(header->format , mips[i].width , mips[i].height) ||
+                !InFile(mips[i].offset , mips[i].size , size)) {
+                return false;
+            }
+        }
+
+        view.header = header;
+        view.mips = mips;
+        view.data = data;
+        return true;
+    }
+
+    bool Read(const uint8_t* data , size_t size , const std::string& source_path , TextureCacheView& view) {
+        TextureCacheView candidate;
+        if (!View(data , size , candidate)) {
+            YE_WARN("Failed to read texture cache :: [{0}] | invalid or outdated" , source_path);
+            return false;
+        }
+
+        // a cache shipped without its source is used as is
+        uint64_t source_size = 0;
+        int64_t source_time = 0;
+        if (BakedMesh::SourceStamp(source_path , source_size , source_time)) {
+            if (source_size != candidate.header->source_size)
+                return false;
+
+            if (source_time != candidate.header->source_time) {
+                MappedFile source;
+                if (!source.Open(source_path) || Hash::CRC32(source.Data() , source.Size()) != candidate.header->source_hash)
+                    return false;
+            }
+        }
+
+        view = candidate;
+        return true;
+    }
+
+}
+
+}
@@ -0,0 +1,38 @@
+#include "rendering/uniform_buffer.hpp"
+
+#include <glad/glad.h>
+
+#include "log.hpp"
+
+namespace YE {
+
+    UniformBuffer::UniformBuffer(uint32_t size , UniformBinding binding)
+            : binding(static_cast<uint32_t>(binding)) , size(size) {
+        glGenBuffers(1 , &ubo);
+        glBindBuffer(GL_UNIFORM_BUFFER , ubo);
+        glBufferData(GL_UNIFORM_BUFFER , size , nullptr , GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER , 0);
+
+        Bind();
+    }
+
+    UniformBuffer::~UniformBuffer() {
+        glDeleteBuffers(1 , &ubo);
+    }
+
+    void UniformBuffer::Upload(const void* data , uint32_t size , uint32_t offset) {
+        if (offset + size > this->size) {
+            YE_ERROR("Failed to upload uniform buffer data :: [{0}] bytes at offset [{1}] overflows buffer of [{2}] bytes" , size , offset , this->size);
+            return;
+        }
+
+        glBindBuffer(GL_UNIFORM_BUFFER , ubo);
+        glBufferSubData(GL_UNIFORM_BUFFER , offset , size , data);
+        glBindBuffer(GL_UNIFORM_BUFFER , 0);
+    }
+
+    void UniformBuffer::Bind() const {
+        glBindBufferBase(GL_UNIFORM_BUFFER , binding , ubo);
+    }
+
+}
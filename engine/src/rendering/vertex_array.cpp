@@ -1,43 +1,50 @@
 #include "rendering/vertex_array.hpp"
 
 #include <vector>
+#include <algorithm>
 
 #include <glm/glm.hpp>
 
 #include "log.hpp"
 #include "rendering/gl_error_helper.hpp"
+#include "rendering/render_state.hpp"
 
 namespace YE {
 
-    void VertexArray::LoadVertices() {
-        for (auto& v : yvertices) {
-            vertices.push_back(v.position.x);
-            vertices.push_back(v.position.y);
-            vertices.push_back(v.position.z);
+    void VertexArray::SetupInstanceAttributes() {
+        instance_stride = 0;
+        for (auto& l : instance_layout)
+            instance_stride += l;
+        instance_stride *= sizeof(float);
 
-            vertices.push_back(v.color.x);
-            vertices.push_back(v.color.y);
-            vertices.push_back(v.color.z);
+        glGenBuffers(1 , &instance_VBO);
 
-            vertices.push_back(v.normal.x);
-            vertices.push_back(v.normal.y);
-            vertices.push_back(v.normal.z);
+        RenderState::BindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER , instance_VBO);
 
-            vertices.push_back(v.tangent.x);
-            vertices.push_back(v.tangent.y);
-            vertices.push_back(v.tangent.z);
+        uint32_t offset = 0;
+        for (size_t i = 0; i < instance_layout.size(); ++i) {
+            uint32_t location = kInstanceAttributeLocation + static_cast<uint32_t>(i);
+            glVertexAttribPointer(location , instance_layout[i] , GL_FLOAT , GL_FALSE , instance_stride , (void*)(offset * sizeof(float)));
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location , 1);
 
-            vertices.push_back(v.bitangent.x);
-            vertices.push_back(v.bitangent.y);
-            vertices.push_back(v.bitangent.z);
+            offset += instance_layout[i];
+        }
 
-            vertices.push_back(v.texcoord.x);
-            vertices.push_back(v.texcoord.y);
+        glBindBuffer(GL_ARRAY_BUFFER , 0);
+    }
 
-            vertices.push_back(v.opacity);
-        }
+    VertexArray::VertexArray(const void* vertices , uint32_t num_vertices , const uint32_t* indices , uint32_t num_indices , 
+                             const VertexFormat& format , const AABB& bounds , BufferType buffer_type) 
+            : layout(Vertex::Layout()) , buffer_type(buffer_type) , format(format) , formatted(true) , 
+              vertex_data(static_cast<const uint8_t*>(vertices)) , index_data(indices) , 
+              vertex_count(num_vertices) , index_count(num_indices) , bounds(bounds) {
+        stride = format.Stride();
 
-        stride = Vertex::Size();
+        has_indices = num_indices > 0;
+        sphere = CalculateSphere(bounds);
+        prepared = true;
     }
 
     VertexArray::~VertexArray() {
@@ -45,66 +52,174 @@ namespace YE {
             if (has_indices) {
                 glDeleteBuffers(1, &EBO);
             }
+            if (instance_VBO != 0) {
+                glDeleteBuffers(1 , &instance_VBO);
+            }
             glDeleteBuffers(1, &VBO);
             glDeleteVertexArrays(1, &VAO);
+            RenderState::VertexArrayDeleted(VAO);
         }
     }
 
-    void VertexArray::Upload() {
+    void VertexArray::CalculateBounds() {
+        const uint32_t floats_per_vertex = stride / sizeof(float);
+        if (floats_per_vertex == 0 || layout.empty()) return;
+
+        const uint32_t count = static_cast<uint32_t>(vertices.size()) / floats_per_vertex;
+        bounds = YE::CalculateBounds(vertices.data() , count , floats_per_vertex , layout[0]);
+        sphere = CalculateSphere(bounds);
+    }
+
+    void VertexArray::Prepare() {
+        if (prepared) return;
+
         if (indices.size() > 0) {
             has_indices = true;
         }
 
         if (yverts) {
-            LoadVertices();
+            stride = format.Stride();
+            vertex_count = static_cast<uint32_t>(yvertices.size());
+
+            packed.resize(static_cast<size_t>(stride) * vertex_count);
+            format.Pack(yvertices.data() , vertex_count , packed.data());
+            vertex_data = packed.data();
+
+            bounds = YE::CalculateBounds(yvertices.data() , vertex_count);
+            sphere = CalculateSphere(bounds);
         } else {
             for (auto& l : layout)
                 stride += l;
             stride *= sizeof(uint32_t);
+
+            CalculateBounds();
+
+            vertex_data = reinterpret_cast<const uint8_t*>(vertices.data());
+            vertex_count = stride == 0 ? 0 : static_cast<uint32_t>(vertices.size() * sizeof(float) / stride);
         }
 
+        index_data = indices.data();
+        index_count = static_cast<uint32_t>(indices.size());
+
+        prepared = true;
+    }
+
+    void VertexArray::Upload() {
+        Prepare();
+
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
         if (has_indices) glGenBuffers(1, &EBO);
 
-        glBindVertexArray(VAO);
+        RenderState::BindVertexArray(VAO);
+
+        const GLsizeiptr vertex_bytes = static_cast<GLsizeiptr>(vertex_count) * stride;
+        const GLsizeiptr constants_offset = (vertex_bytes + 15) & ~GLsizeiptr{ 15 };
+        const uint32_t num_constants = formatted ? format.NumConstants() : 0;
 
         glBindBuffer(GL_ARRAY_BUFFER , VBO);
-        glBufferData(GL_ARRAY_BUFFER , sizeof(float) * vertices.size() , vertices.data() , buffer_type);
+        if (num_constants == 0) {
+            glBufferData(GL_ARRAY_BUFFER , vertex_bytes , vertex_data , buffer_type);
+        } else {
+            // defaults of the attributes the format leaves out live after the vertices in the same buffer
+            std::vector<float> constants(num_constants * 4);
+            format.WriteConstants(constants.data());
+
+            const GLsizeiptr constants_bytes = static_cast<GLsizeiptr>(constants.size() * sizeof(float));
+
+            glBufferData(GL_ARRAY_BUFFER , constants_offset + constants_bytes , nullptr , buffer_type);
+            glBufferSubData(GL_ARRAY_BUFFER , 0 , vertex_bytes , vertex_data);
+            glBufferSubData(GL_ARRAY_BUFFER , constants_offset , constants_bytes , constants.data());
+        }
 
         if (has_indices) {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER , EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER , sizeof(uint32_t) * indices.size() , indices.data() , buffer_type);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER , sizeof(uint32_t) * index_count , index_data , buffer_type);
         }
 
-        uint32_t offset = 0;
-        for (size_t i = 0; i < layout.size(); ++i) {
-            glVertexAttribPointer(i , layout[i] , GL_FLOAT, GL_FALSE , stride , (void*)(offset * sizeof(float))); 
-            glEnableVertexAttribArray(i);
+        if (formatted) {
+            format.SetupAttributes(static_cast<uint32_t>(constants_offset));
+        } else {
+            uint32_t offset = 0;
+            for (size_t i = 0; i < layout.size(); ++i) {
+                glVertexAttribPointer(i , layout[i] , GL_FLOAT, GL_FALSE , stride , (void*)(offset * sizeof(float))); 
+                glEnableVertexAttribArray(i);
 
-            offset += layout[i];
+                offset += layout[i];
+            }
         }
 
         glBindBuffer(GL_ARRAY_BUFFER , 0);
-        glBindVertexArray(0);
+        RenderState::BindVertexArray(0);
 
         valid = true;
     }
     
     void VertexArray::Draw(DrawMode mode) const {
+        Draw(mode , 0 , has_indices ? index_count : vertex_count);
+    }
+
+    void VertexArray::Draw(DrawMode mode , uint32_t first , uint32_t count) const {
         if (!valid) {
             YE_ERROR("Rendering Invalid Vertex Array");
         } else {
-            glBindVertexArray(VAO);
+            // left bound on purpose , the next draw usually shares it once the queue is sorted
+            RenderState::BindVertexArray(VAO);
 
             if (has_indices) {
-                glDrawElements(mode , indices.size() , GL_UNSIGNED_INT , (void*)0);
+                glDrawElements(mode , count , GL_UNSIGNED_INT , (void*)(static_cast<uintptr_t>(first) * sizeof(uint32_t)));
             } else {
-                glDrawArrays(mode , 0 , vertices.size());
+                glDrawArrays(mode , first , count);
             }
 
-            glBindVertexArray(0);
+            RenderState::CountDraw();
+            if (mode == DrawMode::TRIANGLES) RenderState::CountTriangles(count / 3);
+        }
+    }
+
+    void VertexArray::SetInstanceLayout(const std::vector<uint32_t>& layout) {
+        if (instance_VBO != 0) {
+            YE_WARN("Failed to set instance layout :: Instance buffer already created");
+            return;
+        }
+        instance_layout = layout;
+    }
+
+    void VertexArray::UploadInstances(const void* data , uint32_t count) {
+        if (!valid || count == 0) return;
+
+        if (instance_VBO == 0)
+            SetupInstanceAttributes();
+
+        const uint32_t size = instance_stride * count;
+
+        // grow geometrically so a slowly growing batch does not reallocate every frame
+        if (size > instance_capacity)
+            instance_capacity = std::max(size , instance_capacity * 2);
+
+        // respecifying the store orphans the old one so a batch drawn from it earlier this frame is not waited on
+        glBindBuffer(GL_ARRAY_BUFFER , instance_VBO);
+        glBufferData(GL_ARRAY_BUFFER , instance_capacity , nullptr , GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER , 0 , size , data);
+        glBindBuffer(GL_ARRAY_BUFFER , 0);
+    }
+
+    void VertexArray::DrawInstanced(DrawMode mode , uint32_t count) const {
+        if (!valid || instance_VBO == 0) {
+            YE_ERROR("Rendering Invalid Instanced Vertex Array");
+            return;
         }
+
+        RenderState::BindVertexArray(VAO);
+
+        if (has_indices) {
+            glDrawElementsInstanced(mode , index_count , GL_UNSIGNED_INT , (void*)0 , count);
+        } else {
+            glDrawArraysInstanced(mode , 0 , vertex_count , count);
+        }
+
+        RenderState::CountDraw();
+        if (mode == DrawMode::TRIANGLES) RenderState::CountTriangles((has_indices ? index_count : vertex_count) / 3 * count);
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include "rendering/vertex_format.hpp"
+
+#include <cstring>
+#include <initializer_list>
+
+#include <glad/glad.h>
+#include <glm/gtc/packing.hpp>
+
+namespace YE {
+
+    // components of each attribute as the shader declares it , same order as Vertex::layout
+    static constexpr std::array<uint32_t , kNumVertexAttributes> kAttributeComponents = { 3 , 3 , 3 , 3 , 3 , 2 , 1 };
+
+    // an attribute that never advances , every vertex of every instance reads the first element
+    static constexpr uint32_t kConstantDivisor = 0xFFFFFFFF;
+
+    static uint32_t Components(VertexAttribute attribute) {
+        return kAttributeComponents[static_cast<uint32_t>(attribute)];
+    }
+
+    static bool SharesColorAlpha(const std::array<AttributeType , kNumVertexAttributes>& types) {
+        return types[static_cast<uint32_t>(VertexAttribute::COLOR)] == AttributeType::UNORM8 &&
+               types[static_cast<uint32_t>(VertexAttribute::OPACITY)] == AttributeType::UNORM8;
+    }
+
+    static uint32_t AttributeSize(AttributeType type , uint32_t components) {
+        switch (type) {
+            case AttributeType::FLOAT32: return components * sizeof(float);
+            case AttributeType::HALF_FLOAT: 
+            case AttributeType::UNORM16: return (components * sizeof(uint16_t) + 3) & ~3u;
+            case AttributeType::UNORM8: 
+            case AttributeType::SNORM_10_10_10_2: return sizeof(uint32_t);
+            default: return 0;
+        }
+    }
+
+    static float BitangentSign(const Vertex& vertex) {
+        return glm::dot(glm::cross(vertex.normal , vertex.tangent) , vertex.bitangent) < 0.f ? -1.f : 1.f;
+    }
+
+    static glm::vec4 Get(const Vertex& vertex , VertexAttribute attribute) {
+        switch (attribute) {
+            case VertexAttribute::POSITION: return glm::vec4(vertex.position , 0.f);
+            case VertexAttribute::COLOR: return glm::vec4(vertex.color , 0.f);
+            case VertexAttribute::NORMAL: return glm::vec4(vertex.normal , 0.f);
+            case VertexAttribute::TANGENT: return glm::vec4(vertex.tangent , BitangentSign(vertex));
+            case VertexAttribute::BITANGENT: return glm::vec4(vertex.bitangent , 0.f);
+            case VertexAttribute::TEXCOORD: return glm::vec4(vertex.texcoord , 0.f , 0.f);
+            case VertexAttribute::OPACITY: return glm::vec4(vertex.opacity , 0.f , 0.f , 0.f);
+            default: return glm::vec4(0.f);
+        }
+    }
+
+    static void Set(Vertex& vertex , VertexAttribute attribute , const glm::vec4& value) {
+        switch (attribute) {
+            case VertexAttribute::POSITION: vertex.position = glm::vec3(value); break;
+            case VertexAttribute::COLOR: vertex.color = glm::vec3(value); break;
+            case VertexAttribute::NORMAL: vertex.normal = glm::vec3(value); break;
+            case VertexAttribute::TANGENT: vertex.tangent = glm::vec3(value); break;
+            case VertexAttribute::BITANGENT: vertex.bitangent = glm::vec3(value); break;
+            case VertexAttribute::TEXCOORD: vertex.texcoord = glm::vec2(value); break;
+            case VertexAttribute::OPACITY: vertex.opacity = value.x; break;
+            default: break;
+        }
+    }
+
+    // the value the shader reads for an attribute left out of the buffer , matches the defaults of Vertex
+    // except the bitangent next to a packed tangent , which is zero so the shader knows to derive it
+    static glm::vec4 Default(VertexAttribute attribute , const std::array<AttributeType , kNumVertexAttributes>& types) {
+        switch (attribute) {
+            case VertexAttribute::COLOR: return glm::vec4(1.f);
+            case VertexAttribute::NORMAL: return glm::vec4(1.f , 1.f , 1.f , 0.f);
+            case VertexAttribute::TANGENT: return glm::vec4(1.f);
+            case VertexAttribute::BITANGENT: 
+                if (types[static_cast<uint32_t>(VertexAttribute::TANGENT)] == AttributeType::SNORM_10_10_10_2)
+                    return glm::vec4(0.f);
+                return glm::vec4(1.f , 1.f , 1.f , 0.f);
+            case VertexAttribute::OPACITY: return glm::vec4(1.f , 0.f , 0.f , 0.f);
+            default: return glm::vec4(0.f);
+        }
+    }
+
+    static void Encode(AttributeType type , uint32_t components , const glm::vec4& value , uint8_t* out) {
+        switch (type) {
+            case AttributeType::FLOAT32: 
+                std::memcpy(out , &value[0] , components * sizeof(float)); 
+            break;
+            case AttributeType::HALF_FLOAT: 
+                for (uint32_t i = 0; i < components; ++i) {
+                    uint16_t half = glm::packHalf1x16(value[i]);
+                    std::memcpy(out + i * sizeof(uint16_t) , &half , sizeof(uint16_t));
+                }
+            break;
+            case AttributeType::UNORM16: 
+                for (uint32_t i = 0; i < components; ++i) {
+                    uint16_t unorm = glm::packUnorm1x16(value[i]);
+                    std::memcpy(out + i * sizeof(uint16_t) , &unorm , sizeof(uint16_t));
+                }
+            break;
+            case AttributeType::UNORM8:
+                for (uint32_t i = 0; i < components; ++i)
+                    out[i] = glm::packUnorm1x8(value[i]);
+            break;
+            case AttributeType::SNORM_10_10_10_2: {
+                uint32_t packed = glm::packSnorm3x10_1x2(value);
+                std::memcpy(out , &packed , sizeof(uint32_t));
+            } break;
+            default: break;
+        }
+    }
+
+    static glm::vec4 Decode(AttributeType type , uint32_t components , const uint8_t* data) {
+        glm::vec4 value(0.f);
+        switch (type) {
+            case AttributeType::FLOAT32: 
+                std::memcpy(&value[0] , data , components * sizeof(float)); 
+            break;
+            case AttributeType::HALF_FLOAT:
+                for (uint32_t i = 0; i < components; ++i) {
+                    uint16_t half;
+                    std::memcpy(&half , data + i * sizeof(uint16_t) , sizeof(uint16_t));
+                    value[i] = glm::unpackHalf1x16(half);
+                }
+            break;
+            case AttributeType::UNORM16:
+                for (uint32_t i = 0; i < components; ++i) {
+                    uint16_t unorm;
+                    std::memcpy(&unorm , data + i * sizeof(uint16_t) , sizeof(uint16_t));
+                    value[i] = glm::unpackUnorm1x16(unorm);
+                }
+            break;
+            case AttributeType::UNORM8:
+                for (uint32_t i = 0; i < components; ++i)
+                    value[i] = glm::unpackUnorm1x8(data[i]);
+            break;
+            case AttributeType::SNORM_10_10_10_2: {
+                uint32_t packed;
+                std::memcpy(&packed , data , sizeof(uint32_t));
+                value = glm::unpackSnorm3x10_1x2(packed);
+            } break;
+            default: break;
+        }
+        return value;
+    }
+
+    static glm::vec4 RoundTrip(AttributeType type , uint32_t components , const glm::vec4& value) {
+        uint8_t scratch[4 * sizeof(float)] = {};
+        Encode(type , components , value , scratch);
+        return Decode(type , components , scratch);
+    }
+
+    static bool Fits(const Vertex* vertices , uint32_t count , VertexAttribute attribute , AttributeType type , float tolerance) {
+        const uint32_t components = Components(attribute);
+        for (uint32_t i = 0; i < count; ++i) {
+            glm::vec4 value = Get(vertices[i] , attribute);
+            glm::vec4 result = RoundTrip(type , components , value);
+            for (uint32_t c = 0; c < components; ++c) {
+                if (!(glm::abs(result[c] - value[c]) <= tolerance)) 
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    static bool AllDefault(const Vertex* vertices , uint32_t count , VertexAttribute attribute) {
+        const uint32_t components = Components(attribute);
+        const glm::vec4 value = Get(Vertex{} , attribute);
+        for (uint32_t i = 0; i < count; ++i) {
+            glm::vec4 other = Get(vertices[i] , attribute);
+            for (uint32_t c = 0; c < components; ++c) {
+                if (other[c] != value[c]) return false;
+            }
+        }
+        return true;
+    }
+
+    static AttributeType Smallest(const Vertex* vertices , uint32_t count , VertexAttribute attribute , 
+                                  std::initializer_list<AttributeType> candidates , float tolerance) {
+        for (auto type : candidates) {
+            if (Fits(vertices , count , attribute , type , tolerance))
+                return type;
+        }
+        return AttributeType::FLOAT32;
+    }
+
+    // the shader rebuilds the bitangent as cross(normal , tangent) * tangent.w from the packed values
+    static bool BitangentDerivable(const Vertex* vertices , uint32_t count , AttributeType normal_type) {
+        for (uint32_t i = 0; i < count; ++i) {
+            glm::vec3 normal = RoundTrip(normal_type , 3 , Get(vertices[i] , VertexAttribute::NORMAL));
+            glm::vec4 tangent = RoundTrip(AttributeType::SNORM_10_10_10_2 , 4 , Get(vertices[i] , VertexAttribute::TANGENT));
+            glm::vec3 derived = glm::cross(normal , glm::vec3(tangent)) * tangent.w;
+            if (!(glm::length(derived - vertices[i].bitangent) <= kDerivedBitangentTolerance))
+                return false;
+        }
+        return true;
+    }
+
+    void VertexFormat::CalculateOffsets() {
+        stride = 0;
+        for (uint32_t i = 0; i < kNumVertexAttributes; ++i) {
+            offsets[i] = stride;
+            stride += AttributeSize(types[i] , kAttributeComponents[i]);
+        }
+
+        // opacity rides in the color's spare alpha byte
+        if (SharesColorAlpha(types)) {
+            const uint32_t opacity = static_cast<uint32_t>(VertexAttribute::OPACITY);
+            stride -= AttributeSize(AttributeType::UNORM8 , 1);
+            offsets[opacity] = offsets[static_cast<uint32_t>(VertexAttribute::COLOR)] + 3;
+        }
+    }
+
+    VertexFormat::VertexFormat() {
+        types.fill(AttributeType::FLOAT32);
+        CalculateOffsets();
+    }
+
+    VertexFormat::VertexFormat(const std::array<AttributeType , kNumVertexAttributes>& types) 
+            : types(types) {
+        // nothing to draw without a position
+        this->types[static_cast<uint32_t>(VertexAttribute::POSITION)] = AttributeType::FLOAT32;
+        CalculateOffsets();
+    }
+
+    VertexFormat VertexFormat::Full() {
+        return VertexFormat();
+    }
+
+    VertexFormat VertexFormat::Select(const Vertex* vertices , uint32_t count) {
+        std::array<AttributeType , kNumVertexAttributes> types{};
+        auto type = [&types](VertexAttribute attribute) -> AttributeType& {
+            return types[static_cast<uint32_t>(attribute)];
+        };
+
+        type(VertexAttribute::POSITION) = AttributeType::FLOAT32;
+
+        type(VertexAttribute::COLOR) = AllDefault(vertices , count , VertexAttribute::COLOR) ? 
+            AttributeType::NONE : 
+            Smallest(vertices , count , VertexAttribute::COLOR , { AttributeType::UNORM8 } , kColorTolerance);
+
+        type(VertexAttribute::NORMAL) = AllDefault(vertices , count , VertexAttribute::NORMAL) ?
+            AttributeType::NONE :
+            Smallest(vertices , count , VertexAttribute::NORMAL , { AttributeType::SNORM_10_10_10_2 , AttributeType::HALF_FLOAT } , kDirectionTolerance);
+
+        const bool default_tangents = AllDefault(vertices , count , VertexAttribute::TANGENT) && 
+                                      AllDefault(vertices , count , VertexAttribute::BITANGENT);
+        if (default_tangents) {
+            type(VertexAttribute::TANGENT) = AttributeType::NONE;
+            type(VertexAttribute::BITANGENT) = AttributeType::NONE;
+        } else {
+            type(VertexAttribute::TANGENT) = Smallest(vertices , count , VertexAttribute::TANGENT , 
+                                                      { AttributeType::SNORM_10_10_10_2 , AttributeType::HALF_FLOAT } , kDirectionTolerance);
+
+            if (type(VertexAttribute::TANGENT) == AttributeType::SNORM_10_10_10_2 && 
+                BitangentDerivable(vertices , count , type(VertexAttribute::NORMAL))) {
+                type(VertexAttribute::BITANGENT) = AttributeType::NONE;
+            } else {
+                type(VertexAttribute::BITANGENT) = Smallest(vertices , count , VertexAttribute::BITANGENT , 
+                                                            { AttributeType::SNORM_10_10_10_2 , AttributeType::HALF_FLOAT } , kDirectionTolerance);
+            }
+        }
+
+        type(VertexAttribute::TEXCOORD) = AllDefault(vertices , count , VertexAttribute::TEXCOORD) ?
+            AttributeType::NONE :
+            Smallest(vertices , count , VertexAttribute::TEXCOORD , { AttributeType::UNORM16 , AttributeType::HALF_FLOAT } , kTexcoordTolerance);
+
+        type(VertexAttribute::OPACITY) = AllDefault(vertices , count , VertexAttribute::OPACITY) ?
+            AttributeType::NONE :
+            Smallest(vertices , count , VertexAttribute::OPACITY , { AttributeType::UNORM8 } , kColorTolerance);
+
+        return VertexFormat(types);
+    }
+
+    void VertexFormat::Pack(const Vertex* vertices , uint32_t count , uint8_t* out) const {
+        std::memset(out , 0 , static_cast<size_t>(stride) * count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            uint8_t* vertex = out + static_cast<size_t>(stride) * i;
+            for (uint32_t a = 0; a < kNumVertexAttributes; ++a) {
+                if (types[a] == AttributeType::NONE) continue;
+
+                // the tangent's w is the bitangent sign , only a 10_10_10_2 tangent has room for it
+                uint32_t components = kAttributeComponents[a];
+                if (types[a] == AttributeType::SNORM_10_10_10_2) components = 4;
+
+                Encode(types[a] , components , Get(vertices[i] , static_cast<VertexAttribute>(a)) , vertex + offsets[a]);
+            }
+        }
+    }
+
+    void VertexFormat::Unpack(const uint8_t* data , uint32_t count , Vertex* out) const {
+        const uint32_t tangent = static_cast<uint32_t>(VertexAttribute::TANGENT);
+        const bool derive_bitangent = !Has(VertexAttribute::BITANGENT) && types[tangent] == AttributeType::SNORM_10_10_10_2;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint8_t* vertex = data + static_cast<size_t>(stride) * i;
+            Vertex& result = out[i];
+            result = Vertex{};
+
+            for (uint32_t a = 0; a < kNumVertexAttributes; ++a) {
+                VertexAttribute attribute = static_cast<VertexAttribute>(a);
+                if (types[a] == AttributeType::NONE) {
+                    Set(result , attribute , Default(attribute , types));
+                    continue;
+                }
+                Set(result , attribute , Decode(types[a] , kAttributeComponents[a] , vertex + offsets[a]));
+            }
+
+            if (derive_bitangent) {
+                float sign = Decode(types[tangent] , 4 , vertex + offsets[tangent]).w;
+                result.bitangent = glm::cross(result.normal , result.tangent) * sign;
+            }
+        }
+    }
+
+    void VertexFormat::SetupAttributes(uint32_t constants_offset) const {
+        uint32_t constant = 0;
+        for (uint32_t i = 0; i < kNumVertexAttributes; ++i) {
+            const void* offset = (void*)static_cast<uintptr_t>(offsets[i]);
+            const uint32_t components = kAttributeComponents[i];
+
+            switch (types[i]) {
+                case AttributeType::NONE:
+                    offset = (void*)static_cast<uintptr_t>(constants_offset + constant++ * sizeof(glm::vec4));
+                    glVertexAttribPointer(i , 4 , GL_FLOAT , GL_FALSE , sizeof(glm::vec4) , offset);
+                    glVertexAttribDivisor(i , kConstantDivisor);
+                break;
+                case AttributeType::FLOAT32:
+                    glVertexAttribPointer(i , components , GL_FLOAT , GL_FALSE , stride , offset);
+                break;
+                case AttributeType::HALF_FLOAT:
+                    glVertexAttribPointer(i , components , GL_HALF_FLOAT , GL_FALSE , stride , offset);
+                break;
+                case AttributeType::UNORM16:
+                    glVertexAttribPointer(i , components , GL_UNSIGNED_SHORT , GL_TRUE , stride , offset);
+                break;
+                case AttributeType::UNORM8:
+                    glVertexAttribPointer(i , components , GL_UNSIGNED_BYTE , GL_TRUE , stride , offset);
+                break;
+                case AttributeType::SNORM_10_10_10_2:
+                    glVertexAttribPointer(i , 4 , GL_INT_2_10_10_10_REV , GL_TRUE , stride , offset);
+                break;
+            }
+
+            glEnableVertexAttribArray(i);
+        }
+    }
+
+    void VertexFormat::WriteConstants(float* out) const {
+        for (uint32_t i = 0; i < kNumVertexAttributes; ++i) {
+            if (types[i] != AttributeType::NONE) continue;
+
+            glm::vec4 value = Default(static_cast<VertexAttribute>(i) , types);
+            std::memcpy(out , &value[0] , sizeof(glm::vec4));
+            out += 4;
+        }
+    }
+
+    uint32_t VertexFormat::NumConstants() const {
+        uint32_t count = 0;
+        for (auto& type : types) {
+            if (type == AttributeType::NONE) ++count;
+        }
+        return count;
+    }
+
+    std::string VertexFormat::Describe() const {
+        static constexpr std::array<const char* , kNumVertexAttributes> kNames = {
+            "position" , "color" , "normal" , "tangent" , "bitangent" , "texcoord" , "opacity"
+        };
+        static constexpr std::array<const char* , 6> kTypeNames = {
+            "none" , "f32" , "f16" , "unorm16" , "unorm8" , "snorm10"
+        };
+
+        std::string description;
+        for (uint32_t i = 0; i < kNumVertexAttributes; ++i) {
+            if (types[i] == AttributeType::NONE) continue;
+            if (!description.empty()) description += " , ";
+            description += std::string(kNames[i]) + ":" + kTypeNames[static_cast<uint32_t>(types[i])];
+        }
+        return description + " (" + std::to_string(stride) + " bytes)";
+    }
+
+}
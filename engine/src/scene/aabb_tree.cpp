@@ -0,0 +1,483 @@
+#include "scene/aabb_tree.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace YE {
+
+    int32_t AABBTree::AllocateNode() {
+        if (free_list == kNullTreeNode) {
+            const int32_t old_size = static_cast<int32_t>(nodes.size());
+            const int32_t new_size = std::max<int32_t>(16 , old_size * 2);
+            nodes.resize(new_size);
+
+            for (int32_t i = old_size; i < new_size; ++i) {
+                nodes[i].parent = i + 1 < new_size ? i + 1 : kNullTreeNode;
+                nodes[i].height = -1;
+            }
+            free_list = old_size;
+        }
+
+        int32_t node = free_list;
+        free_list = nodes[node].parent;
+
+        nodes[node] = AABBTreeNode{};
+        nodes[node].height = 0;
+        return node;
+    }
+
+    void AABBTree::FreeNode(int32_t node) {
+        nodes[node] = AABBTreeNode{};
+        nodes[node].parent = free_list;
+        nodes[node].height = -1;
+        free_list = node;
+    }
+
+    void AABBTree::InsertLeaf(int32_t leaf) {
+        if (root == kNullTreeNode) {
+            root = leaf;
+            nodes[root].parent = kNullTreeNode;
+            return;
+        }
+
+        // walk down towards the cheapest sibling , the cost of a subtree is the area it would add to the tree
+        const AABB leaf_aabb = nodes[leaf].aabb;
+        int32_t index = root;
+        while (!nodes[index].IsLeaf()) {
+            const AABBTreeNode& node = nodes[index];
+
+            const float area = node.aabb.SurfaceArea();
+            const float combined_area = AABB::Union(node.aabb , leaf_aabb).SurfaceArea();
+
+            // pairing with this node directly versus pushing the leaf further down
+            const float cost = 2.f * combined_area;
+            const float inheritance = 2.f * (combined_area - area);
+
+            auto descend_cost = [this , &leaf_aabb , inheritance](int32_t child) {
+                const AABBTreeNode& c = nodes[child];
+                const float grown = AABB::Union(c.aabb , leaf_aabb).SurfaceArea();
+                return c.IsLeaf() ? grown + inheritance : (grown - c.aabb.SurfaceArea()) + inheritance;
+            };
+
+            const float cost_left = descend_cost(node.left);
+            const float cost_right = descend_cost(node.right);
+
+            if (cost < cost_left && cost < cost_right)
+                break;
+
+            index = cost_left < cost_right ? node.left : node.right;
+        }
+
+        const int32_t sibling = index;
+        const int32_t old_parent = nodes[sibling].parent;
+        const int32_t new_parent = AllocateNode();
+
+        nodes[new_parent].parent = old_parent;
+        nodes[new_parent].aabb = AABB::Union(leaf_aabb , nodes[sibling].aabb);
+        nodes[new_parent].height = nodes[sibling].height + 1;
+        nodes[new_parent].left = sibling;
+        nodes[new_parent].right = leaf;
+        nodes[sibling].parent = new_parent;
+        nodes[leaf].parent = new_parent;
+
+        if (old_parent != kNullTreeNode) {
+            if (nodes[old_parent].left == sibling) {
+                nodes[old_parent].left = new_parent;
+            } else {
+                nodes[old_parent].right = new_parent;
+            }
+        } else {
+            root = new_parent;
+        }
+
+        RefitAncestors(nodes[leaf].parent);
+    }
+
+    void AABBTree::RemoveLeaf(int32_t leaf) {
+        if (leaf == root) {
+            root = kNullTreeNode;
+            return;
+        }
+
+        const int32_t parent = nodes[leaf].parent;
+        const int32_t grand_parent = nodes[parent].parent;
+        const int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+        if (grand_parent != kNullTreeNode) {
+            if (nodes[grand_parent].left == parent) {
+                nodes[grand_parent].left = sibling;
+            } else {
+                nodes[grand_parent].right = sibling;
+            }
+            nodes[sibling].parent = grand_parent;
+            FreeNode(parent);
+
+            RefitAncestors(grand_parent);
+        } else {
+            root = sibling;
+            nodes[sibling].parent = kNullTreeNode;
+            FreeNode(parent);
+        }
+
+        nodes[leaf].parent = kNullTreeNode;
+    }
+
+    void AABBTree::RefitAncestors(int32_t node) {
+        while (node != kNullTreeNode) {
+            node = Balance(node);
+
+            AABBTreeNode& current = nodes[node];
+            const AABBTreeNode& left = nodes[current.left];
+            const AABBTreeNode& right = nodes[current.right];
+
+            current.height = 1 + std::max(left.height , right.height);
+            current.aabb = AABB::Union(left.aabb , right.aabb);
+
+            node = current.parent;
+        }
+    }
+
+    int32_t AABBTree::Balance(int32_t index_a) {
+        AABBTreeNode& a = nodes[index_a];
+        if (a.IsLeaf() || a.height < 2)
+            return index_a;
+
+        const int32_t index_b = a.left;
+        const int32_t index_c = a.right;
+        AABBTreeNode& b = nodes[index_b];
+        AABBTreeNode& c = nodes[index_c];
+
+        const int32_t balance = c.height - b.height;
+
+        // right side is too tall , rotate c up
+        if (balance > 1) {
+            const int32_t index_f = c.left;
+            const int32_t index_g = c.right;
+            AABBTreeNode& f = nodes[index_f];
+            AABBTreeNode& g = nodes[index_g];
+
+            c.left = index_a;
+            c.parent = a.parent;
+            a.parent = index_c;
+
+            if (c.parent != kNullTreeNode) {
+                if (nodes[c.parent].left == index_a) {
+                    nodes[c.parent].left = index_c;
+                } else {
+                    nodes[c.parent].right = index_c;
+                }
+            } else {
+                root = index_c;
+            }
+
+            if (f.height > g.height) {
+                c.right = index_f;
+                a.right = index_g;
+                g.parent = index_a;
+                a.aabb = AABB::Union(b.aabb , g.aabb);
+                c.aabb = AABB::Union(a.aabb , f.aabb);
+                a.height = 1 + std::max(b.height , g.height);
+                c.height = 1 + std::max(a.height , f.height);
+            } else {
+                c.right = index_g;
+                a.right = index_f;
+                f.parent = index_a;
+                a.aabb = AABB::Union(b.aabb , f.aabb);
+                c.aabb = AABB::Union(a.aabb , g.aabb);
+                a.height = 1 + std::max(b.height , f.height);
+                c.height = 1 + std::max(a.height , g.height);
+            }
+
+            return index_c;
+        }
+
+        // left side is too tall , rotate b up
+        if (balance < -1) {
+            const int32_t index_d = b.left;
+            const int32_t index_e = b.right;
+            AABBTreeNode& d = nodes[index_d];
+            AABBTreeNode& e = nodes[index_e];
+
+            b.left = index_a;
+            b.parent = a.parent;
+            a.parent = index_b;
+
+            if (b.parent != kNullTreeNode) {
+                if (nodes[b.parent].left == index_a) {
+                    nodes[b.parent].left = index_b;
+                } else {
+                    nodes[b.parent].right = index_b;
+                }
+            } else {
+                root = index_b;
+            }
+
+            if (d.height > e.height) {
+                b.right = index_d;
+                a.left = index_e;
+                e.parent = index_a;
+                a.aabb = AABB::Union(c.aabb , e.aabb);
+                b.aabb = AABB::Union(a.aabb , d.aabb);
+                a.height = 1 + std::max(c.height , e.height);
+                b.height = 1 + std::max(a.height , d.height);
+            } else {
+                b.right = index_e;
+                a.left = index_d;
+                d.parent = index_a;
+                a.aabb = AABB::Union(c.aabb , d.aabb);
+                b.aabb = AABB::Union(a.aabb , e.aabb);
+                a.height = 1 + std::max(c.height , d.height);
+                b.height = 1 + std::max(a.height , e.height);
+            }
+
+            return index_b;
+        }
+
+        return index_a;
+    }
+
+    int32_t AABBTree::BuildRange(int32_t* leaves , uint32_t count) {
+        if (count == 1)
+            return leaves[0];
+
+        AABB centroid_bounds;
+        for (uint32_t i = 0; i < count; ++i)
+            centroid_bounds.Expand(nodes[leaves[i]].aabb.Center());
+
+        const glm::vec3 extent = centroid_bounds.max - centroid_bounds.min;
+        int32_t axis = 0;
+        if (extent.y > extent[axis]) axis = 1;
+        if (extent.z > extent[axis]) axis = 2;
+
+        uint32_t mid = count / 2;
+
+        if (extent[axis] > std::numeric_limits<float>::epsilon()) {
+            const float axis_min = centroid_bounds.min[axis];
+            const float scale = static_cast<float>(kAABBTreeSahBins) / extent[axis];
+
+            auto bin_of = [this , axis , axis_min , scale](int32_t leaf) {
+                uint32_t bin = static_cast<uint32_t>((nodes[leaf].aabb.Center()[axis] - axis_min) * scale);
+                return std::min(bin , kAABBTreeSahBins - 1);
+            };
+
+            std::array<AABB , kAABBTreeSahBins> bin_bounds;
+            std::array<uint32_t , kAABBTreeSahBins> bin_counts{};
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t bin = bin_of(leaves[i]);
+                bin_bounds[bin].Merge(nodes[leaves[i]].aabb);
+                ++bin_counts[bin];
+            }
+
+            // cost of splitting after bin i is area(left) * count(left) + area(right) * count(right)
+            std::array<float , kAABBTreeSahBins - 1> left_cost{};
+            AABB left_box;
+            uint32_t left_count = 0;
+            for (uint32_t i = 0; i < kAABBTreeSahBins - 1; ++i) {
+                left_box.Merge(bin_bounds[i]);
+                left_count += bin_counts[i];
+                left_cost[i] = left_count > 0 ? left_box.SurfaceArea() * left_count : 0.f;
+            }
+
+            float best_cost = std::numeric_limits<float>::max();
+            uint32_t best_split = 0;
+            AABB right_box;
+            uint32_t right_count = 0;
+            for (uint32_t i = kAABBTreeSahBins - 1; i > 0; --i) {
+                right_box.Merge(bin_bounds[i]);
+                right_count += bin_counts[i];
+
+                float cost = left_cost[i - 1] + (right_count > 0 ? right_box.SurfaceArea() * right_count : 0.f);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_split = i - 1;
+                }
+            }
+
+            int32_t* split = std::partition(leaves , leaves + count , [&bin_of , best_split](int32_t leaf) {
+                return bin_of(leaf) <= best_split;
+            });
+            mid = static_cast<uint32_t>(split - leaves);
+        }
+
+        // every centroid landed on one side , fall back to a median split so the recursion always ends
+        if (mid == 0 || mid == count) {
+            mid = count / 2;
+            std::nth_element(leaves , leaves + mid , leaves + count , [this , axis](int32_t lhs , int32_t rhs) {
+                return nodes[lhs].aabb.Center()[axis] < nodes[rhs].aabb.Center()[axis];
+            });
+        }
+
+        const int32_t left = BuildRange(leaves , mid);
+        const int32_t right = BuildRange(leaves + mid , count - mid);
+
+        const int32_t node = AllocateNode();
+        nodes[node].left = left;
+        nodes[node].right = right;
+        nodes[node].aabb = AABB::Union(nodes[left].aabb , nodes[right].aabb);
+        nodes[node].height = 1 + std::max(nodes[left].height , nodes[right].height);
+        nodes[left].parent = node;
+        nodes[right].parent = node;
+
+        return node;
+    }
+
+    int32_t AABBTree::CreateProxy(const AABB& aabb , entt::entity entity) {
+        const int32_t leaf = AllocateNode();
+
+        const glm::vec3 margin = glm::vec3(kAABBTreeMargin);
+        nodes[leaf].tight = aabb;
+        nodes[leaf].aabb = AABB(aabb.min - margin , aabb.max + margin);
+        nodes[leaf].entity = entity;
+
+        InsertLeaf(leaf);
+        ++num_proxies;
+
+        return leaf;
+    }
+
+    void AABBTree::DestroyProxy(int32_t proxy) {
+        if (proxy < 0 || proxy >= static_cast<int32_t>(nodes.size()) || !nodes[proxy].IsLeaf() || nodes[proxy].height != 0)
+            return;
+
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --num_proxies;
+    }
+
+    bool AABBTree::MoveProxy(int32_t proxy , const AABB& aabb) {
+        AABBTreeNode& leaf = nodes[proxy];
+        leaf.tight = aabb;
+        if (leaf.aabb.Contains(aabb))
+            return false;
+
+        const glm::vec3 margin = glm::vec3(kAABBTreeMargin);
+        leaf.aabb = AABB(aabb.min - margin , aabb.max + margin);
+
+        if (!leaf.stale) {
+            leaf.stale = true;
+            stale_leaves.push_back(proxy);
+        }
+
+        // grow ancestors until one already holds the leaf , they shrink back when Optimize reinserts it
+        const AABB fat = leaf.aabb;
+        int32_t node = leaf.parent;
+        while (node != kNullTreeNode) {
+            AABBTreeNode& current = nodes[node];
+            if (current.aabb.Contains(fat))
+                break;
+
+            current.aabb = AABB::Union(current.aabb , fat);
+            node = current.parent;
+        }
+
+        return true;
+    }
+
+    void AABBTree::Optimize(uint32_t max_reinserts) {
+        uint32_t reinserted = 0;
+        while (!stale_leaves.empty() && reinserted < max_reinserts) {
+            int32_t proxy = stale_leaves.back();
+            stale_leaves.pop_back();
+
+            // the leaf may have been destroyed , or destroyed and reused , since it was queued
+            AABBTreeNode& leaf = nodes[proxy];
+            if (leaf.height != 0 || !leaf.stale)
+                continue;
+
+            leaf.stale = false;
+            RemoveLeaf(proxy);
+            InsertLeaf(proxy);
+            ++reinserted;
+        }
+    }
+
+    void AABBTree::Rebuild() {
+        stale_leaves.clear();
+
+        std::vector<int32_t> leaves;
+        leaves.reserve(num_proxies);
+
+        for (int32_t i = 0; i < static_cast<int32_t>(nodes.size()); ++i) {
+            if (nodes[i].height < 0) continue;
+
+            if (nodes[i].IsLeaf()) {
+                nodes[i].parent = kNullTreeNode;
+                nodes[i].stale = false;
+                leaves.push_back(i);
+            } else {
+                FreeNode(i);
+            }
+        }
+
+        root = leaves.empty() ? kNullTreeNode : BuildRange(leaves.data() , static_cast<uint32_t>(leaves.size()));
+        if (root != kNullTreeNode)
+            nodes[root].parent = kNullTreeNode;
+    }
+
+    void AABBTree::Clear() {
+        nodes.clear();
+        stale_leaves.clear();
+        root = kNullTreeNode;
+        free_list = kNullTreeNode;
+        num_proxies = 0;
+    }
+
+    bool AABBTree::RayCast(const glm::vec3& origin , const glm::vec3& direction , float max_distance , RayHit& hit) const {
+        const float length = glm::length(direction);
+        if (root == kNullTreeNode || length <= 0.f)
+            return false;
+
+        const glm::vec3 inv_direction = 1.f / (direction / length);
+
+        float closest = max_distance;
+        bool found = false;
+
+        NodeStack stack;
+        stack.Push(root);
+
+        while (!stack.Empty()) {
+            const AABBTreeNode& node = nodes[stack.Pop()];
+
+            float distance = 0.f;
+            if (!RayIntersects(origin , inv_direction , closest , node.aabb , distance))
+                continue;
+
+            if (node.IsLeaf()) {
+                if (!RayIntersects(origin , inv_direction , closest , node.tight , distance))
+                    continue;
+
+                closest = distance;
+                hit.entity = node.entity;
+                hit.distance = distance;
+                found = true;
+            } else {
+                stack.Push(node.left);
+                stack.Push(node.right);
+            }
+        }
+
+        return found;
+    }
+
+    void AABBTree::Query(const AABB& aabb , std::vector<entt::entity>& result) const {
+        Query(aabb , [&result](entt::entity entity) {
+            result.push_back(entity);
+            return true;
+        });
+    }
+
+    void AABBTree::Query(const BoundingSphere& sphere , std::vector<entt::entity>& result) const {
+        Query(sphere , [&result](entt::entity entity) {
+            result.push_back(entity);
+            return true;
+        });
+    }
+
+    void AABBTree::Query(const Frustum& frustum , std::vector<entt::entity>& result) const {
+        Query(frustum , [&result](entt::entity entity) {
+            result.push_back(entity);
+            return true;
+        });
+    }
+
+}
@@ -23,6 +23,7 @@ namespace components {
         model = glm::rotate(model , rotation.y , glm::vec3(0.0f , 1.0f , 0.0f));
         model = glm::rotate(model , rotation.z , glm::vec3(0.0f , 0.0f , 1.0f));
         model = glm::scale(model , scale);
+        local = model;
     }
 
 }
@@ -16,6 +16,8 @@ namespace YE {
         auto& parent_grouping = parent->GetComponent<components::Grouping>();
         grouping.parent = parent_id.id;
         parent_grouping.children.push_back(id.id);
+
+        context->hierarchy_dirty = true;
     }
 
     void Entity::RemoveParent(Entity* parent) {
@@ -29,6 +31,8 @@ namespace YE {
                 break;
             }
         }
+
+        context->hierarchy_dirty = true;
     }
 
     void Entity::GiveChild(Entity* child) {
@@ -48,6 +52,8 @@ namespace YE {
         
         child_grouping.parent = id.id;
         child_grouping.children.push_back(child_id.id);
+
+        context->hierarchy_dirty = true;
     }
 
     void Entity::RemoveChild(Entity* child) {
@@ -61,6 +67,8 @@ namespace YE {
 
         auto& child_grouping = child->GetComponent<components::Grouping>();
         child_grouping.parent = 0;
+
+        context->hierarchy_dirty = true;
     }
     
     Entity* Entity::GetParent() {
@@ -49,6 +49,7 @@ namespace YE {
 
         registry.destroy(entt);
         entities.erase(id.id);
+        hierarchy_dirty = true;
     }
 
     // void Scene::DestroyEntity(UUID id) {
@@ -128,8 +129,6 @@ namespace YE {
     }
 
     void Scene::Update(float dt) {
-        TaskManager* task_manager = TaskManager::Instance();
-
         Systems::update_signal.publish(this , std::ref(dt));
 
         if (active_camera != nullptr)
@@ -140,24 +139,30 @@ namespace YE {
             script.Update(dt);
         });
 
-        task_manager->DispatchTask([reg = &registry , dt]() {
-            reg->view<components::Transform>().each([](auto& transform) {
-                Systems::entity_update_transform_signal.publish(transform);
-            });
-
-            reg->view<components::PhysicsBody , components::Transform>().each([](auto& body , auto& transform) {
-                Systems::physics_body_update_signal.publish(body , transform);
-            });
-        });
-        
-        task_manager->DispatchTask([reg = &registry , dt]() {
-            reg->view<components::NativeScript>().each([dt](auto& script) {
-                script.Update(dt);
-            });
+        // native scripts move entities , they have to be done before the transform passes read them
+        //  and nothing else this frame can overlap them , so they run right here
+        registry.view<components::NativeScript>().each([dt](auto& script) {
+            script.Update(dt);
         });
 
-        registry.view<components::Transform , components::PointLight>().each([](auto& transform , auto& light) {
-            light.position = transform.position;
+        Systems::ResetChangedTransforms(this);
+
+        auto bodies = registry.view<components::PhysicsBody , components::Transform>();
+        Systems::ParallelEach<components::PhysicsBody , components::Transform>(each_entities , bodies , [](auto& body , auto& transform) {
+            Systems::physics_body_update_signal.publish(body , transform);
+        } , kPhysicsEachGrain);
+
+        auto transforms = registry.view<components::Transform>();
+        Systems::ParallelEach<components::Transform>(each_entities , transforms , [](auto& transform) {
+            Systems::entity_update_transform_signal.publish(transform);
+        } , kTransformEachGrain);
+
+        Systems::PropagateTransforms(this);
+        Systems::UpdateBounds(this);
+
+        auto lights = registry.view<components::Transform , components::PointLight>();
+        Systems::ParallelEach<components::Transform , components::PointLight>(each_entities , lights , [](auto& transform , auto& light) {
+            light.position = glm::vec3(transform.model[3]);
         });
         
         auto plights = registry.view<components::PointLight>();
@@ -169,6 +174,8 @@ namespace YE {
             plights_vec.push_back(light);
         }
 
+        Renderer::Instance()->UpdatePointLights(plights_vec);
+
         registry.view<components::Renderable>().each([plights_vec](auto& renderable) {
             Systems::renderable_update_signal.publish(renderable , plights_vec);
         });
@@ -232,50 +239,12 @@ namespace YE {
         if (active_camera != nullptr)
             renderer->PushCamera(active_camera);
 
-        registry.view<components::Transform , components::Renderable , components::PointLight>().each(
-            [reg = &registry , renderer](auto& transform , auto& renderable , auto& light) {
-                if (renderable.corrupted) return;
-
-                transform.position = light.position;
-                std::unique_ptr<RenderCommand> cmnd = std::make_unique<DrawPointLight>(
-                    renderable , &light , transform.Model()
-                );
-                renderer->SubmitRenderCmnd(cmnd);
-            }
-        );
-
-        registry.view<components::Transform , components::Renderable>(
-            entt::exclude<components::PointLight>
-        ).each([reg = &registry , renderer](auto& transform , auto& renderable) {
-            if (renderable.corrupted) return;
-
-            std::unique_ptr<RenderCommand> cmnd = std::make_unique<DrawRenderable>(
-                renderable , transform.model
-            );  
-            renderer->SubmitRenderCmnd(cmnd);
-        });
+        // visibility is decided before syncing so hidden draws are switched off in the same frame
+        Systems::CullRenderables(this , active_camera);
+        Systems::SelectLods(this , active_camera);
 
-        registry.view<components::Transform , components::TexturedRenderable>().each(
-            [reg = &registry , renderer](auto& transform , auto& renderable) {
-                if (renderable.corrupted) return;
-
-                std::unique_ptr<RenderCommand> cmnd = std::make_unique<DrawTexturedRenderable>(
-                    renderable , transform.model
-                );
-                renderer->SubmitRenderCmnd(cmnd);
-            }
-        );
-
-        registry.view<components::Transform , components::RenderableModel>().each(
-            [reg = &registry , renderer](auto& transform , auto& renderable) {
-                if (renderable.corrupted) return;
-
-                std::unique_ptr<RenderCommand> cmnd = std::make_unique<DrawRenderableModel>(
-                    renderable , transform.model
-                );
-                renderer->SubmitRenderCmnd(cmnd);
-            }
-        );
+        // renderables are registered with the renderer once , after that only changes are sent
+        Systems::SyncRenderables(this);
     }
 
     void Scene::End() {
@@ -1,5 +1,11 @@
 #include "scene/systems.hpp"
 
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <optional>
+#include <unordered_set>
+
 #include <glm/gtx/matrix_decompose.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -12,9 +18,96 @@
 #include "scene/entity.hpp"
 #include "scene/components.hpp"
 #include "rendering/shader.hpp"
+#include "rendering/renderer.hpp"
+#include "rendering/camera.hpp"
+#include "rendering/bounds.hpp"
 #include "physics/physics_engine.hpp"
 
 namespace YE {
+
+    // entities only live in the tree while they have a usable world box
+    static void SyncProxy(AABBTree& tree , entt::entity entity , components::Bounds& bounds) {
+        if (!bounds.world.Valid()) {
+            if (bounds.tree_proxy != kNullTreeNode) tree.DestroyProxy(bounds.tree_proxy);
+            bounds.tree_proxy = kNullTreeNode;
+            return;
+        }
+
+        if (bounds.tree_proxy == kNullTreeNode) {
+            bounds.tree_proxy = tree.CreateProxy(bounds.world , entity);
+        } else {
+            tree.MoveProxy(bounds.tree_proxy , bounds.world);
+        }
+    }
+
+    // union of every mesh the entity draws , the component being removed is left out when one is given
+    static AABB LocalBounds(entt::registry& registry , entt::entity entity , std::optional<RenderableKind> removed = std::nullopt) {
+        AABB local;
+        if (auto* renderable = registry.try_get<components::Renderable>(entity); 
+            renderable != nullptr && renderable->vao != nullptr && removed != RenderableKind::RENDERABLE)
+            local.Merge(renderable->vao->Bounds());
+        if (auto* renderable = registry.try_get<components::TexturedRenderable>(entity); 
+            renderable != nullptr && renderable->vao != nullptr && removed != RenderableKind::TEXTURED)
+            local.Merge(renderable->vao->Bounds());
+        if (auto* renderable = registry.try_get<components::RenderableModel>(entity); 
+            renderable != nullptr && renderable->model != nullptr && removed != RenderableKind::MODEL)
+            local.Merge(renderable->model->Bounds());
+        return local;
+    }
+
+    // local bounds are rebuilt whenever one of the entity's meshes is resubmitted
+    static void RefreshBounds(AABBTree& tree , entt::registry& registry , entt::entity entity , const components::Transform& transform) {
+        auto& bounds = registry.get_or_emplace<components::Bounds>(entity);
+        bounds.local = LocalBounds(registry , entity);
+        bounds.world = bounds.local.Transform(transform.model);
+        bounds.sphere = CalculateSphere(bounds.world);
+
+        SyncProxy(tree , entity , bounds);
+    }
+
+    // a renderable removed from an entity that stays alive takes its mesh out of the entity's bounds , with
+    // nothing left to draw the entity leaves the tree. destroyed entities already dropped their proxy
+    static void ReleaseBounds(AABBTree& tree , entt::registry& registry , entt::entity entity , RenderableKind removed) {
+        auto* bounds = registry.try_get<components::Bounds>(entity);
+        auto* transform = registry.try_get<components::Transform>(entity);
+        if (bounds == nullptr || transform == nullptr || bounds->tree_proxy == kNullTreeNode) 
+            return;
+
+        bounds->local = LocalBounds(registry , entity , removed);
+        bounds->world = bounds->local.Transform(transform->model);
+        bounds->sphere = CalculateSphere(bounds->world);
+
+        SyncProxy(tree , entity , *bounds);
+    }
+
+    // the collision mesh reads the model's vertex data in place , so it is rebuilt whenever the entity's model changes
+    static void BuildMeshCollider(Model* model , components::MeshCollider& collider , components::PhysicsBody& body) {
+        PhysicsEngine* physics_engine = PhysicsEngine::Instance();
+
+        if (collider.collider != nullptr) {
+            body.body->removeCollider(collider.collider);
+            physics_engine->DestroyConvexMeshShape(collider.shape);
+            physics_engine->DestroyPolygonMesh(collider.mesh);
+            collider.collider = nullptr;
+            collider.shape = nullptr;
+            collider.mesh = nullptr;
+        }
+
+        collider.mesh = physics_engine->CreatePolygonMesh(model->Vertices() , model->Indices() , model->NumFaces());
+        collider.shape = physics_engine->CreateConvexMeshShape(collider.mesh);
+        rp3d::Transform local_transform = reactphysics3d::Transform::identity();
+
+        collider.collider = body.body->addCollider(collider.shape , local_transform);
+    }
+
+    // new draws start visible in the renderer , after that only changes in the frustum test are sent
+    static void SyncVisibility(Renderer* renderer , entt::registry& registry , entt::entity entity , UUID id , bool pushed) {
+        auto* bounds = registry.try_get<components::Bounds>(entity);
+        if (bounds == nullptr) return;
+
+        if (pushed ? !bounds->visible : bounds->visibility_changed)
+            renderer->SetRenderableVisible(id , bounds->visible);
+    }
     
     EntityCreatedSignal Systems::entity_created_signal{};
     EntityDestroyedSignal Systems::entity_destroyed_signal{};
@@ -42,10 +135,15 @@ namespace YE {
     TexturedRenderableUpdateSink Systems::textured_renderable_update_sink{ Systems::textured_renderable_update_signal };
     RenderableModelUpdateSink Systems::renderable_model_update_sink{ Systems::renderable_model_update_signal };
 
-    void Systems::LoadShader(Shader *& shader , const std::string& entity_name , const std::string& shader_name , bool& corrupted) {
-        shader = ResourceHandler::Instance()->GetShader(shader_name);
-        if (shader == nullptr)
-            shader = ResourceHandler::Instance()->GetCoreShader(shader_name);
+    void Systems::LoadShader(Shader *& shader , ShaderHandle& handle , [[maybe_unused]] const std::string& entity_name , 
+                             const std::string& shader_name , bool& corrupted) {
+        ResourceHandler* resource_handler = ResourceHandler::Instance();
+
+        shader = resource_handler->Get(handle);
+        if (shader == nullptr) {
+            handle = resource_handler->FindShader(shader_name);
+            shader = resource_handler->Get(handle);
+        }
         
         if (shader == nullptr) {
             YE_WARN("Entity [{0}] has corrupt renderable, could not find shader [{1}]" , entity_name , shader_name);
@@ -80,6 +178,10 @@ namespace YE {
         registry.on_construct<components::CapsuleCollider>().connect<&CapsuleColliderCreated>();
         registry.on_construct<components::MeshCollider>().connect<&MeshColliderCreated>();
         
+        // the renderable handlers also keep the scene's spatial tree in step , so they are bound to the scene
+        registry.on_destroy<components::Renderable>().connect<&RenderableDestroyed>(*context);
+        registry.on_destroy<components::TexturedRenderable>().connect<&TexturedRenderableDestroyed>(*context);
+        registry.on_destroy<components::RenderableModel>().connect<&ModelDestroyed>(*context);
         registry.on_destroy<components::PhysicsBody>().connect<&PhysicsBodyDestroyed>();
         registry.on_destroy<components::BoxCollider>().connect<&BoxColliderDestroyed>();
         registry.on_destroy<components::SphereCollider>().connect<&SphereColliderDestroyed>();
@@ -100,6 +202,7 @@ namespace YE {
         id.id = Hash::FNV(name);
 
         context->entities[id.id] = entity;
+        context->hierarchy_dirty = true;
     }
 
     void Systems::ModelCreated(entt::registry& registry , entt::entity entity) {
@@ -109,16 +212,25 @@ namespace YE {
         if (model.model_name == "" || model.shader_name == "") 
             return;
         
-        model.model = ResourceHandler::Instance()->GetModel(model.model_name);
+        ResourceHandler* resource_handler = ResourceHandler::Instance();
+
+        model.model = resource_handler->Get(model.model_handle);
+        if (model.model == nullptr) {
+            model.model_handle = resource_handler->FindModel(model.model_name);
+            model.model = resource_handler->Get(model.model_handle);
+        }
+
         if (model.model == nullptr) {
             YE_WARN("Entity has corrupt renderable, could not find model [{0}]" , model.model_name);
             model.corrupted = true;
             return;
         }
 
-        model.shader = ResourceHandler::Instance()->GetShader(model.shader_name);
-        if (model.shader == nullptr)
-            model.shader = ResourceHandler::Instance()->GetCoreShader(model.shader_name);
+        model.shader = resource_handler->Get(model.shader_handle);
+        if (model.shader == nullptr) {
+            model.shader_handle = resource_handler->FindShader(model.shader_name);
+            model.shader = resource_handler->Get(model.shader_handle);
+        }
 
         if (model.shader == nullptr) {
             YE_WARN("Entity with model [{0}] has corrupt renderable, could not find shader [{1}]" , model.model_name , model.shader_name);
@@ -173,32 +285,102 @@ namespace YE {
     }
 
     void Systems::MeshColliderCreated(entt::registry& registry , entt::entity entity) {
-        auto& transform = registry.get<components::Transform>(entity);
         auto& model = registry.get<components::RenderableModel>(entity);
         auto& collider = registry.get<components::MeshCollider>(entity);
         auto& body = registry.get<components::PhysicsBody>(entity);
 
-        PhysicsEngine* physics_engine = PhysicsEngine::Instance();
-        collider.mesh = physics_engine->CreatePolygonMesh(model.model->Vertices() , model.model->Indices() , model.model->NumFaces());
-        collider.shape = physics_engine->CreateConvexMeshShape(collider.mesh);
-        rp3d::Transform local_transform = reactphysics3d::Transform::identity();
+        // a model still in flight gets its collider from BuildPendingColliders once the upload lands ,
+        //  finishing the load here would make GL calls while the render thread owns the context
+        if (model.model == nullptr || !model.model->Valid())
+            return;
 
-        collider.collider = body.body->addCollider(collider.shape , local_transform);
+        BuildMeshCollider(model.model , collider , body);
     } 
 
+    void Systems::BuildPendingColliders(Scene* context) {
+        auto& registry = context->registry;
+        bool loading = ResourceHandler::Instance()->Loading();
+
+        auto view = registry.view<components::RenderableModel , components::MeshCollider , components::PhysicsBody>();
+        for (auto entity : view) {
+            auto& collider = view.get<components::MeshCollider>(entity);
+            if (collider.collider != nullptr || collider.failed)
+                continue;
+
+            auto& model = view.get<components::RenderableModel>(entity);
+            if (model.model != nullptr && model.model->Valid()) {
+                BuildMeshCollider(model.model , collider , view.get<components::PhysicsBody>(entity));
+            } else if (model.model == nullptr || !loading) {
+                YE_WARN("Failed to build mesh collider :: [{0}] | Model failed to load" , entt::to_integral(entity));
+                collider.failed = true;
+            }
+        }
+    }
+
     void Systems::LoadShaders(Scene* context) {
         auto& registry = context->registry;
 
+        // shaders can be swapped out on reload so every persistent draw has to pick up the new program
         registry.view<components::ID , components::Renderable>().each([](auto& id , auto& renderable) {
-            LoadShader(renderable.shader , id.name , renderable.shader_name , renderable.corrupted);
+            LoadShader(renderable.shader , renderable.shader_handle , id.name , renderable.shader_name , renderable.corrupted);
+            renderable.MarkDirty();
         });
 
         registry.view<components::ID , components::TexturedRenderable>().each([](auto& id , auto& renderable) {
-           LoadShader(renderable.shader , id.name , renderable.shader_name , renderable.corrupted);
+           LoadShader(renderable.shader , renderable.shader_handle , id.name , renderable.shader_name , renderable.corrupted);
+           renderable.MarkDirty();
         });
 
         registry.view<components::ID , components::RenderableModel>().each([](auto& id , auto& script) {
-            LoadShader(script.shader , id.name , script.shader_name , script.corrupted);
+            LoadShader(script.shader , script.shader_handle , id.name , script.shader_name , script.corrupted);
+            script.MarkDirty();
+        });
+    }
+
+    void Systems::RebindReloaded(Scene* context) {
+        ResourceHandler* resource_handler = ResourceHandler::Instance();
+        const auto& shaders = resource_handler->ReloadedShaders();
+        const auto& textures = resource_handler->ReloadedTextures();
+
+        auto shader_reloaded = [&shaders](const Shader* shader) {
+            return std::find(shaders.begin() , shaders.end() , shader) != shaders.end();
+        };
+        auto texture_reloaded = [&textures](const std::vector<Texture*>& used) {
+            return std::find_first_of(used.begin() , used.end() , textures.begin() , textures.end()) != used.end();
+        };
+
+        auto& registry = context->registry;
+
+        // shaders and textures are reloaded in place , only the draws using them are rebuilt
+        registry.view<components::Renderable>().each([&](auto& renderable) {
+            if (shader_reloaded(renderable.shader))
+                renderable.MarkDirty();
+        });
+
+        registry.view<components::TexturedRenderable>().each([&](auto& renderable) {
+            if (shader_reloaded(renderable.shader) || texture_reloaded(renderable.textures))
+                renderable.MarkDirty();
+        });
+
+        // a reloaded model is a new object , entities still holding the old one find it by name. the old one is
+        // freed once this has run , so collision meshes built from it move over too
+        registry.view<components::RenderableModel>().each([&](auto entity , auto& renderable) {
+            if (resource_handler->ModelsReloaded() && renderable.model != nullptr && 
+                resource_handler->Get(renderable.model_handle) == nullptr) {
+                renderable.model_handle = resource_handler->FindModel(renderable.model_name);
+                if (Model* model = resource_handler->Get(renderable.model_handle); model != nullptr) {
+                    renderable.model = model;
+                    renderable.MarkDirty();
+
+                    auto* collider = registry.template try_get<components::MeshCollider>(entity);
+                    auto* body = registry.template try_get<components::PhysicsBody>(entity);
+                    if (collider != nullptr && body != nullptr && collider->collider != nullptr)
+                        BuildMeshCollider(model , *collider , *body);
+                }
+            }
+
+            if (shader_reloaded(renderable.shader))
+                renderable.MarkDirty();
         });
     }
             
@@ -212,6 +394,7 @@ namespace YE {
     }
 
     void Systems::UpdateScene(Scene* context , float dt) {
+        BuildPendingColliders(context);
         PhysicsEngine::Instance()->StepPhysics();
 
         if (ResourceHandler::Instance()->ShadersReloaded()) {
@@ -219,19 +402,204 @@ namespace YE {
             ResourceHandler::Instance()->AcknowledgeShaderReload();
         }
 
+        if (ResourceHandler::Instance()->HotReloaded()) {
+            RebindReloaded(context);
+            ResourceHandler::Instance()->AcknowledgeHotReload();
+        }
+
         if (ScriptEngine::Instance()->ModulesReloaded()) {
             BindScripts(context);
             ScriptEngine::Instance()->AcknowledgeModuleReload();
         }
     }
 
+    void Systems::BuildTransformOrder(Scene* context) {
+        auto& registry = context->registry;
+        auto& order = context->transform_order;
+        order.clear();
+
+        std::unordered_set<entt::entity> visited;
+
+        // physics bodies are simulated in world space so they are always treated as roots
+        registry.view<components::Grouping , components::Transform>().each([&](auto entity , auto& grouping , auto&) {
+            if (grouping.parent == 0 || context->GetEntity(grouping.parent) == nullptr ||
+                registry.all_of<components::PhysicsBody>(entity)) {
+                order.push_back({ entity , entt::null });
+                visited.insert(entity);
+            }
+        });
+
+        // breadth first so every parent is resolved before its children
+        for (size_t i = 0; i < order.size(); ++i) {
+            entt::entity parent = order[i].entity;
+            const auto& parent_id = registry.get<components::ID>(parent);
+            const auto& grouping = registry.get<components::Grouping>(parent);
+
+            for (auto& child_id : grouping.children) {
+                Entity* child = context->GetEntity(child_id);
+                if (child == nullptr) continue;
+
+                entt::entity child_entity = child->GetEntity();
+                if (visited.find(child_entity) != visited.end()) continue;
+
+                const auto& child_grouping = registry.get<components::Grouping>(child_entity);
+                if (child_grouping.parent != parent_id.id) continue;
+
+                order.push_back({ child_entity , parent });
+                visited.insert(child_entity);
+            }
+        }
+
+        // a reparented or orphaned entity still holds the world matrix of its old parent , hierarchy changes
+        //  are rare so every node is recomputed instead of tracking which ones moved
+        for (auto& node : order)
+            registry.get<components::Transform>(node.entity).changed = true;
+
+        context->hierarchy_dirty = false;
+    }
+
+    void Systems::ResetChangedTransforms(Scene* context) {
+        auto& registry = context->registry;
+        for (auto entity : context->changed_transforms) {
+            if (!registry.valid(entity)) continue;
+            registry.get<components::Transform>(entity).changed = false;
+        }
+        context->changed_transforms.clear();
+    }
+
+    void Systems::PropagateTransforms(Scene* context) {
+        if (context->hierarchy_dirty)
+            BuildTransformOrder(context);
+
+        auto& registry = context->registry;
+        for (auto& node : context->transform_order) {
+            auto& transform = registry.get<components::Transform>(node.entity);
+
+            if (node.parent == entt::null) {
+                if (!transform.changed) continue;
+                transform.model = transform.local;
+            } else {
+                const auto& parent = registry.get<components::Transform>(node.parent);
+                if (!transform.changed && !parent.changed) continue;
+
+                transform.model = parent.model * transform.local;
+                transform.changed = true;
+            }
+
+            context->changed_transforms.push_back(node.entity);
+        }
+    }
+
+    void Systems::UpdateBounds(Scene* context) {
+        auto& registry = context->registry;
+        for (auto entity : context->changed_transforms) {
+            auto* bounds = registry.try_get<components::Bounds>(entity);
+            if (bounds == nullptr) continue;
+
+            bounds->world = bounds->local.Transform(registry.get<components::Transform>(entity).model);
+            bounds->sphere = CalculateSphere(bounds->world);
+
+            SyncProxy(context->spatial_tree , entity , *bounds);
+        }
+
+        context->spatial_tree.Optimize();
+    }
+
+    void Systems::CullRenderables(Scene* context , Camera* camera) {
+        auto& registry = context->registry;
+        auto view = registry.view<components::Bounds>();
+
+        auto& entities = context->cull_entities;
+        entities.assign(view.begin() , view.end());
+        const uint32_t count = static_cast<uint32_t>(entities.size());
+
+        if (camera == nullptr) {
+            for (auto entity : entities) {
+                auto& bounds = view.get<components::Bounds>(entity);
+                bounds.visibility_changed = !bounds.visible;
+                bounds.visible = true;
+            }
+            Renderer::Instance()->SetCullingStats(count , count);
+            return;
+        }
+
+        const Frustum frustum(camera->ViewProjection());
+        std::atomic<uint32_t> num_visible = 0;
+
+        // boxes are copied out in small batches so the frustum test runs over contiguous memory
+        auto cull_range = [&view , &entities , &frustum , &num_visible](uint32_t begin , uint32_t end) {
+            std::array<AABB , kCullBatchSize> boxes;
+            std::array<uint8_t , kCullBatchSize> visible;
+            uint32_t range_visible = 0;
+
+            for (uint32_t first = begin; first < end; first += kCullBatchSize) {
+                const uint32_t batch = std::min(kCullBatchSize , end - first);
+
+                for (uint32_t i = 0; i < batch; ++i)
+                    boxes[i] = view.get<components::Bounds>(entities[first + i]).world;
+
+                range_visible += frustum.Cull(boxes.data() , batch , visible.data());
+
+                for (uint32_t i = 0; i < batch; ++i) {
+                    auto& bounds = view.get<components::Bounds>(entities[first + i]);
+                    const bool is_visible = visible[i] != 0;
+                    bounds.visibility_changed = bounds.visible != is_visible;
+                    bounds.visible = is_visible;
+                }
+            }
+
+            num_visible.fetch_add(range_visible , std::memory_order_relaxed);
+        };
+
+        if (count <= kCullEachGrain) {
+            cull_range(0 , count);
+        } else {
+            TaskManager* task_manager = TaskManager::Instance();
+            JobHandle handle = task_manager->DispatchParallel(count , kCullEachGrain , cull_range);
+            task_manager->WaitFor(handle);
+        }
+
+        Renderer::Instance()->SetCullingStats(count , num_visible.load());
+    }
+
+    void Systems::SelectLods(Scene* context , Camera* camera) {
+        auto& registry = context->registry;
+
+        const float tan_half_fov = camera != nullptr ? glm::tan(glm::radians(camera->FOV()) * 0.5f) : 0.f;
+        const glm::vec3 eye = camera != nullptr ? camera->Position() : glm::vec3(0.f);
+
+        // hidden models are updated too so nothing pops the frame they come back into view
+        registry.view<components::Bounds , components::RenderableModel>().each(
+            [camera , tan_half_fov , &eye](auto& bounds , auto& renderable) {
+                if (renderable.model == nullptr || !renderable.model->Valid()) return;
+
+                uint32_t lod = 0;
+                if (camera != nullptr && renderable.model->NumLods() > 1) 
+                    lod = renderable.model->SelectLod(ProjectedSize(bounds.sphere , eye , tan_half_fov) , renderable.lod);
+
+                if (lod != renderable.lod) {
+                    renderable.lod = lod;
+                    renderable.dirty = true;
+                }
+            }
+        );
+    }
+
     void Systems::UpdateTransform(components::Transform& transform) {
-        transform.model = glm::mat4(1.f);
-        transform.model = glm::translate(transform.model , transform.position);
-        transform.model = glm::rotate(transform.model , transform.rotation.x , glm::vec3(1.f , 0.f , 0.f));
-        transform.model = glm::rotate(transform.model , transform.rotation.y , glm::vec3(0.f , 1.f , 0.f));
-        transform.model = glm::rotate(transform.model , transform.rotation.z , glm::vec3(0.f , 0.f , 1.f));
-        transform.model = glm::scale(transform.model , transform.scale);
+        if (!transform.NeedsUpdate()) return;
+
+        transform.local = glm::mat4(1.f);
+        transform.local = glm::translate(transform.local , transform.position);
+        transform.local = glm::rotate(transform.local , transform.rotation.x , glm::vec3(1.f , 0.f , 0.f));
+        transform.local = glm::rotate(transform.local , transform.rotation.y , glm::vec3(0.f , 1.f , 0.f));
+        transform.local = glm::rotate(transform.local , transform.rotation.z , glm::vec3(0.f , 0.f , 1.f));
+        transform.local = glm::scale(transform.local , transform.scale);
+
+        transform.cached_position = transform.position;
+        transform.cached_rotation = transform.rotation;
+        transform.cached_scale = transform.scale;
+        transform.dirty = false;
+        transform.changed = true;
     }
  
     void Systems::UpdatePhysicsBody(components::PhysicsBody& body , components::Transform& transform) {
@@ -243,16 +611,16 @@ namespace YE {
         rp3d::decimal new_model_mat[kSizeOfTransformMat];
         inter_transform.getOpenGLMatrix(new_model_mat);
 
-        transform.model = glm::mat4(1.f);
-        transform.model = glm::make_mat4(new_model_mat);
-        transform.model = glm::scale(transform.model , transform.scale);
+        transform.local = glm::mat4(1.f);
+        transform.local = glm::make_mat4(new_model_mat);
+        transform.local = glm::scale(transform.local , transform.scale);
 
-        transform.rotation.y = asin(-transform.model[0][2]);
+        transform.rotation.y = asin(-transform.local[0][2]);
 		if (cos(transform.rotation.y) != 0) {
-		    transform.rotation.x = atan2(transform.model[1][2], transform.model[2][2]);
-		    transform.rotation.z = atan2(transform.model[0][1], transform.model[0][0]);
+		    transform.rotation.x = atan2(transform.local[1][2], transform.local[2][2]);
+		    transform.rotation.z = atan2(transform.local[0][1], transform.local[0][0]);
 		} else {
-		    transform.rotation.x = atan2(-transform.model[2][0], transform.model[1][1]);
+		    transform.rotation.x = atan2(-transform.local[2][0], transform.local[1][1]);
 		    transform.rotation.z = 0;
 		}
 
@@ -262,6 +630,13 @@ namespace YE {
             physics_transform.getPosition().z
         };
 
+        // the local matrix came straight from the simulation, keep the transform system from rebuilding it
+        transform.cached_position = transform.position;
+        transform.cached_rotation = transform.rotation;
+        transform.cached_scale = transform.scale;
+        transform.dirty = false;
+        transform.changed = true;
+
         body.SetInterpolationTransform(physics_transform);
     }
     
@@ -270,30 +645,215 @@ namespace YE {
     }
     
     void Systems::UpdateTexturedRenderable(components::TexturedRenderable& renderable , const std::vector<components::PointLight>& plights) {
-        if (renderable.corrupted || renderable.shader == nullptr) return;
-
-        Shader* shader = renderable.shader;
-
-        renderable.shader->Bind();
-        renderable.shader->SetUniformInt("point_light_count" ,  plights.size());
-        
-        for (uint32_t i = 0; i < plights.size(); ++i) {
-            shader->SetUniformVec3("plights[" + std::to_string(i) + "].position" , plights[i].position);
-            shader->SetUniformVec3("plights[" + std::to_string(i) + "].diffuse" , plights[i].diffuse);
-            shader->SetUniformVec3("plights[" + std::to_string(i) + "].ambient" , plights[i].ambient);
-            shader->SetUniformVec3("plights[" + std::to_string(i) + "].specular" , plights[i].specular);
-            shader->SetUniformFloat("plights[" + std::to_string(i) + "].constant" , plights[i].constant_attenuation);
-            shader->SetUniformFloat("plights[" + std::to_string(i) + "].linear" , plights[i].linear_attenuation);
-            shader->SetUniformFloat("plights[" + std::to_string(i) + "].quadratic" , plights[i].quadratic_attenuation);
-        }
-        renderable.shader->SetUniformFloat("material.shininess" , renderable.material.shininess);
-        renderable.shader->Unbind();
+        // lights and materials are applied by the renderer when the draw executes , this runs while the
+        //  render thread may own the GL context
     }
     
     void Systems::UpdateRenderableModel(components::RenderableModel& renderable , const std::vector<components::PointLight>& lights) {
 
     }
 
+    void Systems::SyncRenderables(Scene* context) {
+        Renderer* renderer = Renderer::Instance();
+        auto& registry = context->registry;
+
+        registry.view<components::Transform , components::Renderable>().each(
+            [context , &registry , renderer](auto entity , auto& transform , auto& renderable) {
+                UUID id = RenderableID(context->draw_tag , entity , RenderableKind::RENDERABLE);
+
+                if (!renderable.corrupted && renderable.vao == nullptr) {
+                    YE_WARN("Failed to draw renderable :: VAO is null");
+                    renderable.corrupted = true;
+                }
+
+                if (renderable.corrupted || renderable.shader == nullptr) {
+                    if (renderable.submitted) renderer->RemoveRenderCmnd(id);
+                    renderable.submitted = false;
+                    return;
+                }
+
+                auto* light = registry.template try_get<components::PointLight>(entity);
+
+                if (!renderable.submitted || renderable.dirty) {
+                    DrawCommand cmnd;
+                    cmnd.vao = renderable.vao;
+                    cmnd.shader = renderable.shader;
+                    cmnd.transform = transform.model;
+                    if (light != nullptr) {
+                        cmnd.has_light_color = true;
+                        cmnd.light_color = light->diffuse;
+                    }
+
+                    RefreshBounds(context->spatial_tree , registry , entity , transform);
+                    if (renderable.submitted) {
+                        renderer->UpdateRenderCmnd(id , cmnd);
+                    } else {
+                        renderer->PushRenderable(id , cmnd);
+                        SyncVisibility(renderer , registry , entity , id , true);
+                    }
+
+                    renderable.submitted = true;
+                    renderable.draw_id = id;
+                    renderable.dirty = false;
+                    return;
+                }
+
+                SyncVisibility(renderer , registry , entity , id , false);
+
+                // light colors are usually driven by scripts without touching the component's dirty flag
+                if (light != nullptr) {
+                    const DrawCommand* record = renderer->PersistentRenderable(id);
+                    if (record != nullptr && record->light_color != light->diffuse) {
+                        DrawCommand cmnd = *record;
+                        cmnd.transform = transform.model;
+                        cmnd.light_color = light->diffuse;
+                        renderer->UpdateRenderCmnd(id , cmnd);
+                        return;
+                    }
+                }
+
+                if (transform.changed)
+                    renderer->UpdateRenderTransform(id , transform.model);
+            }
+        );
+
+        registry.view<components::Transform , components::TexturedRenderable>().each(
+            [context , &registry , renderer](auto entity , auto& transform , auto& renderable) {
+                UUID id = RenderableID(context->draw_tag , entity , RenderableKind::TEXTURED);
+
+                if (!renderable.corrupted && renderable.vao == nullptr) {
+                    YE_WARN("Failed to draw textured renderable :: VAO is null");
+                    renderable.corrupted = true;
+                }
+
+                if (!renderable.corrupted) {
+                    for (uint32_t i = 0; i < renderable.textures.size(); ++i) {
+                        if (renderable.textures[i] == nullptr) {
+                            YE_WARN("Failed to draw textured renderable :: Texture [{0}] is null" , i);
+                            renderable.corrupted = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (renderable.corrupted || renderable.shader == nullptr) {
+                    if (renderable.submitted) renderer->RemoveRenderCmnd(id);
+                    renderable.submitted = false;
+                    return;
+                }
+
+                if (!renderable.submitted || renderable.dirty) {
+                    DrawCommand cmnd;
+                    cmnd.vao = renderable.vao;
+                    cmnd.shader = renderable.shader;
+                    cmnd.transform = transform.model;
+                    cmnd.num_textures = static_cast<uint32_t>(renderable.textures.size());
+                    cmnd.textures = renderable.textures.data();
+                    cmnd.has_material = true;
+                    cmnd.shininess = renderable.material.shininess;
+
+                    RefreshBounds(context->spatial_tree , registry , entity , transform);
+                    if (renderable.submitted) {
+                        renderer->UpdateRenderCmnd(id , cmnd);
+                    } else {
+                        renderer->PushRenderable(id , cmnd);
+                        SyncVisibility(renderer , registry , entity , id , true);
+                    }
+
+                    renderable.submitted = true;
+                    renderable.draw_id = id;
+                    renderable.dirty = false;
+                    return;
+                }
+
+                SyncVisibility(renderer , registry , entity , id , false);
+
+                // like light colors , materials are often changed by scripts without marking the component dirty
+                const DrawCommand* record = renderer->PersistentRenderable(id);
+                if (record != nullptr && record->shininess != renderable.material.shininess) {
+                    DrawCommand cmnd = *record;
+                    cmnd.transform = transform.model;
+                    cmnd.shininess = renderable.material.shininess;
+                    renderer->UpdateRenderCmnd(id , cmnd);
+                    return;
+                }
+
+                if (transform.changed)
+                    renderer->UpdateRenderTransform(id , transform.model);
+            }
+        );
+
+        registry.view<components::Transform , components::RenderableModel>().each(
+            [context , &registry , renderer](auto entity , auto& transform , auto& renderable) {
+                UUID id = RenderableID(context->draw_tag , entity , RenderableKind::MODEL);
+
+                if (!renderable.corrupted && renderable.model == nullptr) {
+                    YE_WARN("Failed to draw renderable model :: Model is null");
+                    renderable.corrupted = true;
+                }
+
+                if (renderable.corrupted || renderable.shader == nullptr) {
+                    if (renderable.submitted) renderer->RemoveRenderCmnd(id);
+                    renderable.submitted = false;
+                    return;
+                }
+
+                // still loading , it is submitted on the first frame after its upload lands
+                if (!renderable.model->Valid()) return;
+
+                if (!renderable.submitted || renderable.dirty) {
+                    DrawCommand cmnd;
+                    cmnd.type = DrawCommandType::MODEL;
+                    cmnd.model = renderable.model;
+                    cmnd.lod = renderable.lod;
+                    cmnd.shader = renderable.shader;
+                    cmnd.transform = transform.model;
+
+                    RefreshBounds(context->spatial_tree , registry , entity , transform);
+                    if (renderable.submitted) {
+                        renderer->UpdateRenderCmnd(id , cmnd);
+                    } else {
+                        renderer->PushRenderable(id , cmnd);
+                        SyncVisibility(renderer , registry , entity , id , true);
+                    }
+
+                    renderable.submitted = true;
+                    renderable.draw_id = id;
+                    renderable.dirty = false;
+                    return;
+                }
+
+                SyncVisibility(renderer , registry , entity , id , false);
+
+                if (transform.changed)
+                    renderer->UpdateRenderTransform(id , transform.model);
+            }
+        );
+    }
+
+    void Systems::RemoveRenderables(Scene* context) {
+        Renderer* renderer = Renderer::Instance();
+        auto& registry = context->registry;
+
+        registry.view<components::Renderable>().each([renderer](auto& renderable) {
+            if (renderable.submitted) 
+                renderer->RemoveRenderCmnd(renderable.draw_id);
+            renderable.submitted = false;
+        });
+
+        registry.view<components::TexturedRenderable>().each([renderer](auto& renderable) {
+            if (renderable.submitted) 
+                renderer->RemoveRenderCmnd(renderable.draw_id);
+            renderable.submitted = false;
+        });
+
+        registry.view<components::RenderableModel>().each([renderer](auto& renderable) {
+            if (renderable.submitted) 
+                renderer->RemoveRenderCmnd(renderable.draw_id);
+            renderable.submitted = false;
+        });
+    }
+
     void Systems::UnbindScripts(Scene* context) {
         ScriptEngine* script_engine = ScriptEngine::Instance();
         auto& registry = context->registry;
@@ -336,10 +896,41 @@ namespace YE {
 
         if (entity->HasComponent<components::PhysicsBody>()) 
             entity->RemoveComponent<components::PhysicsBody>();
+
+        if (entity->HasComponent<components::Bounds>()) {
+            auto& bounds = entity->GetComponent<components::Bounds>();
+            if (bounds.tree_proxy != kNullTreeNode)
+                context->spatial_tree.DestroyProxy(bounds.tree_proxy);
+            bounds.tree_proxy = kNullTreeNode;
+        }
     }
 
-    void Systems::ModelDestroyed(entt::registry& registry , entt::entity entity) {
+    void Systems::RenderableDestroyed(Scene& context , entt::registry& registry , entt::entity entity) {
+        auto& renderable = registry.get<components::Renderable>(entity);
+        if (renderable.submitted)
+            Renderer::Instance()->RemoveRenderCmnd(renderable.draw_id);
+        renderable.submitted = false;
+
+        ReleaseBounds(context.spatial_tree , registry , entity , RenderableKind::RENDERABLE);
+    }
+
+    void Systems::TexturedRenderableDestroyed(Scene& context , entt::registry& registry , entt::entity entity) {
+        auto& renderable = registry.get<components::TexturedRenderable>(entity);
+        if (renderable.submitted)
+            Renderer::Instance()->RemoveRenderCmnd(renderable.draw_id);
+        renderable.submitted = false;
+
+        ReleaseBounds(context.spatial_tree , registry , entity , RenderableKind::TEXTURED);
+    }
+
+    void Systems::ModelDestroyed(Scene& context , entt::registry& registry , entt::entity entity) {
         auto& model = registry.get<components::RenderableModel>(entity);
+        if (model.submitted)
+            Renderer::Instance()->RemoveRenderCmnd(model.draw_id);
+        model.submitted = false;
+
+        ReleaseBounds(context.spatial_tree , registry , entity , RenderableKind::MODEL);
+
         model.model = nullptr;
         model.shader = nullptr;
     }
@@ -366,7 +957,8 @@ namespace YE {
     
     void Systems::MeshColliderDestroyed(entt::registry& context , entt::entity entity) {
         auto& collider = context.get<components::MeshCollider>(entity);
-        PhysicsEngine::Instance()->DestroyConvexMeshShape(collider.shape);
+        if (collider.shape != nullptr)
+            PhysicsEngine::Instance()->DestroyConvexMeshShape(collider.shape);
     }
 
     void Systems::SceneUnload(Scene* context) {
@@ -390,7 +982,8 @@ namespace YE {
         });
 
         registry.view<components::MeshCollider>().each([physics_engine](auto& collider) {
-            physics_engine->DestroyConvexMeshShape(collider.shape);
+            if (collider.shape != nullptr)
+                physics_engine->DestroyConvexMeshShape(collider.shape);
         });
     }
 
@@ -412,13 +1005,18 @@ namespace YE {
     }
 
     void Systems::CleanupContext(Scene* context) {
+        RemoveRenderables(context);
+        context->spatial_tree.Clear();
+
         auto& registry = context->registry;
         registry.on_destroy<components::MeshCollider>().disconnect<&MeshColliderDestroyed>();
         registry.on_destroy<components::CapsuleCollider>().disconnect<&CapsuleColliderDestroyed>();
         registry.on_destroy<components::SphereCollider>().disconnect<&SphereColliderDestroyed>();
         registry.on_destroy<components::BoxCollider>().disconnect<&BoxColliderDestroyed>();
         registry.on_destroy<components::PhysicsBody>().disconnect<&PhysicsBodyDestroyed>();
-        registry.on_destroy<components::RenderableModel>().disconnect<&ModelDestroyed>();
+        registry.on_destroy<components::RenderableModel>().disconnect<&ModelDestroyed>(*context);
+        registry.on_destroy<components::TexturedRenderable>().disconnect<&TexturedRenderableDestroyed>(*context);
+        registry.on_destroy<components::Renderable>().disconnect<&RenderableDestroyed>(*context);
 
         registry.on_construct<components::MeshCollider>().disconnect<&MeshColliderCreated>();
         registry.on_construct<components::CapsuleCollider>().disconnect<&CapsuleColliderCreated>();
@@ -175,6 +175,11 @@ namespace YE {
         YE_ADD_SCRIPT_FUNCTION(IsEntityValid);
         YE_ADD_SCRIPT_FUNCTION(GetEntityByName);
 
+        YE_ADD_SCRIPT_FUNCTION(QueryEntitiesInBox);
+        YE_ADD_SCRIPT_FUNCTION(QueryEntitiesInSphere);
+        YE_ADD_SCRIPT_FUNCTION(QueryEntitiesInFrustum);
+        YE_ADD_SCRIPT_FUNCTION(RayCastEntities);
+
         YE_ADD_SCRIPT_FUNCTION(KeyFramesHeld);
         YE_ADD_SCRIPT_FUNCTION(IsKeyPressed);
         YE_ADD_SCRIPT_FUNCTION(IsKeyBlocked);
@@ -1305,10 +1310,71 @@ namespace ScriptInternalCalls {
     }
     // ****************************** //
 
+    // *** Spatial Query Functions *** //
+    static MonoArray* EntityIdArray(Scene* scene , const std::vector<entt::entity>& entities) {
+        auto& registry = scene->Registry();
+
+        MonoArray* result = mono_array_new(mono_domain_get() , mono_get_uint64_class() , entities.size());
+        for (size_t i = 0; i < entities.size(); ++i) {
+            uint64_t id = registry.get<components::ID>(entities[i]).id.uuid;
+            mono_array_set(result , uint64_t , i , id);
+        }
+
+        return result;
+    }
+
+    MonoArray* QueryEntitiesInBox(glm::vec3* min , glm::vec3* max) {
+        Scene* scene = ScriptEngine::Instance()->GetSceneContext();
+
+        std::vector<entt::entity> entities;
+        scene->SpatialTree().Query(AABB(*min , *max) , entities);
+
+        return EntityIdArray(scene , entities);
+    }
+
+    MonoArray* QueryEntitiesInSphere(glm::vec3* center , float radius) {
+        Scene* scene = ScriptEngine::Instance()->GetSceneContext();
+
+        std::vector<entt::entity> entities;
+        scene->SpatialTree().Query(BoundingSphere{ *center , radius } , entities);
+
+        return EntityIdArray(scene , entities);
+    }
+
+    MonoArray* QueryEntitiesInFrustum(uint32_t camera_id) {
+        Scene* scene = ScriptEngine::Instance()->GetSceneContext();
+
+        std::vector<entt::entity> entities;
+        Camera* camera = scene->GetCamera(camera_id);
+        if (camera == nullptr) {
+            YE_ERROR("QueryEntitiesInFrustum :: Attempted to retrieve invalid camera with ID: {0}" , camera_id);
+            return EntityIdArray(scene , entities);
+        }
+
+        scene->SpatialTree().Query(Frustum(camera->ViewProjection()) , entities);
+
+        return EntityIdArray(scene , entities);
+    }
+
+    bool RayCastEntities(glm::vec3* origin , glm::vec3* direction , float max_distance , uint64_t* entity_id , float* distance) {
+        Scene* scene = ScriptEngine::Instance()->GetSceneContext();
+
+        RayHit hit;
+        if (!scene->SpatialTree().RayCast(*origin , *direction , max_distance , hit)) {
+            *entity_id = 0;
+            *distance = 0.f;
+            return false;
+        }
+
+        *entity_id = scene->Registry().get<components::ID>(hit.entity).id.uuid;
+        *distance = hit.distance;
+        return true;
+    }
+    // ****************************** //
+
     // *** Keyboard Functions *** //
     uint32_t KeyFramesHeld(uint32_t key) {
-        if (static_cast<Keyboard::Key>(key) < Keyboard::Key::YE_UNKNOWN || 
-            static_cast<Keyboard::Key>(key) > Keyboard::Key::YE_NUM_YES) {
+        if (!Keyboard::Valid(key)) {
             YE_ERROR("IsKeyDown :: Attempted to retrieve invalid key: {0}" , key);
             return false;
         }
@@ -1318,8 +1384,7 @@ namespace ScriptInternalCalls {
     }
 
     bool IsKeyPressed(uint32_t key) {
-        if (static_cast<Keyboard::Key>(key) < Keyboard::Key::YE_UNKNOWN || 
-            static_cast<Keyboard::Key>(key) > Keyboard::Key::YE_NUM_YES) {
+        if (!Keyboard::Valid(key)) {
             YE_ERROR("IsKeyDown :: Attempted to retrieve invalid key: {0}" , key);
             return false;
         }
@@ -1328,8 +1393,7 @@ namespace ScriptInternalCalls {
     }
 
     bool IsKeyBlocked(uint32_t key) {
-        if (static_cast<Keyboard::Key>(key) < Keyboard::Key::YE_UNKNOWN || 
-            static_cast<Keyboard::Key>(key) > Keyboard::Key::YE_NUM_YES) {
+        if (!Keyboard::Valid(key)) {
             YE_ERROR("IsKeyDown :: Attempted to retrieve invalid key: {0}" , key);
             return false;
         }
@@ -1338,8 +1402,7 @@ namespace ScriptInternalCalls {
     }
 
     bool IsKeyHeld(uint32_t key) {
-        if (static_cast<Keyboard::Key>(key) < Keyboard::Key::YE_UNKNOWN || 
-            static_cast<Keyboard::Key>(key) > Keyboard::Key::YE_NUM_YES) {
+        if (!Keyboard::Valid(key)) {
             YE_ERROR("IsKeyDown :: Attempted to retrieve invalid key: {0}" , key);
             return false;
         }
@@ -1348,8 +1411,7 @@ namespace ScriptInternalCalls {
     }
 
     bool IsKeyDown(uint32_t key) {
-        if (static_cast<Keyboard::Key>(key) < Keyboard::Key::YE_UNKNOWN || 
-            static_cast<Keyboard::Key>(key) > Keyboard::Key::YE_NUM_YES) {
+        if (!Keyboard::Valid(key)) {
             YE_ERROR("IsKeyDown :: Attempted to retrieve invalid key: {0}" , key);
             return false;
         }
@@ -1358,8 +1420,7 @@ namespace ScriptInternalCalls {
     }
 
     bool IsKeyReleased(uint32_t key) {
-        if (static_cast<Keyboard::Key>(key) < Keyboard::Key::YE_UNKNOWN || 
-            static_cast<Keyboard::Key>(key) > Keyboard::Key::YE_NUM_YES) {
+        if (!Keyboard::Valid(key)) {
             YE_ERROR("IsKeyDown :: Attempted to retrieve invalid key: {0}" , key);
             return false;
         }
@@ -65,7 +65,7 @@ class Launcher : public YE::App {
             EngineY::RegisterKeyPressCallback(
                 [&](YE::KeyPressed* event) -> bool {
                     if (event->Key() == YE::Keyboard::Key::YE_ESCAPE && !editor_open) {
-                        EngineY::DispatchEvent(ynew YE::ShutdownEvent);
+                        EngineY::DispatchEvent(YE::ShutdownEvent{});
                     }
                     return true;
                 } ,
@@ -196,7 +196,7 @@ void Launcher::BuildProject() {
 }
 
 void Launcher::LaunchProject() {
-    EngineY::EventManager()->DispatchEvent(ynew YE::ShutdownEvent);
+    EngineY::EventManager()->DispatchEvent(YE::ShutdownEvent{});
 
 #if YE_PLATFORM_WIN
     std::filesystem::path proj_executable = project_folder / "bin" / "Debug" / project_name_str / (project_name_str + ".exe");
@@ -225,7 +225,7 @@ void Launcher::LaunchProject() {
         CloseHandle(process_info.hThread);
         CloseHandle(process_info.hProcess);
 
-        EngineY::EventManager()->DispatchEvent(ynew YE::ShutdownEvent);
+        EngineY::EventManager()->DispatchEvent(YE::ShutdownEvent{});
     } else {
         YE_ERROR("Failed to launch project");
         DWORD error = GetLastError();
@@ -438,7 +438,7 @@ void Launcher::ConfigureProject() {
             BuildProject();
             LaunchProject();
 
-            EngineY::DispatchEvent(ynew YE::ShutdownEvent);
+            EngineY::DispatchEvent(YE::ShutdownEvent{});
         }
     }
     ImGui::End();
@@ -249,6 +249,20 @@ namespace YE {
         internal static extern ulong GetEntityFromName(string name);
 #endregion
 
+#region Spatial
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] QueryEntitiesInBox(ref Vec3 min , ref Vec3 max);
+        
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] QueryEntitiesInSphere(ref Vec3 center , float radius);
+        
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] QueryEntitiesInFrustum(int camera_id);
+        
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern bool RayCastEntities(ref Vec3 origin , ref Vec3 direction , float max_distance , out ulong entity , out float distance);
+#endregion
+
 #region Keyboard
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern int KeyFramesHeld(KeyCode key);
@@ -74,6 +74,32 @@ namespace YE {
             return new_entity;
         }
         
+        public Entity[] EntitiesInBox(Vec3 min , Vec3 max) => EntitiesFromIds(Engine.QueryEntitiesInBox(ref min , ref max));
+        
+        public Entity[] EntitiesInSphere(Vec3 center , float radius) => EntitiesFromIds(Engine.QueryEntitiesInSphere(ref center , radius));
+        
+        public Entity[] EntitiesInFrustum(Camera camera) {
+            if (camera == null)
+                return new Entity[0];
+            return EntitiesFromIds(Engine.QueryEntitiesInFrustum(camera.Id));
+        }
+
+        public Entity Raycast(Vec3 origin , Vec3 direction , float max_distance , out float distance) {
+            if (!Engine.RayCastEntities(ref origin , ref direction , max_distance , out ulong id , out distance))
+                return null;
+            return EntityFromId(id);
+        }
+
+        private Entity[] EntitiesFromIds(ulong[] ids) {
+            var result = new List<Entity>(ids.Length);
+            foreach (var id in ids) {
+                var entity = EntityFromId(id);
+                if (entity != null)
+                    result.Add(entity);
+            }
+            return result.ToArray();
+        }
+        
         private void EntityDestroyed(Entity entity) {
             entity.Destroyed -= EntityDestroyed;
 
@@ -37,6 +37,7 @@ workspace "engine"
     include(externals_folder .. "/nativefiledialog")
 
     include "modules"
+    include "bench"
 
     project "engine"
         location "engine"
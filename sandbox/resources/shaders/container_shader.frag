@@ -7,10 +7,17 @@ in vec3 frag_tangent;
 in vec3 frag_bitangent;
 in vec2 frag_texcoord;
 in float frag_opacity;
+flat in vec4 frag_layers;
 
 out vec4 FragColor;
 
-uniform vec3 view_pos;
+layout (std140 , binding = 0) uniform Camera {
+    mat4 view;
+    mat4 proj;
+    mat4 view_proj;
+    vec3 view_pos;
+    bool camera_active;
+};
 
 struct Material {
     vec3 diffuse;
@@ -66,12 +73,27 @@ uniform sampler2D tex0;
 uniform sampler2D tex1;
 uniform Material material;
 
+// the same textures read out of shared arrays , frag_layers holds the layer of each slot
+uniform bool texture_arrays = false;
+uniform sampler2DArray tex_array0;
+uniform sampler2DArray tex_array1;
+
+vec3 Diffuse() {
+    return texture_arrays ? texture(tex_array0 , vec3(frag_texcoord , frag_layers.x)).rgb : texture(tex0 , frag_texcoord).rgb;
+}
+
+vec3 Specular() {
+    return texture_arrays ? texture(tex_array1 , vec3(frag_texcoord , frag_layers.y)).rgb : texture(tex1 , frag_texcoord).rgb;
+}
+
 #define MAX_POINT_LIGHTS 128
 
 // lights
 uniform DirectionalLight dlight;
-uniform int point_light_count;
-uniform PointLight plights[MAX_POINT_LIGHTS];
+layout (std140 , binding = 1) uniform Lights {
+    int point_light_count;
+    PointLight plights[MAX_POINT_LIGHTS];
+};
 // uniform PointLight plight;
 uniform SpotLight slight;
 
@@ -99,9 +121,9 @@ vec3 CalculateDirLight(DirectionalLight light , vec3 normal , vec3 view_dir) {
     float diff = max(dot(normal , light_dir) , 0.0);
     float spec = pow(max(dot(view_dir , reflect_dir) , 0.0) , material.shininess);
 
-    vec3 ambient = light.ambient * texture(tex0 , frag_texcoord).rgb;
-    vec3 diffuse = light.diffuse * diff * texture(tex0 , frag_texcoord).rgb;
-    vec3 specular = light.specular * spec * texture(tex1 , frag_texcoord).rgb;
+    vec3 ambient = light.ambient * Diffuse();
+    vec3 diffuse = light.diffuse * diff * Diffuse();
+    vec3 specular = light.specular * spec * Specular();
 
     return ambient + diffuse + specular;
 }
@@ -115,9 +137,9 @@ vec3 CalculatePointLight(PointLight light , vec3 normal , vec3 frag_pos , vec3 v
     float dist = length(light.position - frag_pos);
     float attentuation = 1.0 / (light.constant + light.linear * dist + light.quadratic * (dist * dist));
 
-    vec3 ambient = light.ambient * texture(tex0 , frag_texcoord).rgb;
-    vec3 diffuse = light.diffuse * diff * texture(tex0 , frag_texcoord).rgb;
-    vec3 specular = light.specular * spec * texture(tex1 , frag_texcoord).rgb;
+    vec3 ambient = light.ambient * Diffuse();
+    vec3 diffuse = light.diffuse * diff * Diffuse();
+    vec3 specular = light.specular * spec * Specular();
     ambient *= attentuation;
     diffuse *= attentuation;
     specular *= attentuation;
@@ -127,17 +149,17 @@ vec3 CalculatePointLight(PointLight light , vec3 normal , vec3 frag_pos , vec3 v
 
 vec3 CalculateSpotLight(SpotLight slight , vec3 normal , vec3 frag_pos , vec3 view_dir) {
     // ambient
-    vec3 ambient = slight.ambient * texture(tex0 , frag_texcoord).rgb;
+    vec3 ambient = slight.ambient * Diffuse();
 
     // diffuse
     vec3 light_dir = normalize(slight.position - frag_pos);
     float diff = max(dot(normal , light_dir), 0.0);
-    vec3 diffuse = slight.diffuse * diff * texture(tex0 , frag_texcoord).rgb;
+    vec3 diffuse = slight.diffuse * diff * Diffuse();
 
     // specular 
     vec3 sreflect_dir = reflect(-light_dir, normal);
     float spec = pow(max(dot(view_dir , sreflect_dir) , 0.0) , material.shininess);
-    vec3 specular = slight.specular * spec * texture(tex1 , frag_texcoord).rgb;
+    vec3 specular = slight.specular * spec * Specular();
 
     // spotlight
     float theta = dot(light_dir, normalize(-slight.direction));
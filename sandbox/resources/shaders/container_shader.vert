@@ -7,6 +7,8 @@ layout (location = 3) in vec3 in_tangent;
 layout (location = 4) in vec3 in_bitangent;
 layout (location = 5) in vec2 in_texcoord;
 layout (location = 6) in float in_opacity;
+layout (location = 8) in mat4 in_instance_model;
+layout (location = 12) in vec4 in_instance_layers;
 
 out vec3 frag_pos;
 out vec3 frag_color;
@@ -15,21 +17,31 @@ out vec3 frag_tangent;
 out vec3 frag_bitangent;
 out vec2 frag_texcoord;
 out float frag_opacity;
+flat out vec4 frag_layers;
 
-uniform bool camera_active = false;
+layout (std140 , binding = 0) uniform Camera {
+    mat4 view;
+    mat4 proj;
+    mat4 view_proj;
+    vec3 view_pos;
+    bool camera_active;
+};
+
+uniform bool instanced = false;
 
 uniform mat4 model;
-uniform mat4 proj;
-uniform mat4 view;
+uniform vec4 texture_layers;
 
 void main() {
-    frag_pos = vec3(model * vec4(in_pos, 1.0));
-    frag_normal = mat3(transpose(inverse(model))) * in_normal;
+    mat4 model_matrix = instanced ? in_instance_model : model;
+
+    frag_pos = vec3(model_matrix * vec4(in_pos, 1.0));
+    frag_normal = mat3(transpose(inverse(model_matrix))) * in_normal;
 
     if (camera_active) {
-        gl_Position = proj * view * vec4(frag_pos , 1.0);
+        gl_Position = view_proj * vec4(frag_pos , 1.0);
     } else {
-        gl_Position = model * vec4(in_pos , 1.0);
+        gl_Position = model_matrix * vec4(in_pos , 1.0);
     }
 
     frag_color = in_color;
@@ -37,4 +49,5 @@ void main() {
     frag_bitangent = in_bitangent;
     frag_texcoord = in_texcoord;
     frag_opacity = in_opacity;
+    frag_layers = instanced ? in_instance_layers : texture_layers;
 }
\ No newline at end of file
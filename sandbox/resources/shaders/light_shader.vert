@@ -2,10 +2,16 @@
 
 layout (location = 0) in vec3 in_pos;
 
+layout (std140 , binding = 0) uniform Camera {
+    mat4 view;
+    mat4 proj;
+    mat4 view_proj;
+    vec3 view_pos;
+    bool camera_active;
+};
+
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 proj;
 
 void main() {
-    gl_Position = proj * view * model * vec4(in_pos, 1.0);
+    gl_Position = view_proj * model * vec4(in_pos, 1.0);
 }
\ No newline at end of file
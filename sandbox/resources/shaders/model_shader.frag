@@ -54,7 +54,13 @@ struct SpotLight {
     float quadratic;
 };
 
-uniform vec3 view_pos;
+layout (std140 , binding = 0) uniform Camera {
+    mat4 view;
+    mat4 proj;
+    mat4 view_proj;
+    vec3 view_pos;
+    bool camera_active;
+};
 uniform Material material;
 
 // lights
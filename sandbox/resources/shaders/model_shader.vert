@@ -3,7 +3,7 @@
 layout (location = 0) in vec3 in_pos;
 layout (location = 1) in vec3 in_color;
 layout (location = 2) in vec3 in_normal;
-layout (location = 3) in vec3 in_tangent;
+layout (location = 3) in vec4 in_tangent;
 layout (location = 4) in vec3 in_bitangent;
 layout (location = 5) in vec2 in_texcoord;
 layout (location = 6) in float in_opacity;
@@ -16,25 +16,31 @@ out vec3 frag_bitangent;
 out vec2 frag_texcoord;
 out float frag_opacity;
 
-uniform bool camera_active = false;
+layout (std140 , binding = 0) uniform Camera {
+    mat4 view;
+    mat4 proj;
+    mat4 view_proj;
+    vec3 view_pos;
+    bool camera_active;
+};
 
 uniform mat4 model;
-uniform mat4 proj;
-uniform mat4 view;
 
 void main() {
     frag_pos = vec3(model * vec4(in_pos, 1.0));
     frag_normal = mat3(transpose(inverse(model))) * in_normal;
 
     if (camera_active) {
-        gl_Position = proj * view * vec4(frag_pos , 1.0);
+        gl_Position = view_proj * vec4(frag_pos , 1.0);
     } else {
         gl_Position = model * vec4(in_pos , 1.0);
     }
 
     frag_color = in_color;
-    frag_tangent = in_tangent;
-    frag_bitangent = in_bitangent;
+    frag_tangent = in_tangent.xyz;
+
+    // compact vertex formats leave the bitangent out (it reads as zero) and keep its sign in the tangent's w
+    frag_bitangent = dot(in_bitangent , in_bitangent) > 0.0 ? in_bitangent : cross(in_normal , in_tangent.xyz) * in_tangent.w;
     frag_texcoord = in_texcoord;
     frag_opacity = in_opacity;
 }
\ No newline at end of file
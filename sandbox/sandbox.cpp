@@ -28,7 +28,7 @@ class Sandbox : public YE::App {
             EngineY::RegisterKeyPressCallback(
                 [&](YE::KeyPressed* event) -> bool {
                     if (event->Key() == YE::Keyboard::Key::YE_ESCAPE && !editor_open)
-                        EngineY::DispatchEvent(ynew YE::ShutdownEvent);
+                        EngineY::DispatchEvent(YE::ShutdownEvent{});
                     if (event->Key() == YE::Keyboard::Key::YE_F1) {
                         if (editor_open) {
                             text_editor.Shutdown();